@@ -28,13 +28,16 @@
 #include "registered-prefix.hpp"
 #include "pending-interest.hpp"
 #include "container-with-on-empty-signal.hpp"
+#include "mpsc-queue.hpp"
 
 #include "../util/scheduler.hpp"
 #include "../util/config-file.hpp"
+#include "../util/in-memory-storage.hpp"
 #include "../util/signal.hpp"
 
 #include "../transport/transport.hpp"
 #include "../transport/unix-transport.hpp"
+#include "../transport/shm-transport.hpp"
 #include "../transport/tcp-transport.hpp"
 
 #include "../mgmt/nfd/controller.hpp"
@@ -48,7 +51,7 @@ namespace ndn {
 /**
  * @brief implementation detail of Face
  */
-class Face::Impl : noncopyable
+class Face::Impl : public enable_shared_from_this<Face::Impl>, noncopyable
 {
 public:
   typedef ContainerWithOnEmptySignal<shared_ptr<PendingInterest>> PendingInterestTable;
@@ -80,49 +83,228 @@ public: // consumer
                        const NackCallback& afterNacked,
                        const TimeoutCallback& afterTimeout)
   {
+    if (m_contentCache != nullptr) {
+      shared_ptr<const Data> data = this->findInContentCache(*interest);
+      if (data != nullptr) {
+        m_counters.nCacheHits.fetch_add(1, std::memory_order_relaxed);
+        if (afterSatisfied != nullptr) {
+          // the caller of expressInterest may not expect its callback to be invoked
+          // before expressInterest returns
+          weak_ptr<Impl> implWeak(this->shared_from_this());
+          m_face.getIoService().post([implWeak, interest, data, afterSatisfied] {
+            auto impl = implWeak.lock();
+            if (impl != nullptr) {
+              afterSatisfied(*interest, *data);
+            }
+          });
+        }
+        return;
+      }
+      m_counters.nCacheMisses.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    // the PendingInterest is inserted before connecting, so that the Interest times out
+    // normally if the transport cannot be connected
+    auto pendingInterest = make_shared<PendingInterest>(interest, afterSatisfied, afterNacked,
+                                                        afterTimeout, ref(m_scheduler));
+    bool isAggregated = m_isInterestAggregationEnabled && this->isCovered(*interest);
+
+    auto entry = m_pendingInterestTable.insert(pendingInterest).first;
+    (*entry)->setDeleter([this, entry] {
+      // invoked after the timeout callback
+      m_counters.nTimeouts.fetch_add(1, std::memory_order_relaxed);
+      shared_ptr<PendingInterest> expiredEntry = *entry;
+      m_pendingInterestTable.erase(entry);
+      this->updateNPendingInterests();
+
+      if (expiredEntry->isTransmitted()) {
+        this->transmitOldestWaiting(*expiredEntry->getInterest());
+      }
+    });
+    this->updateNPendingInterests();
+
+    if (isAggregated) {
+      m_counters.nAggregatedInterests.fetch_add(1, std::memory_order_relaxed);
+      return;
+    }
+
     this->ensureConnected(true);
+    pendingInterest->setTransmitted();
+    this->transmitInterest(*interest);
+  }
 
-    auto entry = m_pendingInterestTable.insert(make_shared<PendingInterest>(
-      interest, afterSatisfied, afterNacked, afterTimeout, ref(m_scheduler))).first;
-    (*entry)->setDeleter([this, entry] { m_pendingInterestTable.erase(entry); });
+  /**
+   * @brief send @p interest to the forwarder
+   *
+   * Interests are not delayed until the end of the io_service turn.  Instead, packets already
+   * queued by asyncSend are handed to the transport first, so that packets reach the transport
+   * in the order they were submitted.  This adds no latency to any packet, but a batch of
+   * Data or Nacks is cut short when an Interest is sent in the middle of it.
+   */
+  void
+  transmitInterest(const Interest& interest)
+  {
+    this->flushSends();
 
     lp::Packet packet;
 
-    shared_ptr<lp::NextHopFaceIdTag> nextHopFaceIdTag = interest->getTag<lp::NextHopFaceIdTag>();
+    shared_ptr<lp::NextHopFaceIdTag> nextHopFaceIdTag = interest.getTag<lp::NextHopFaceIdTag>();
     if (nextHopFaceIdTag != nullptr) {
       packet.add<lp::NextHopFaceIdField>(*nextHopFaceIdTag);
     }
 
-    shared_ptr<lp::CongestionMarkTag> congestionMarkTag = interest->getTag<lp::CongestionMarkTag>();
+    shared_ptr<lp::CongestionMarkTag> congestionMarkTag = interest.getTag<lp::CongestionMarkTag>();
     if (congestionMarkTag != nullptr) {
       packet.add<lp::CongestionMarkField>(*congestionMarkTag);
     }
 
-    packet.add<lp::FragmentField>(std::make_pair(interest->wireEncode().begin(),
-                                                 interest->wireEncode().end()));
+    packet.add<lp::FragmentField>(std::make_pair(interest.wireEncode().begin(),
+                                                 interest.wireEncode().end()));
 
     m_face.m_transport->send(packet.wireEncode());
+    m_counters.nOutInterests.fetch_add(1, std::memory_order_relaxed);
+  }
+
+  /**
+   * @brief whether Interests @p a and @p b would retrieve the same Data from the forwarder
+   */
+  static bool
+  canAggregate(const Interest& a, const Interest& b)
+  {
+    if (!a.matchesInterest(b)) {
+      return false;
+    }
+
+    shared_ptr<lp::NextHopFaceIdTag> nextHopA = a.getTag<lp::NextHopFaceIdTag>();
+    shared_ptr<lp::NextHopFaceIdTag> nextHopB = b.getTag<lp::NextHopFaceIdTag>();
+    if (nextHopA == nullptr || nextHopB == nullptr) {
+      return nextHopA == nextHopB;
+    }
+    return nextHopA->get() == nextHopB->get();
+  }
+
+  /**
+   * @brief whether a transmitted pending Interest retrieves the same Data as @p interest
+   *
+   * The expiry of the transmitted Interest does not matter: when it times out or is cancelled
+   * while Interests are still waiting on it, transmitOldestWaiting sends one of them.
+   */
+  bool
+  isCovered(const Interest& interest)
+  {
+    return std::any_of(m_pendingInterestTable.begin(), m_pendingInterestTable.end(),
+                       [&] (const shared_ptr<PendingInterest>& entry) {
+                         return entry->isTransmitted() &&
+                                canAggregate(*entry->getInterest(), interest);
+                       });
+  }
+
+  /**
+   * @brief find a Data in the content cache that can satisfy @p interest
+   *
+   * A Data without FreshnessPeriod is never returned for an Interest with MustBeFresh.
+   */
+  shared_ptr<const Data>
+  findInContentCache(const Interest& interest)
+  {
+    shared_ptr<const Data> data = m_contentCache->find(interest);
+    if (data != nullptr && interest.getMustBeFresh() &&
+        data->getFreshnessPeriod() <= time::milliseconds::zero()) {
+      return nullptr;
+    }
+    return data;
+  }
+
+  /**
+   * @brief insert @p data into the content cache
+   *
+   * The Data can satisfy Interests with MustBeFresh until its FreshnessPeriod elapses.
+   */
+  void
+  insertIntoContentCache(const Data& data)
+  {
+    if (data.getFreshnessPeriod() > time::milliseconds::zero()) {
+      m_contentCache->insert(data, data.getFreshnessPeriod());
+    }
+    else {
+      m_contentCache->insert(data);
+    }
   }
 
   void
   asyncRemovePendingInterest(const PendingInterestId* pendingInterestId)
   {
-    m_pendingInterestTable.remove_if(MatchPendingInterestId(pendingInterestId));
+    auto entry = std::find_if(m_pendingInterestTable.begin(), m_pendingInterestTable.end(),
+                              MatchPendingInterestId(pendingInterestId));
+    if (entry == m_pendingInterestTable.end()) {
+      return;
+    }
+
+    shared_ptr<PendingInterest> removedEntry = *entry;
+    m_pendingInterestTable.erase(entry);
+    this->updateNPendingInterests();
+
+    if (removedEntry->isTransmitted()) {
+      this->transmitOldestWaiting(*removedEntry->getInterest());
+    }
+  }
+
+  /**
+   * @brief after the transmitted @p interest has timed out or has been cancelled, transmit
+   *        the oldest unexpired Interest that was aggregated with it
+   *
+   * The other waiting Interests stay aggregated with the newly transmitted one.
+   */
+  void
+  transmitOldestWaiting(const Interest& interest)
+  {
+    if (this->isCovered(interest)) {
+      return;
+    }
+
+    time::steady_clock::TimePoint now = time::steady_clock::now();
+    shared_ptr<PendingInterest> oldest;
+    for (const shared_ptr<PendingInterest>& entry : m_pendingInterestTable) {
+      if (!entry->isTransmitted() && entry->getExpiry() > now &&
+          canAggregate(*entry->getInterest(), interest) &&
+          (oldest == nullptr || entry->getSendTime() < oldest->getSendTime())) {
+        oldest = entry;
+      }
+    }
+
+    if (oldest != nullptr) {
+      oldest->setTransmitted();
+      this->transmitInterest(*oldest->getInterest());
+    }
   }
 
   void
   asyncRemoveAllPendingInterests()
   {
     m_pendingInterestTable.clear();
+    this->updateNPendingInterests();
   }
 
   void
   satisfyPendingInterests(const Data& data)
   {
+    m_counters.nInData.fetch_add(1, std::memory_order_relaxed);
+
+    time::steady_clock::TimePoint now = time::steady_clock::now();
+    bool isSolicited = false;
     for (auto entry = m_pendingInterestTable.begin(); entry != m_pendingInterestTable.end(); ) {
       if ((*entry)->getInterest()->matchesData(data)) {
+        if (!isSolicited && m_contentCache != nullptr) {
+          this->insertIntoContentCache(data);
+        }
+        isSolicited = true;
+
         shared_ptr<PendingInterest> matchedEntry = *entry;
         entry = m_pendingInterestTable.erase(entry);
+        this->updateNPendingInterests();
+        if (matchedEntry->isTransmitted()) {
+          m_counters.rtt.record(now - matchedEntry->getSendTime());
+        }
         matchedEntry->invokeDataCallback(data);
       }
       else {
@@ -134,11 +316,14 @@ public: // consumer
   void
   nackPendingInterests(const lp::Nack& nack)
   {
+    m_counters.nInNacks.fetch_add(1, std::memory_order_relaxed);
+
     for (auto entry = m_pendingInterestTable.begin(); entry != m_pendingInterestTable.end(); ) {
       const Interest& pendingInterest = *(*entry)->getInterest();
       if (nack.getInterest().matchesInterest(pendingInterest)) {
         shared_ptr<PendingInterest> matchedEntry = *entry;
         entry = m_pendingInterestTable.erase(entry);
+        this->updateNPendingInterests();
         matchedEntry->invokeNackCallback(nack);
       }
       else {
@@ -168,6 +353,8 @@ public: // producer
   void
   processInterestFilters(Interest& interest)
   {
+    m_counters.nInInterests.fetch_add(1, std::memory_order_relaxed);
+
     for (const auto& filter : m_interestFilterTable) {
       if (filter->doesMatch(interest.getName())) {
         filter->invokeInterestCallback(interest);
@@ -175,11 +362,167 @@ public: // producer
     }
   }
 
+  /**
+   * @brief queue @p wire to be sent
+   *
+   * Packets queued during the same io_service turn are handed to the transport together.
+   */
   void
   asyncSend(const Block& wire)
   {
     this->ensureConnected(true);
-    m_face.m_transport->send(wire);
+    if (m_pendingSends.empty()) {
+      this->postFlushSends();
+    }
+    m_pendingSends.push_back(wire);
+  }
+
+  void
+  asyncSend(const std::vector<Block>& wires)
+  {
+    this->ensureConnected(true);
+    if (m_pendingSends.empty()) {
+      this->postFlushSends();
+    }
+    m_pendingSends.insert(m_pendingSends.end(), wires.begin(), wires.end());
+  }
+
+  void
+  postFlushSends()
+  {
+    weak_ptr<Impl> implWeak(this->shared_from_this());
+    m_face.getIoService().post([implWeak] {
+      auto impl = implWeak.lock();
+      if (impl != nullptr) {
+        impl->flushSends();
+      }
+    });
+  }
+
+  /**
+   * @brief hand the packets queued by asyncSend to the transport
+   *
+   * The transport is connected again if it has been closed since the packets were queued,
+   * as asyncSend would have done had the packets been sent immediately.
+   */
+  void
+  flushSends()
+  {
+    std::vector<Block> wires;
+    wires.swap(m_pendingSends);
+    if (!wires.empty()) {
+      this->ensureConnected(false);
+      m_face.m_transport->sendBatch(wires);
+    }
+  }
+
+public: // multi-producer
+  /**
+   * @brief a put, expressInterest, or pending Interest removal enqueued by a producer thread
+   */
+  struct Command
+  {
+    enum Type {
+      SEND,
+      EXPRESS_INTEREST,
+      REMOVE_PENDING_INTEREST,
+      REMOVE_ALL_PENDING_INTERESTS
+    };
+
+    Type type = SEND;
+    Block wire; ///< packet to send
+    shared_ptr<const Interest> interest; ///< Interest to express
+    DataCallback afterSatisfied;
+    NackCallback afterNacked;
+    TimeoutCallback afterTimeout;
+    const PendingInterestId* pendingInterestId = nullptr; ///< pending Interest to remove
+  };
+
+  /**
+   * @brief maximum number of commands executed by one drainCommands invocation
+   *
+   * This bounds the time during which other handlers on the io_service are held off.
+   */
+  static const size_t MAX_COMMAND_BATCH = 256;
+
+  /**
+   * @brief enqueue @p command for execution on the io_service thread
+   * @note This function is thread-safe.
+   */
+  void
+  enqueueCommand(Command command)
+  {
+    m_commandQueue->push(std::move(command));
+
+    // only the producer that makes the queue non-empty schedules a drain
+    if (m_nQueuedCommands.fetch_add(1, std::memory_order_acq_rel) == 0) {
+      this->postDrainCommands();
+    }
+  }
+
+  void
+  postDrainCommands()
+  {
+    weak_ptr<Impl> implWeak(this->shared_from_this());
+    m_face.getIoService().post([implWeak] {
+      auto impl = implWeak.lock();
+      if (impl != nullptr) {
+        impl->drainCommands();
+      }
+    });
+  }
+
+  void
+  drainCommands()
+  {
+    size_t nExecuted = 0;
+    try {
+      this->executeCommands(nExecuted);
+    }
+    catch (...) {
+      // the failed command counts as executed; remaining commands need another drain
+      this->finishDrain(nExecuted);
+      throw;
+    }
+    this->finishDrain(nExecuted);
+  }
+
+  /**
+   * @brief execute up to MAX_COMMAND_BATCH commands
+   * @param[out] nExecuted number of commands popped from the queue, including one that throws
+   */
+  void
+  executeCommands(size_t& nExecuted)
+  {
+    Command command;
+    while (nExecuted < MAX_COMMAND_BATCH && m_commandQueue->pop(command)) {
+      ++nExecuted;
+      switch (command.type) {
+      case Command::SEND:
+        this->asyncSend(command.wire);
+        break;
+      case Command::EXPRESS_INTEREST:
+        this->asyncExpressInterest(std::move(command.interest), command.afterSatisfied,
+                                   command.afterNacked, command.afterTimeout);
+        break;
+      case Command::REMOVE_PENDING_INTEREST:
+        this->asyncRemovePendingInterest(command.pendingInterestId);
+        break;
+      case Command::REMOVE_ALL_PENDING_INTERESTS:
+        this->asyncRemoveAllPendingInterests();
+        break;
+      }
+      command = Command();
+    }
+  }
+
+  void
+  finishDrain(size_t nExecuted)
+  {
+    // commands enqueued after the last pop, or beyond the batch limit, need another drain
+    if (m_nQueuedCommands.fetch_sub(nExecuted, std::memory_order_acq_rel) != nExecuted) {
+      this->postDrainCommands();
+    }
   }
 
 public: // prefix registration
@@ -280,6 +623,15 @@ public: // IO routine
     }
   }
 
+  /**
+   * @brief publish the size of the pending Interest table to FaceCounters
+   */
+  void
+  updateNPendingInterests()
+  {
+    m_counters.nPendingInterests.store(m_pendingInterestTable.size(), std::memory_order_relaxed);
+  }
+
   void
   onEmptyPitOrNoRegisteredPrefixes()
   {
@@ -302,6 +654,22 @@ private:
 
   unique_ptr<boost::asio::io_service::work> m_ioServiceWork; // if thread needs to be preserved
 
+  /// commands from producer threads; null unless multi-producer mode is enabled
+  unique_ptr<MpscQueue<Command>> m_commandQueue;
+  /// number of commands pushed into m_commandQueue and not yet executed
+  std::atomic<size_t> m_nQueuedCommands{0};
+
+  FaceCounters m_counters;
+
+  /// whether Interests covered by a transmitted pending Interest are not sent again
+  bool m_isInterestAggregationEnabled = false;
+
+  /// packets queued by asyncSend in the current io_service turn
+  std::vector<Block> m_pendingSends;
+
+  /// Data retrieved by this face, consulted before sending an Interest
+  shared_ptr<util::InMemoryStorage> m_contentCache;
+
   friend class Face;
 };
 
@@ -0,0 +1,144 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2013-2017 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#ifndef NDN_DETAIL_MPSC_QUEUE_HPP
+#define NDN_DETAIL_MPSC_QUEUE_HPP
+
+#include "../common.hpp"
+
+#include <atomic>
+
+namespace ndn {
+
+/**
+ * @brief unbounded lock-free multi-producer single-consumer queue
+ *
+ * This is an intrusive linked list with a stub node (D. Vyukov's MPSC queue): push is
+ * wait-free and can be invoked from any thread; pop must only be invoked from one consumer
+ * thread at a time.
+ *
+ * While a producer is in the middle of push, pop may return false even though other items
+ * pushed later are already in the queue; the consumer will find them after that push
+ * completes.  Callers that need to know whether more items are pending should keep a
+ * separate counter of pushed items.
+ */
+template<typename T>
+class MpscQueue : noncopyable
+{
+public:
+  MpscQueue()
+    : m_head(&m_stub)
+    , m_tail(&m_stub)
+  {
+    m_stub.next.store(nullptr, std::memory_order_relaxed);
+  }
+
+  ~MpscQueue()
+  {
+    T item;
+    while (pop(item)) {
+    }
+  }
+
+  /**
+   * @brief append @p item to the queue
+   * @note This function is thread-safe.
+   */
+  void
+  push(T item)
+  {
+    Node* node = new Node;
+    node->item = std::move(item);
+    node->next.store(nullptr, std::memory_order_relaxed);
+    pushNode(node);
+  }
+
+  /**
+   * @brief remove the first item from the queue
+   * @param[out] item the removed item
+   * @retval true an item has been removed
+   * @retval false the queue is empty, or the first item is being pushed
+   * @note This function must not be invoked concurrently with itself.
+   */
+  bool
+  pop(T& item)
+  {
+    Node* tail = m_tail;
+    Node* next = tail->next.load(std::memory_order_acquire);
+
+    if (tail == &m_stub) {
+      if (next == nullptr)
+        return false;
+      // skip the stub node
+      m_tail = next;
+      tail = next;
+      next = next->next.load(std::memory_order_acquire);
+    }
+
+    if (next != nullptr) {
+      m_tail = next;
+      item = std::move(tail->item);
+      delete tail;
+      return true;
+    }
+
+    if (tail != m_head.load(std::memory_order_acquire)) {
+      // a producer has swapped m_head but has not linked its node yet
+      return false;
+    }
+
+    // tail is the only item: put the stub behind it so that tail can be removed
+    m_stub.next.store(nullptr, std::memory_order_relaxed);
+    pushNode(&m_stub);
+
+    next = tail->next.load(std::memory_order_acquire);
+    if (next != nullptr) {
+      m_tail = next;
+      item = std::move(tail->item);
+      delete tail;
+      return true;
+    }
+    return false;
+  }
+
+private:
+  struct Node
+  {
+    T item;
+    std::atomic<Node*> next;
+  };
+
+  void
+  pushNode(Node* node)
+  {
+    Node* prev = m_head.exchange(node, std::memory_order_acq_rel);
+    prev->next.store(node, std::memory_order_release);
+  }
+
+private:
+  std::atomic<Node*> m_head; ///< last pushed node, modified by producers
+  Node* m_tail; ///< first node, only accessed by the consumer
+  Node m_stub;
+};
+
+} // namespace ndn
+
+#endif // NDN_DETAIL_MPSC_QUEUE_HPP
@@ -57,12 +57,14 @@ public:
     , m_nackCallback(nackCallback)
     , m_timeoutCallback(timeoutCallback)
     , m_timeoutEvent(scheduler)
+    , m_sendTime(time::steady_clock::now())
+    , m_isTransmitted(false)
   {
-    m_timeoutEvent =
-      scheduler.scheduleEvent(m_interest->getInterestLifetime() > time::milliseconds::zero() ?
-                              m_interest->getInterestLifetime() :
-                              DEFAULT_INTEREST_LIFETIME,
-                              [=] { this->invokeTimeoutCallback(); });
+    time::milliseconds lifetime = m_interest->getInterestLifetime() > time::milliseconds::zero() ?
+                                  m_interest->getInterestLifetime() :
+                                  DEFAULT_INTEREST_LIFETIME;
+    m_expiry = m_sendTime + lifetime;
+    m_timeoutEvent = scheduler.scheduleEvent(lifetime, [=] { this->invokeTimeoutCallback(); });
   }
 
   /**
@@ -74,6 +76,40 @@ public:
     return m_interest;
   }
 
+  /**
+   * @return the time when this record was created, i.e., when the Interest was sent
+   */
+  time::steady_clock::TimePoint
+  getSendTime() const
+  {
+    return m_sendTime;
+  }
+
+  /**
+   * @return the time when the timeout callback will be invoked
+   */
+  time::steady_clock::TimePoint
+  getExpiry() const
+  {
+    return m_expiry;
+  }
+
+  /**
+   * @return whether the Interest has been sent to the forwarder,
+   *         as opposed to being aggregated with another pending Interest
+   */
+  bool
+  isTransmitted() const
+  {
+    return m_isTransmitted;
+  }
+
+  void
+  setTransmitted()
+  {
+    m_isTransmitted = true;
+  }
+
   /**
    * @brief invokes the Data callback
    * @note This method does nothing if the Data callback is empty
@@ -128,6 +164,9 @@ private:
   NackCallback m_nackCallback;
   TimeoutCallback m_timeoutCallback;
   util::scheduler::ScopedEventId m_timeoutEvent;
+  time::steady_clock::TimePoint m_sendTime;
+  time::steady_clock::TimePoint m_expiry;
+  bool m_isTransmitted;
   std::function<void()> m_deleter;
 };
 
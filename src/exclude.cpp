@@ -26,8 +26,24 @@
 
 #include <boost/range/adaptor/reversed.hpp>
 
+#include <cstring>
+
 namespace ndn {
 
+/** \brief compare TLV encodings of name components
+ *
+ *  Lexical order of TLV encoding is the same as canonical order of name components.
+ */
+static int
+compareWire(const uint8_t* a, size_t aSize, const uint8_t* b, size_t bSize)
+{
+  int cmp = std::memcmp(a, b, std::min(aSize, bSize));
+  if (cmp != 0) {
+    return cmp;
+  }
+  return aSize < bSize ? -1 : (aSize > bSize ? 1 : 0);
+}
+
 Exclude::ExcludeComponent::ExcludeComponent(const name::Component& component1)
   : isNegInf(false)
   , component(component1)
@@ -204,30 +220,115 @@ Exclude::appendEntry(const T& component, bool hasAny)
                          std::forward_as_tuple(hasAny));
 }
 
+bool
+Exclude::isExcluded(const name::Component& comp) const
+{
+  if (m_entries.empty()) {
+    return false;
+  }
+
+  const Block& wire = comp.wireEncode();
+  return isExcludedAt(findUpperBound(wire, 0), wire);
+}
+
+std::vector<bool>
+Exclude::isExcluded(const std::vector<name::Component>& components) const
+{
+  std::vector<bool> result(components.size(), false);
+  if (m_entries.empty()) {
+    return result;
+  }
+
+  size_t first = 0;
+  const Block* previous = nullptr;
+  for (size_t i = 0; i < components.size(); ++i) {
+    const Block& wire = components[i].wireEncode();
+    if (previous != nullptr &&
+        compareWire(previous->wire(), previous->size(), wire.wire(), wire.size()) > 0) {
+      // not in ascending order, search from the beginning
+      first = 0;
+    }
+
+    first = findUpperBound(wire, first);
+    result[i] = isExcludedAt(first, wire);
+    previous = &wire;
+  }
+  return result;
+}
+
+const std::vector<Exclude::FlatEntry>&
+Exclude::getFlatEntries() const
+{
+  if (m_flatEntries.empty()) {
+    m_flatEntries.reserve(m_entries.size());
+    for (const Entry& entry : m_entries | boost::adaptors::reversed) {
+      if (entry.first.isNegInf) {
+        m_flatEntries.push_back({nullptr, 0, entry.second});
+      }
+      else {
+        const Block& wire = entry.first.component.wireEncode();
+        m_flatEntries.push_back({wire.wire(), wire.size(), entry.second});
+      }
+    }
+  }
+  return m_flatEntries;
+}
+
+size_t
+Exclude::findUpperBound(const Block& wire, size_t first) const
+{
+  const std::vector<FlatEntry>& entries = getFlatEntries();
+  auto isNotGreater = [&wire] (const FlatEntry& entry) {
+    return entry.wire == nullptr ||
+           compareWire(entry.wire, entry.size, wire.wire(), wire.size()) <= 0;
+  };
+
+  // exponential search from first, so that nearby lookups in a batch are cheap,
+  // followed by binary search within the last step
+  size_t low = first;
+  size_t high = first;
+  for (size_t step = 1; high < entries.size() && isNotGreater(entries[high]); step *= 2) {
+    low = high + 1;
+    high = low + step;
+  }
+  high = std::min(high, entries.size());
+
+  return std::partition_point(entries.begin() + low, entries.begin() + high, isNotGreater) -
+         entries.begin();
+}
+
 // example: ANY "b" "d" ANY "f"
-// ordered in map as: "f" (false); "d" (true); "b" (false); -Inf (true)
+// flat entries: -Inf (true); "b" (false); "d" (true); "f" (false)
 //
-// lower_bound("")  -> -Inf (true) <-- excluded (ANY)
-// lower_bound("a") -> -Inf (true) <-- excluded (ANY)
-// lower_bound("b") -> "b" (false) <--- excluded (equal)
-// lower_bound("c") -> "b" (false) <--- not excluded (not equal and no ANY)
-// lower_bound("d") -> "d" (true) <- excluded
-// lower_bound("e") -> "d" (true) <- excluded
+// upper bound of "a" -> 1, preceded by -Inf (true) <-- excluded (ANY)
+// upper bound of "b" -> 2, preceded by "b" (false) <-- excluded (equal)
+// upper bound of "c" -> 2, preceded by "b" (false) <-- not excluded (not equal and no ANY)
+// upper bound of "e" -> 3, preceded by "d" (true) <-- excluded (ANY)
 bool
-Exclude::isExcluded(const name::Component& comp) const
+Exclude::isExcludedAt(size_t upperBound, const Block& wire) const
 {
-  ExcludeMap::const_iterator lb = m_entries.lower_bound(comp);
-  return lb != m_entries.end() && // if false, comp is less than the first excluded component
-         (lb->second || // comp matches an ANY range
-          (!lb->first.isNegInf && lb->first.component == comp)); // comp equals an exact excluded component
+  if (upperBound == 0) {
+    // wire is less than the first excluded component
+    return false;
+  }
+
+  const FlatEntry& entry = m_flatEntries[upperBound - 1];
+  return entry.hasAny || // wire is in an ANY range
+         (entry.wire != nullptr && entry.size == wire.size() &&
+          std::memcmp(entry.wire, wire.wire(), wire.size()) == 0); // wire equals an excluded component
 }
 
 Exclude&
 Exclude::excludeOne(const name::Component& comp)
 {
-  if (!isExcluded(comp)) {
+  // look up in the map, because the flat entries would be rebuilt after every insertion
+  ExcludeMap::const_iterator lb = m_entries.lower_bound(comp);
+  bool isAlreadyExcluded = lb != m_entries.end() &&
+                           (lb->second || (!lb->first.isNegInf && lb->first.component == comp));
+  if (!isAlreadyExcluded) {
     this->appendEntry(comp, false);
     m_wire.reset();
+    m_flatEntries.clear();
   }
   return *this;
 }
@@ -289,6 +390,7 @@ Exclude::excludeRange(const ExcludeComponent& from, const name::Component& to)
   m_entries.erase(newTo, newFrom);
 
   m_wire.reset();
+  m_flatEntries.clear();
   return *this;
 }
 
@@ -311,6 +413,7 @@ Exclude::excludeAfter(const name::Component& from)
   m_entries.erase(m_entries.begin(), newFrom);
 
   m_wire.reset();
+  m_flatEntries.clear();
   return *this;
 }
 
@@ -354,6 +457,7 @@ Exclude::clear()
 {
   m_entries.clear();
   m_wire.reset();
+  m_flatEntries.clear();
 }
 
 Exclude::const_iterator::const_iterator(ExcludeMap::const_reverse_iterator it,
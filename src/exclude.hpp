@@ -29,6 +29,7 @@
 
 #include <sstream>
 #include <map>
+#include <vector>
 
 namespace ndn {
 
@@ -92,6 +93,17 @@ public: // high-level API
   bool
   isExcluded(const name::Component& comp) const;
 
+  /**
+   * @brief Check whether each of @p components is excluded
+   * @return a vector whose i-th element is true if components[i] is excluded
+   *
+   * When @p components are in ascending order, the lookup of each component resumes from
+   * the position of the previous one, so that the whole batch is checked in a single pass
+   * over the exclude filter.
+   */
+  std::vector<bool>
+  isExcluded(const std::vector<name::Component>& components) const;
+
   /**
    * @brief Exclude specific name component
    * @param comp component to exclude
@@ -281,10 +293,46 @@ private:
   Exclude&
   excludeRange(const ExcludeComponent& from, const name::Component& to);
 
+  /**
+   * @brief an entry of the flat representation of the exclude filter
+   */
+  struct FlatEntry
+  {
+    const uint8_t* wire; ///< TLV encoding of the component, or nullptr for "negative infinity"
+    size_t size;         ///< size of the TLV encoding
+    bool hasAny;         ///< whether the range up to the next entry is excluded
+  };
+
+  /**
+   * @brief get the entries in ascending order, building them from m_entries if necessary
+   *
+   * Components are compared by their TLV encoding, which lies in the wire of the exclude
+   * filter if it has been decoded, so that a lookup is a binary search over octet arrays.
+   */
+  const std::vector<FlatEntry>&
+  getFlatEntries() const;
+
+  /**
+   * @return index of the first flat entry greater than @p wire
+   * @pre flat entries before @p first are not greater than @p wire
+   */
+  size_t
+  findUpperBound(const Block& wire, size_t first) const;
+
+  /**
+   * @return whether the component encoded as @p wire is excluded
+   * @param upperBound index of the first flat entry greater than @p wire
+   */
+  bool
+  isExcludedAt(size_t upperBound, const Block& wire) const;
+
 private:
   ExcludeMap m_entries;
   mutable Block m_wire;
 
+  /// flat representation of m_entries; empty if not built yet
+  mutable std::vector<FlatEntry> m_flatEntries;
+
   friend std::ostream&
   operator<<(std::ostream& os, const Exclude& name);
 };
@@ -0,0 +1,266 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2013-2017 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#include "face-group.hpp"
+#include "util/logger.hpp"
+
+#include <algorithm>
+#include <future>
+
+namespace ndn {
+
+NDN_LOG_INIT(ndn.FaceGroup);
+
+FaceGroup::FaceGroup(size_t nShards, const TransportFactory& makeTransport)
+  : m_routes(make_shared<RouteTable>())
+{
+  if (nShards == 0) {
+    BOOST_THROW_EXCEPTION(Error("FaceGroup must have at least one shard"));
+  }
+  m_shards.resize(nShards);
+  start(makeTransport, nullptr);
+}
+
+FaceGroup::FaceGroup(size_t nShards, const TransportFactory& makeTransport, KeyChain& keyChain)
+  : m_routes(make_shared<RouteTable>())
+{
+  if (nShards == 0) {
+    BOOST_THROW_EXCEPTION(Error("FaceGroup must have at least one shard"));
+  }
+  m_shards.resize(nShards);
+  start(makeTransport, &keyChain);
+}
+
+void
+FaceGroup::start(const TransportFactory& makeTransport, KeyChain* keyChain)
+{
+  for (unique_ptr<Shard>& shard : m_shards) {
+    shard.reset(new Shard);
+    shared_ptr<Transport> transport = makeTransport == nullptr ? nullptr : makeTransport();
+    if (keyChain == nullptr) {
+      shard->face.reset(new Face(transport, shard->ioService));
+    }
+    else {
+      shard->face.reset(new Face(transport, shard->ioService, *keyChain));
+    }
+    shard->face->enableMultiProducer();
+    shard->work.reset(new boost::asio::io_service::work(shard->ioService));
+  }
+
+  for (unique_ptr<Shard>& shard : m_shards) {
+    Shard* s = shard.get();
+    s->thread = std::thread([s] {
+      // an exception thrown by a handler (e.g., a transport error) must not end the thread,
+      // because other threads still expect this shard to process their packets
+      for (;;) {
+        try {
+          s->ioService.run();
+          return;
+        }
+        catch (const std::exception& e) {
+          NDN_LOG_ERROR("exception in FaceGroup shard: " << e.what());
+        }
+      }
+    });
+  }
+}
+
+FaceGroup::~FaceGroup()
+{
+  for (unique_ptr<Shard>& shard : m_shards) {
+    Shard* s = shard.get();
+    s->ioService.post([s] {
+      s->face->shutdown();
+      // runs after the shutdown handler posted by Face::shutdown
+      s->ioService.post([s] { s->ioService.stop(); });
+    });
+    s->work.reset();
+  }
+
+  for (unique_ptr<Shard>& shard : m_shards) {
+    shard->thread.join();
+  }
+}
+
+size_t
+FaceGroup::getShardIndex(const Name& name) const
+{
+  return std::hash<Name>()(name) % m_shards.size();
+}
+
+bool
+FaceGroup::isShardThread() const
+{
+  std::thread::id self = std::this_thread::get_id();
+  return std::any_of(m_shards.begin(), m_shards.end(),
+                     [self] (const unique_ptr<Shard>& shard) {
+                       return shard->thread.get_id() == self;
+                     });
+}
+
+void
+FaceGroup::runOnShard(size_t shard, const std::function<void()>& f)
+{
+  std::promise<void> promise;
+  m_shards.at(shard)->ioService.dispatch([&f, &promise] {
+    try {
+      f();
+      promise.set_value();
+    }
+    catch (...) {
+      promise.set_exception(std::current_exception());
+    }
+  });
+  promise.get_future().get();
+}
+
+const PendingInterestId*
+FaceGroup::expressInterest(const Interest& interest,
+                           const DataCallback& afterSatisfied,
+                           const NackCallback& afterNacked,
+                           const TimeoutCallback& afterTimeout)
+{
+  Face& face = *m_shards[getShardIndex(interest.getName())]->face;
+  return face.expressInterest(interest, afterSatisfied, afterNacked, afterTimeout);
+}
+
+void
+FaceGroup::removePendingInterest(const PendingInterestId* pendingInterestId)
+{
+  for (unique_ptr<Shard>& shard : m_shards) {
+    shard->face->removePendingInterest(pendingInterestId);
+  }
+}
+
+const RegisteredPrefixId*
+FaceGroup::setInterestFilter(const InterestFilter& interestFilter,
+                             const InterestCallback& onInterest,
+                             const RegisterPrefixSuccessCallback& onSuccess,
+                             const RegisterPrefixFailureCallback& onFailure,
+                             const security::SigningInfo& signingInfo,
+                             uint64_t flags)
+{
+  if (isShardThread()) {
+    BOOST_THROW_EXCEPTION(Error("setInterestFilter must not be invoked from a FaceGroup callback"));
+  }
+
+  size_t shardIndex = getShardIndex(interestFilter.getPrefix());
+  Face* face = m_shards[shardIndex]->face.get();
+
+  const RegisteredPrefixId* id = nullptr;
+  runOnShard(shardIndex, [&] {
+    id = face->setInterestFilter(interestFilter, onInterest, onSuccess, onFailure,
+                                 signingInfo, flags);
+  });
+
+  std::lock_guard<std::mutex> lock(m_filtersMutex);
+  m_filters.push_back({interestFilter.getPrefix(), shardIndex, id});
+  this->updateRoutes();
+  return id;
+}
+
+void
+FaceGroup::unsetInterestFilter(const RegisteredPrefixId* registeredPrefixId)
+{
+  size_t shardIndex = 0;
+  {
+    std::lock_guard<std::mutex> lock(m_filtersMutex);
+    auto it = std::find_if(m_filters.begin(), m_filters.end(),
+                           [registeredPrefixId] (const FilterRecord& record) {
+                             return record.id == registeredPrefixId;
+                           });
+    if (it == m_filters.end()) {
+      return;
+    }
+    shardIndex = it->shard;
+    m_filters.erase(it);
+    this->updateRoutes();
+  }
+
+  Face* face = m_shards[shardIndex]->face.get();
+  m_shards[shardIndex]->ioService.dispatch([face, registeredPrefixId] {
+    face->unsetInterestFilter(registeredPrefixId);
+  });
+}
+
+void
+FaceGroup::updateRoutes()
+{
+  auto routes = make_shared<RouteTable>();
+  for (const FilterRecord& record : m_filters) {
+    routes->prefixes.insert(record.prefix);
+    routes->prefixLengths.push_back(record.prefix.size());
+  }
+  std::vector<size_t>& lengths = routes->prefixLengths;
+  std::sort(lengths.begin(), lengths.end(), std::greater<size_t>());
+  lengths.erase(std::unique(lengths.begin(), lengths.end()), lengths.end());
+
+  std::atomic_store(&m_routes, shared_ptr<const RouteTable>(std::move(routes)));
+}
+
+void
+FaceGroup::put(const Data& data)
+{
+  const Name& name = data.getName();
+  size_t shardIndex = m_shards.size();
+
+  // one hash lookup per distinct prefix length, longest first
+  shared_ptr<const RouteTable> routes = std::atomic_load(&m_routes);
+  for (size_t length : routes->prefixLengths) {
+    if (length > name.size()) {
+      continue;
+    }
+    Name prefix = name.getPrefix(length);
+    if (routes->prefixes.count(prefix) > 0) {
+      // InterestFilters are registered on the shard selected by their prefix
+      shardIndex = getShardIndex(prefix);
+      break;
+    }
+  }
+  if (shardIndex == m_shards.size()) {
+    shardIndex = getShardIndex(name);
+  }
+
+  m_shards[shardIndex]->face->put(data);
+}
+
+FaceGroup::Statistics
+FaceGroup::getStatistics() const
+{
+  Statistics statistics{};
+  for (const unique_ptr<Shard>& shard : m_shards) {
+    const FaceCounters& counters = shard->face->getCounters();
+    statistics.nOutInterests += counters.nOutInterests;
+    statistics.nInData += counters.nInData;
+    statistics.nInNacks += counters.nInNacks;
+    statistics.nTimeouts += counters.nTimeouts;
+    statistics.nInInterests += counters.nInInterests;
+    statistics.nOutData += counters.nOutData;
+    statistics.nOutNacks += counters.nOutNacks;
+    statistics.nAggregatedInterests += counters.nAggregatedInterests;
+    statistics.nCacheHits += counters.nCacheHits;
+    statistics.nCacheMisses += counters.nCacheMisses;
+    statistics.nPendingInterests += counters.nPendingInterests;
+  }
+  return statistics;
+}
+
+} // namespace ndn
@@ -0,0 +1,267 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2013-2017 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#ifndef NDN_FACE_GROUP_HPP
+#define NDN_FACE_GROUP_HPP
+
+#include "face.hpp"
+
+#include <mutex>
+#include <thread>
+#include <unordered_set>
+
+namespace ndn {
+
+/**
+ * @brief A group of Faces, each with its own forwarder connection and io_service thread
+ *
+ * A single Face performs encoding, PIT lookup and decoding on one io_service thread.
+ * FaceGroup spreads this work over several shards: each shard owns a Transport connected
+ * to the forwarder, an io_service run by a dedicated thread, and a Face in multi-producer
+ * mode.
+ *
+ * Outgoing Interests are assigned to a shard by the hash of their name, so that Interests
+ * with the same name always use the same connection.  An InterestFilter is registered on
+ * the shard selected by the hash of its prefix; Data passed to put() is sent through the
+ * shard of the longest registered prefix that matches the Data name.
+ *
+ * All callbacks are invoked on the io_service thread of the shard that handles the packet,
+ * so callbacks of different shards may run concurrently.
+ *
+ * An exception thrown on a shard thread, e.g., because the transport cannot be connected,
+ * is logged and the shard keeps running.  An Interest that could not be transmitted for
+ * this reason remains pending, and its timeout callback is invoked after its lifetime.
+ */
+class FaceGroup : noncopyable
+{
+public:
+  class Error : public std::runtime_error
+  {
+  public:
+    explicit
+    Error(const std::string& what)
+      : std::runtime_error(what)
+    {
+    }
+  };
+
+  /**
+   * @brief function that creates the transport of a shard
+   *
+   * It may return nullptr to use the default transport of Face.
+   */
+  typedef std::function<shared_ptr<Transport>()> TransportFactory;
+
+  /**
+   * @brief FaceCounters summed over all shards
+   * @sa FaceCounters
+   */
+  struct Statistics
+  {
+    uint64_t nOutInterests;
+    uint64_t nInData;
+    uint64_t nInNacks;
+    uint64_t nTimeouts;
+    uint64_t nInInterests;
+    uint64_t nOutData;
+    uint64_t nOutNacks;
+    uint64_t nAggregatedInterests;
+    uint64_t nCacheHits;
+    uint64_t nCacheMisses;
+    uint64_t nPendingInterests;
+  };
+
+  /**
+   * @brief Create @p nShards Faces and start their io_service threads
+   * @param nShards number of shards, must be positive
+   * @param makeTransport creates the transport of each shard; if empty, each Face uses
+   *                      the default transport, i.e., a separate connection to the
+   *                      forwarder named in the client configuration
+   * @throw Error @p nShards is zero
+   */
+  explicit
+  FaceGroup(size_t nShards, const TransportFactory& makeTransport = nullptr);
+
+  /**
+   * @brief Create @p nShards Faces that use @p keyChain to sign prefix registration commands
+   */
+  FaceGroup(size_t nShards, const TransportFactory& makeTransport, KeyChain& keyChain);
+
+  /**
+   * @brief Shut down every Face and join the io_service threads
+   *
+   * Must not be invoked from a callback.
+   */
+  ~FaceGroup();
+
+  size_t
+  size() const
+  {
+    return m_shards.size();
+  }
+
+  /**
+   * @brief get the Face of a shard
+   */
+  Face&
+  getFace(size_t shard)
+  {
+    return *m_shards.at(shard)->face;
+  }
+
+  /**
+   * @brief get the index of the shard that handles Interests named @p name
+   */
+  size_t
+  getShardIndex(const Name& name) const;
+
+public: // consumer
+  /**
+   * @brief Express an Interest on the shard selected by its name
+   * @note This function is thread-safe.
+   * @sa Face::expressInterest
+   */
+  const PendingInterestId*
+  expressInterest(const Interest& interest,
+                  const DataCallback& afterSatisfied,
+                  const NackCallback& afterNacked,
+                  const TimeoutCallback& afterTimeout);
+
+  /**
+   * @brief Cancel an Interest expressed with expressInterest
+   *
+   * Since @p pendingInterestId does not identify the shard, the removal is submitted to
+   * every shard; shards that do not have the Interest ignore it.
+   *
+   * @note This function is thread-safe.
+   * @sa Face::removePendingInterest
+   */
+  void
+  removePendingInterest(const PendingInterestId* pendingInterestId);
+
+public: // producer
+  /**
+   * @brief Register a prefix and set an InterestFilter on the shard selected by the prefix
+   *
+   * This blocks until the request has been submitted on the io_service thread of the shard.
+   * Therefore, it must not be invoked from a callback: a shard waiting on another shard that
+   * is in turn waiting on it would never resume.
+   *
+   * @note This function is thread-safe.
+   * @throw Error invoked on the io_service thread of a shard
+   * @sa Face::setInterestFilter
+   */
+  const RegisteredPrefixId*
+  setInterestFilter(const InterestFilter& interestFilter,
+                    const InterestCallback& onInterest,
+                    const RegisterPrefixSuccessCallback& onSuccess,
+                    const RegisterPrefixFailureCallback& onFailure,
+                    const security::SigningInfo& signingInfo = security::SigningInfo(),
+                    uint64_t flags = nfd::ROUTE_FLAG_CHILD_INHERIT);
+
+  /**
+   * @brief Remove an InterestFilter set with setInterestFilter, and unregister its prefix
+   * @note This function is thread-safe.
+   */
+  void
+  unsetInterestFilter(const RegisteredPrefixId* registeredPrefixId);
+
+  /**
+   * @brief Publish Data on the shard of the longest matching InterestFilter prefix
+   *
+   * If no InterestFilter matches, the shard is selected by the Data name.
+   *
+   * @note This function is thread-safe.
+   */
+  void
+  put(const Data& data);
+
+public: // statistics
+  /**
+   * @brief get counters summed over all shards
+   */
+  Statistics
+  getStatistics() const;
+
+private:
+  void
+  start(const TransportFactory& makeTransport, KeyChain* keyChain);
+
+  /**
+   * @return whether the calling thread is the io_service thread of a shard
+   */
+  bool
+  isShardThread() const;
+
+  /**
+   * @brief invoke @p f on the io_service thread of @p shard and wait for its completion
+   */
+  void
+  runOnShard(size_t shard, const std::function<void()>& f);
+
+  /**
+   * @brief rebuild m_routes from m_filters
+   * @pre m_filtersMutex is locked
+   */
+  void
+  updateRoutes();
+
+private:
+  struct Shard
+  {
+    boost::asio::io_service ioService;
+    unique_ptr<boost::asio::io_service::work> work;
+    unique_ptr<Face> face;
+    std::thread thread;
+  };
+  std::vector<unique_ptr<Shard>> m_shards;
+
+  struct FilterRecord
+  {
+    Name prefix;
+    size_t shard;
+    const RegisteredPrefixId* id;
+  };
+  /// serializes changes to m_filters and m_routes
+  std::mutex m_filtersMutex;
+  std::vector<FilterRecord> m_filters;
+
+  /**
+   * @brief immutable index of InterestFilter prefixes, used by put()
+   */
+  struct RouteTable
+  {
+    std::unordered_set<Name> prefixes;
+    /// distinct lengths of prefixes, in descending order
+    std::vector<size_t> prefixLengths;
+  };
+  /**
+   * @brief current RouteTable, replaced whenever an InterestFilter is set or unset
+   *
+   * It is read and replaced with std::atomic_load and std::atomic_store, so that producers
+   * calling put() do not take m_filtersMutex.
+   */
+  shared_ptr<const RouteTable> m_routes;
+};
+
+} // namespace ndn
+
+#endif // NDN_FACE_GROUP_HPP
@@ -123,6 +123,9 @@ Face::makeDefaultTransport()
     if (protocol == "unix") {
       return UnixTransport::create(transportUri);
     }
+    else if (protocol == "shm") {
+      return ShmTransport::create(transportUri);
+    }
     else if (protocol == "tcp" || protocol == "tcp4" || protocol == "tcp6") {
       return TcpTransport::create(transportUri);
     }
@@ -175,6 +178,17 @@ Face::expressInterest(const Interest& interest,
     BOOST_THROW_EXCEPTION(Error("Interest size exceeds maximum limit"));
   }
 
+  if (m_impl->m_commandQueue != nullptr) {
+    Impl::Command command;
+    command.type = Impl::Command::EXPRESS_INTEREST;
+    command.interest = interestToExpress;
+    command.afterSatisfied = afterSatisfied;
+    command.afterNacked = afterNacked;
+    command.afterTimeout = afterTimeout;
+    m_impl->enqueueCommand(std::move(command));
+    return reinterpret_cast<const PendingInterestId*>(interestToExpress.get());
+  }
+
   // If the same ioService thread, dispatch directly calls the method
   IO_CAPTURE_WEAK_IMPL(dispatch) {
     impl->asyncExpressInterest(interestToExpress, afterSatisfied, afterNacked, afterTimeout);
@@ -186,6 +200,16 @@ Face::expressInterest(const Interest& interest,
 void
 Face::removePendingInterest(const PendingInterestId* pendingInterestId)
 {
+  // queued behind the expressInterest commands, so that the removal cannot overtake
+  // the Interest it refers to
+  if (m_impl->m_commandQueue != nullptr) {
+    Impl::Command command;
+    command.type = Impl::Command::REMOVE_PENDING_INTEREST;
+    command.pendingInterestId = pendingInterestId;
+    m_impl->enqueueCommand(std::move(command));
+    return;
+  }
+
   IO_CAPTURE_WEAK_IMPL(post) {
     impl->asyncRemovePendingInterest(pendingInterestId);
   } IO_CAPTURE_WEAK_IMPL_END
@@ -194,6 +218,13 @@ Face::removePendingInterest(const PendingInterestId* pendingInterestId)
 void
 Face::removeAllPendingInterests()
 {
+  if (m_impl->m_commandQueue != nullptr) {
+    Impl::Command command;
+    command.type = Impl::Command::REMOVE_ALL_PENDING_INTERESTS;
+    m_impl->enqueueCommand(std::move(command));
+    return;
+  }
+
   IO_CAPTURE_WEAK_IMPL(post) {
     impl->asyncRemoveAllPendingInterests();
   } IO_CAPTURE_WEAK_IMPL_END
@@ -205,8 +236,68 @@ Face::getNPendingInterests() const
   return m_impl->m_pendingInterestTable.size();
 }
 
+void
+Face::setInterestAggregation(bool isEnabled)
+{
+  m_impl->m_isInterestAggregationEnabled = isEnabled;
+}
+
+bool
+Face::isInterestAggregationEnabled() const
+{
+  return m_impl->m_isInterestAggregationEnabled;
+}
+
+void
+Face::setContentCache(shared_ptr<util::InMemoryStorage> cache)
+{
+  if (cache != nullptr && !cache->isMustBeFreshHandled()) {
+    BOOST_THROW_EXCEPTION(std::invalid_argument("content cache must be created with "
+                                                "an io_service"));
+  }
+  m_impl->m_contentCache = std::move(cache);
+}
+
+shared_ptr<util::InMemoryStorage>
+Face::getContentCache() const
+{
+  return m_impl->m_contentCache;
+}
+
+const FaceCounters&
+Face::getCounters() const
+{
+  return m_impl->m_counters;
+}
+
+const TransportCounters&
+Face::getTransportCounters() const
+{
+  return m_transport->getCounters();
+}
+
 void
 Face::put(const Data& data)
+{
+  this->send(encodeData(data));
+  m_impl->m_counters.nOutData.fetch_add(1, std::memory_order_relaxed);
+}
+
+void
+Face::putBatch(const std::vector<shared_ptr<const Data>>& data)
+{
+  std::vector<Block> wires;
+  wires.reserve(data.size());
+  for (const shared_ptr<const Data>& packet : data) {
+    wires.push_back(encodeData(*packet));
+  }
+
+  this->send(wires);
+  m_impl->m_counters.nOutData.fetch_add(wires.size(), std::memory_order_relaxed);
+}
+
+Block
+Face::encodeData(const Data& data)
 {
   Block wire = data.wireEncode();
 
@@ -233,9 +324,7 @@ Face::put(const Data& data)
   if (wire.size() > MAX_NDN_PACKET_SIZE)
     BOOST_THROW_EXCEPTION(Error("Data size exceeds maximum limit"));
 
-  IO_CAPTURE_WEAK_IMPL(dispatch) {
-    impl->asyncSend(wire);
-  } IO_CAPTURE_WEAK_IMPL_END
+  return wire;
 }
 
 void
@@ -256,11 +345,56 @@ Face::put(const lp::Nack& nack)
   if (wire.size() > MAX_NDN_PACKET_SIZE)
     BOOST_THROW_EXCEPTION(Error("Nack size exceeds maximum limit"));
 
+  this->send(wire);
+  m_impl->m_counters.nOutNacks.fetch_add(1, std::memory_order_relaxed);
+}
+
+void
+Face::send(const Block& wire)
+{
+  if (m_impl->m_commandQueue != nullptr) {
+    Impl::Command command;
+    command.wire = wire;
+    m_impl->enqueueCommand(std::move(command));
+    return;
+  }
+
   IO_CAPTURE_WEAK_IMPL(dispatch) {
     impl->asyncSend(wire);
   } IO_CAPTURE_WEAK_IMPL_END
 }
 
+void
+Face::send(const std::vector<Block>& wires)
+{
+  if (m_impl->m_commandQueue != nullptr) {
+    for (const Block& wire : wires) {
+      Impl::Command command;
+      command.wire = wire;
+      m_impl->enqueueCommand(std::move(command));
+    }
+    return;
+  }
+
+  IO_CAPTURE_WEAK_IMPL(dispatch) {
+    impl->asyncSend(wires);
+  } IO_CAPTURE_WEAK_IMPL_END
+}
+
+void
+Face::enableMultiProducer()
+{
+  if (m_impl->m_commandQueue == nullptr) {
+    m_impl->m_commandQueue.reset(new MpscQueue<Impl::Command>);
+  }
+}
+
+bool
+Face::isMultiProducerEnabled() const
+{
+  return m_impl->m_commandQueue != nullptr;
+}
+
 const RegisteredPrefixId*
 Face::setInterestFilter(const InterestFilter& interestFilter,
                         const InterestCallback& onInterest,
@@ -373,7 +507,7 @@ Face::doProcessEvents(const time::milliseconds& timeout, bool keepThread)
   }
   catch (...) {
     m_impl->m_ioServiceWork.reset();
-    m_impl->m_pendingInterestTable.clear();
+    m_impl->asyncRemoveAllPendingInterests();
     m_impl->m_registeredPrefixTable.clear();
     throw;
   }
@@ -390,9 +524,12 @@ Face::shutdown()
 void
 Face::asyncShutdown()
 {
-  m_impl->m_pendingInterestTable.clear();
+  m_impl->asyncRemoveAllPendingInterests();
   m_impl->m_registeredPrefixTable.clear();
 
+  // packets put before shutdown are sent before the transport is closed
+  m_impl->flushSends();
+
   if (m_transport->isConnected())
     m_transport->close();
 
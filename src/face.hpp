@@ -32,6 +32,7 @@
 #include "lp/nack.hpp"
 #include "security/signing-info.hpp"
 #include "security/key-chain.hpp"
+#include "util/latency-histogram.hpp"
 
 namespace boost {
 namespace asio {
@@ -42,6 +43,7 @@ class io_service;
 namespace ndn {
 
 class Transport;
+struct TransportCounters;
 
 class PendingInterestId;
 class RegisteredPrefixId;
@@ -51,6 +53,10 @@ namespace nfd {
 class Controller;
 } // namespace nfd
 
+namespace util {
+class InMemoryStorage;
+} // namespace util
+
 /**
  * @brief Callback invoked when expressed Interest gets satisfied with a Data packet
  */
@@ -91,6 +97,38 @@ typedef function<void()> UnregisterPrefixSuccessCallback;
  */
 typedef function<void(const std::string&)> UnregisterPrefixFailureCallback;
 
+/**
+ * @brief Counters and latency measurements of a Face
+ *
+ * Counters are updated with relaxed atomic operations, so that they can be read on any
+ * thread while the Face is in use.
+ */
+struct FaceCounters
+{
+  std::atomic<uint64_t> nOutInterests{0}; ///< Interests sent to the forwarder
+  std::atomic<uint64_t> nInData{0};       ///< Data received from the forwarder
+  std::atomic<uint64_t> nInNacks{0};      ///< Nacks received from the forwarder
+  std::atomic<uint64_t> nTimeouts{0};     ///< pending Interests that timed out
+  std::atomic<uint64_t> nInInterests{0};  ///< Interests received from the forwarder
+  std::atomic<uint64_t> nOutData{0};      ///< Data sent to the forwarder
+  std::atomic<uint64_t> nOutNacks{0};     ///< Nacks sent to the forwarder
+
+  /// Interests not sent because they were aggregated with a pending Interest
+  std::atomic<uint64_t> nAggregatedInterests{0};
+
+  /// Interests satisfied from the content cache
+  std::atomic<uint64_t> nCacheHits{0};
+
+  /// Interests not found in the content cache
+  std::atomic<uint64_t> nCacheMisses{0};
+
+  /// number of entries in the pending Interest table
+  std::atomic<uint64_t> nPendingInterests{0};
+
+  /// delay between sending an Interest and receiving a Data that satisfies it
+  util::LatencyHistogram rtt;
+};
+
 /**
  * @brief Provide a communication channel with local or remote NDN forwarder
  */
@@ -246,6 +284,64 @@ public: // consumer
   size_t
   getNPendingInterests() const;
 
+  /**
+   * @brief Enable or disable client-side Interest aggregation
+   *
+   * When enabled, an expressed Interest is not sent to the forwarder if a pending Interest
+   * that has been sent has the same name, selectors, and NextHopFaceId.
+   * The new Interest waits in the pending Interest table with its own callbacks and
+   * InterestLifetime, and is satisfied or Nacked together with the Interest that was sent.
+   * If the Interest that was sent times out or is cancelled with removePendingInterest,
+   * the oldest unexpired Interest waiting on it is sent, and the others wait on that one.
+   *
+   * Aggregation is disabled by default.  It must be configured on the thread that runs the
+   * io_service, and it affects only Interests expressed afterwards.
+   */
+  void
+  setInterestAggregation(bool isEnabled);
+
+  bool
+  isInterestAggregationEnabled() const;
+
+  /**
+   * @brief Set the cache of Data retrieved through this face
+   *
+   * When a cache is set, expressInterest first searches it for a Data that satisfies the
+   * Interest.  On a hit, the Interest is not sent, and the Data callback is invoked from the
+   * io_service, never from within expressInterest.  Every Data that satisfies a pending
+   * Interest is inserted into the cache.  The replacement policy and capacity are those of
+   * the given InMemoryStorage.
+   *
+   * To honour MustBeFresh, @p cache must be constructed with the io_service of this face, so
+   * that a cached Data becomes stale after its FreshnessPeriod.  A Data without FreshnessPeriod
+   * never satisfies an Interest with MustBeFresh.
+   *
+   * The content cache must be configured on the thread that runs the io_service.
+   *
+   * @param cache the content cache, or nullptr to disable caching
+   * @throw std::invalid_argument @p cache was not created with an io_service
+   */
+  void
+  setContentCache(shared_ptr<util::InMemoryStorage> cache);
+
+  shared_ptr<util::InMemoryStorage>
+  getContentCache() const;
+
+public: // statistics
+  /**
+   * @brief Get packet counters and the Interest-Data round-trip time histogram
+   * @note The counters may be read from any thread.
+   */
+  const FaceCounters&
+  getCounters() const;
+
+  /**
+   * @brief Get byte counters and transmission queue depth of the underlying transport
+   * @note The counters may be read from any thread.
+   */
+  const TransportCounters&
+  getTransportCounters() const;
+
 public: // producer
   /**
    * @brief Set InterestFilter to dispatch incoming matching interest to onInterest
@@ -403,6 +499,19 @@ public: // producer
   void
   put(const Data& data);
 
+  /**
+   * @brief Publish several Data packets together
+   *
+   * The packets are handed to the transport at once, so that a stream-oriented transport
+   * writes them with a single scatter/gather operation.
+   *
+   * @param data Data packets to publish, in order
+   * @throw Error when the size of any Data exceeds maximum limit (MAX_NDN_PACKET_SIZE);
+   *              in this case, none of the packets is published
+   */
+  void
+  putBatch(const std::vector<shared_ptr<const Data>>& data);
+
   /**
    * @brief sends a Network NACK
    * @param nack the Nack; a copy will be made, so that the caller is not required to
@@ -411,6 +520,31 @@ public: // producer
   void
   put(const lp::Nack& nack);
 
+public: // multi-producer
+  /**
+   * @brief Allow put and expressInterest to be invoked from any thread
+   *
+   * Without this mode, put and expressInterest must be invoked from the thread that runs
+   * the io_service.  In multi-producer mode, they may be invoked concurrently from any
+   * number of threads: the packet is encoded on the calling thread and appended to a
+   * lock-free queue, which is drained in batches on the io_service thread.
+   * Packets from one thread are sent in the order in which they are submitted.
+   *
+   * Callbacks of expressInterest are invoked on the io_service thread.
+   * removePendingInterest and removeAllPendingInterests go through the same queue, so that
+   * a removal takes effect after the Interests expressed before it; they may also be invoked
+   * from any thread.  Other methods, such as setInterestFilter, must still be invoked from
+   * the io_service thread.
+   *
+   * @pre This is invoked before any other thread uses the Face.
+   * @note Multi-producer mode cannot be disabled once enabled.
+   */
+  void
+  enableMultiProducer();
+
+  bool
+  isMultiProducerEnabled() const;
+
 public: // IO routine
   /**
    * @brief Process any data to receive or call timeout callbacks.
@@ -488,6 +622,25 @@ private:
   void
   onReceiveElement(const Block& blockFromDaemon);
 
+  /**
+   * @brief send @p wire through the transport, or enqueue it in multi-producer mode
+   */
+  void
+  send(const Block& wire);
+
+  /**
+   * @brief send @p wires through the transport together, or enqueue them in multi-producer mode
+   */
+  void
+  send(const std::vector<Block>& wires);
+
+  /**
+   * @brief encode @p data into a packet to be sent, adding NDNLPv2 fields from its tags
+   * @throw Error Data size exceeds maximum limit (MAX_NDN_PACKET_SIZE)
+   */
+  static Block
+  encodeData(const Data& data);
+
   void
   asyncShutdown();
 
@@ -38,6 +38,7 @@ static_assert(std::is_base_of<tlv::Error, Interest::Error>::value,
 Interest::Interest()
   : m_interestLifetime(DEFAULT_INTEREST_LIFETIME)
   , m_selectedDelegationIndex(INVALID_SELECTED_DELEGATION_INDEX)
+  , m_wireUseCount(0)
 {
 }
 
@@ -45,6 +46,7 @@ Interest::Interest(const Name& name)
   : m_name(name)
   , m_interestLifetime(DEFAULT_INTEREST_LIFETIME)
   , m_selectedDelegationIndex(INVALID_SELECTED_DELEGATION_INDEX)
+  , m_wireUseCount(0)
 {
 }
 
@@ -52,6 +54,7 @@ Interest::Interest(const Name& name, const time::milliseconds& interestLifetime)
   : m_name(name)
   , m_interestLifetime(interestLifetime)
   , m_selectedDelegationIndex(INVALID_SELECTED_DELEGATION_INDEX)
+  , m_wireUseCount(0)
 {
 }
 
@@ -78,6 +81,7 @@ Interest&
 Interest::setNonce(uint32_t nonce)
 {
   if (m_wire.hasWire() && m_nonce.value_size() == sizeof(uint32_t)) {
+    ensureExclusiveWire();
     std::memcpy(const_cast<uint8_t*>(m_nonce.value()), &nonce, sizeof(nonce));
   }
   else {
@@ -228,11 +232,44 @@ Interest::setInterestLifetime(time::milliseconds interestLifetime)
   if (interestLifetime < time::milliseconds::zero()) {
     BOOST_THROW_EXCEPTION(std::invalid_argument("InterestLifetime must be >= 0"));
   }
+
+  if (m_wire.hasWire() && interestLifetime != DEFAULT_INTEREST_LIFETIME) {
+    uint64_t value = static_cast<uint64_t>(interestLifetime.count());
+    Block::element_const_iterator element = m_wire.find(tlv::InterestLifetime);
+    if (element != m_wire.elements_end() &&
+        element->value_size() == tlv::sizeOfNonNegativeInteger(value)) {
+      ensureExclusiveWire();
+      element = m_wire.find(tlv::InterestLifetime);
+
+      // NonNegativeInteger is in network byte order
+      uint8_t* octets = const_cast<uint8_t*>(element->value());
+      for (size_t i = element->value_size(); i > 0; --i) {
+        octets[i - 1] = static_cast<uint8_t>(value & 0xFF);
+        value >>= 8;
+      }
+      m_interestLifetime = interestLifetime;
+      return *this;
+    }
+  }
+
   m_interestLifetime = interestLifetime;
   m_wire.reset();
   return *this;
 }
 
+void
+Interest::ensureExclusiveWire()
+{
+  BOOST_ASSERT(m_wire.hasWire());
+
+  if (m_wire.getBuffer().use_count() == m_wireUseCount) {
+    return;
+  }
+
+  wireDecode(Block(make_shared<Buffer>(m_wire.wire(), m_wire.size())));
+  m_wireUseCount = m_wire.getBuffer().use_count();
+}
+
 template<encoding::Tag TAG>
 size_t
 Interest::wireEncode(EncodingImpl<TAG>& encoder) const
@@ -300,11 +337,16 @@ Interest::wireEncode() const
   EncodingEstimator estimator;
   size_t estimatedSize = wireEncode(estimator);
 
-  EncodingBuffer buffer(estimatedSize, 0);
-  wireEncode(buffer);
+  {
+    EncodingBuffer buffer(estimatedSize, 0);
+    wireEncode(buffer);
+
+    // to ensure that Nonce block points to the right memory location
+    const_cast<Interest*>(this)->wireDecode(buffer.block());
+  }
 
-  // to ensure that Nonce block points to the right memory location
-  const_cast<Interest*>(this)->wireDecode(buffer.block());
+  // the buffer is now referenced only by this Interest, so it can be modified in place
+  m_wireUseCount = m_wire.getBuffer().use_count();
 
   return m_wire;
 }
@@ -314,6 +356,7 @@ Interest::wireDecode(const Block& wire)
 {
   m_wire = wire;
   m_wire.parse();
+  m_wireUseCount = 0;
 
   // Interest ::= INTEREST-TYPE TLV-LENGTH
   //                Name
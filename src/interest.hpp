@@ -244,6 +244,11 @@ public: // Name and guiders
 
   /**
    * @brief Set Interest's lifetime
+   *
+   * If wire format already exists and the new lifetime is encoded in as many octets as
+   * the existing InterestLifetime element, the value is replaced in the existing wire format,
+   * without resetting and recreating it.
+   *
    * @throw std::invalid_argument specified lifetime is < 0
    */
   Interest&
@@ -267,7 +272,8 @@ public: // Name and guiders
   /** @brief Set Interest's nonce
    *
    *  If wire format already exists, this call simply replaces nonce in the
-   *  existing wire format, without resetting and recreating it.
+   *  existing wire format, without resetting and recreating it.  The wire format is
+   *  copied first if its buffer is shared, e.g., with a copy of this Interest.
    */
   Interest&
   setNonce(uint32_t nonce);
@@ -403,6 +409,15 @@ public: // EqualityComparable concept
     return !(*this == other);
   }
 
+private:
+  /** @brief make the wire format modifiable in place
+   *
+   *  The wire format is copied and decoded again, unless its buffer is known to be
+   *  referenced only by this Interest.
+   */
+  void
+  ensureExclusiveWire();
+
 private:
   Name m_name;
   Selectors m_selectors;
@@ -413,6 +428,9 @@ private:
   mutable shared_ptr<Link> m_linkCached;
   size_t m_selectedDelegationIndex;
   mutable Block m_wire;
+
+  /// use count of m_wire's buffer when only this Interest referenced it; 0 if unknown
+  mutable long m_wireUseCount;
 };
 
 std::ostream&
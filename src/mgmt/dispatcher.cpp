@@ -30,6 +30,12 @@ namespace mgmt {
 
 const time::milliseconds DEFAULT_FRESHNESS_PERIOD = time::milliseconds(1000);
 
+/** \brief maximum number of StatusDataset responses kept for reuse
+ *
+ *  Each distinct request Name, including any query condition, occupies one entry.
+ */
+const size_t MAX_CACHED_DATASETS = 64;
+
 Authorization
 makeAcceptAllAuthorization()
 {
@@ -165,7 +171,7 @@ Dispatcher::queryStorage(const Name& prefix, const Interest& interest,
   }
 }
 
-void
+shared_ptr<Data>
 Dispatcher::sendData(const Name& dataName, const Block& content, const MetaInfo& metaInfo,
                      SendDestination option, time::milliseconds imsFresh)
 {
@@ -184,6 +190,8 @@ Dispatcher::sendData(const Name& dataName, const Block& content, const MetaInfo&
   if (option == SendDestination::FACE || option == SendDestination::FACE_AND_IMS) {
     sendOnFace(*data);
   }
+
+  return data;
 }
 
 void
@@ -256,7 +264,8 @@ Dispatcher::sendControlResponse(const ControlResponse& resp, const Interest& int
 void
 Dispatcher::addStatusDataset(const PartialName& relPrefix,
                              const Authorization& authorization,
-                             const StatusDatasetHandler& handler)
+                             const StatusDatasetHandler& handler,
+                             const StatusDatasetGeneration& getGeneration)
 {
   if (!m_topLevelPrefixes.empty()) {
     BOOST_THROW_EXCEPTION(std::domain_error("one or more top-level prefix has been added"));
@@ -268,7 +277,7 @@ Dispatcher::addStatusDataset(const PartialName& relPrefix,
 
   AuthorizationAcceptedCallback accepted =
     bind(&Dispatcher::processAuthorizedStatusDatasetInterest, this,
-         _1, _2, _3, handler);
+         _1, _2, _3, handler, getGeneration);
   AuthorizationRejectedCallback rejected =
     bind(&Dispatcher::afterAuthorizationRejected, this, _1, _2);
 
@@ -301,17 +310,45 @@ void
 Dispatcher::processAuthorizedStatusDatasetInterest(const std::string& requester,
                                                    const Name& prefix,
                                                    const Interest& interest,
-                                                   const StatusDatasetHandler& handler)
+                                                   const StatusDatasetHandler& handler,
+                                                   const StatusDatasetGeneration& getGeneration)
 {
+  shared_ptr<CachedDataset> cached;
+  if (getGeneration != nullptr) {
+    uint64_t generation = getGeneration();
+
+    auto it = m_datasetCache.find(interest.getName());
+    if (it != m_datasetCache.end()) {
+      if (it->second->isComplete && it->second->generation == generation) {
+        NDN_LOG_DEBUG("reusing dataset " << it->second->segments.front()->getName().getPrefix(-1)
+                      << " at generation " << generation);
+        sendCachedDataset(*it->second);
+        return;
+      }
+    }
+    else if (m_datasetCache.size() >= MAX_CACHED_DATASETS) {
+      m_datasetCache.clear();
+    }
+
+    // a response still being generated for an earlier request keeps filling its own entry,
+    // which is no longer reachable from the cache
+    cached = make_shared<CachedDataset>();
+    cached->generation = generation;
+    cached->isComplete = false;
+    m_datasetCache[interest.getName()] = cached;
+  }
+
   StatusDatasetContext context(interest,
-                               bind(&Dispatcher::sendStatusDatasetSegment, this, _1, _2, _3, _4),
+                               bind(&Dispatcher::sendStatusDatasetSegment, this,
+                                    _1, _2, _3, _4, cached),
                                bind(&Dispatcher::sendControlResponse, this, _1, interest, true));
   handler(prefix, interest, context);
 }
 
 void
 Dispatcher::sendStatusDatasetSegment(const Name& dataName, const Block& content,
-                                     time::milliseconds imsFresh, bool isFinalBlock)
+                                     time::milliseconds imsFresh, bool isFinalBlock,
+                                     const shared_ptr<CachedDataset>& cached)
 {
   // the first segment will be sent to both places (the face and the in-memory storage)
   // other segments will be inserted to the in-memory storage only
@@ -325,7 +362,24 @@ Dispatcher::sendStatusDatasetSegment(const Name& dataName, const Block& content,
     metaInfo.setFinalBlockId(dataName[-1]);
   }
 
-  sendData(dataName, content, metaInfo, destination, imsFresh);
+  auto data = sendData(dataName, content, metaInfo, destination, imsFresh);
+
+  if (cached != nullptr) {
+    cached->imsFresh = imsFresh;
+    cached->segments.push_back(data);
+    cached->isComplete = isFinalBlock;
+  }
+}
+
+void
+Dispatcher::sendCachedDataset(const CachedDataset& cached)
+{
+  for (const auto& segment : cached.segments) {
+    // a stale copy left in the storage would prevent the insertion from refreshing it
+    m_storage.erase(segment->getFullName(), false);
+    m_storage.insert(*segment, cached.imsFresh);
+  }
+  sendOnFace(*cached.segments.front());
 }
 
 PostNotification
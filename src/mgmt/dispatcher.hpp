@@ -116,6 +116,13 @@ typedef std::function<void(const Name& prefix, const Interest& interest,
 typedef std::function<void(const Name& prefix, const Interest& interest,
                            StatusDatasetContext& context)> StatusDatasetHandler;
 
+/** \brief a function that returns the generation number of the data underlying a StatusDataset
+ *
+ *  The generation number must change whenever the table from which the dataset is produced
+ *  changes, so that a response generated at an earlier generation is not reused.
+ */
+typedef std::function<uint64_t()> StatusDatasetGeneration;
+
 //---- NOTIFICATION STREAM ----
 
 /** \brief a function to post a notification
@@ -231,6 +238,8 @@ public: // StatusDataset
    *                   (no relPrefix is a prefix of another relPrefix)
    *  \param authorization should set identity to Name() if the dataset is public
    *  \param handler Callback to process the incoming dataset requests
+   *  \param getGeneration if not empty, signed responses are cached and reused
+   *                       while this function returns the same generation number
    *  \pre no top-level prefix has been added
    *  \throw std::out_of_range \p relPrefix overlaps with an existing relPrefix
    *  \throw std::domain_error one or more top-level prefix has been added
@@ -254,11 +263,17 @@ public: // StatusDataset
    *
    *  As an optimization, a Data packet may be sent as soon as enough octets have been collected
    *  through StatusDatasetAppend calls.
+   *
+   *  When \p getGeneration is given, step 3 is preceded by a lookup of the last response to a
+   *  request with the same Name: if that response was completed at the current generation,
+   *  its signed segments, including the version component, are sent again and steps 3-8 are
+   *  skipped.
    */
   void
   addStatusDataset(const PartialName& relPrefix,
                    const Authorization& authorization,
-                   const StatusDatasetHandler& handler);
+                   const StatusDatasetHandler& handler,
+                   const StatusDatasetGeneration& getGeneration = nullptr);
 
 public: // NotificationStream
   /** \brief register a NotificationStream
@@ -352,8 +367,9 @@ private:
    * @param metaInfo some meta information of this piece of data
    * @param destination where to send this piece of data
    * @param imsFresh freshness period of this piece of data in in-memory storage
+   * @return the signed Data packet
    */
-  void
+  shared_ptr<Data>
   sendData(const Name& dataName, const Block& content, const MetaInfo& metaInfo,
            SendDestination destination, time::milliseconds imsFresh);
 
@@ -434,7 +450,19 @@ private:
   processAuthorizedStatusDatasetInterest(const std::string& requester,
                                          const Name& prefix,
                                          const Interest& interest,
-                                         const StatusDatasetHandler& handler);
+                                         const StatusDatasetHandler& handler,
+                                         const StatusDatasetGeneration& getGeneration);
+
+  /**
+   * @brief signed segments of a StatusDataset response, kept for reuse
+   */
+  struct CachedDataset
+  {
+    uint64_t generation;
+    time::milliseconds imsFresh;
+    std::vector<shared_ptr<Data>> segments;
+    bool isComplete;
+  };
 
   /**
    * @brief send a segment of StatusDataset
@@ -443,10 +471,21 @@ private:
    * @param content the content of this piece of data
    * @param imsFresh the freshness period of this piece of data in the in-memory storage
    * @param isFinalBlock indicates whether this piece of data is the final block
+   * @param cached if not nullptr, the signed segment is appended to this cache entry
    */
   void
   sendStatusDatasetSegment(const Name& dataName, const Block& content,
-                           time::milliseconds imsFresh, bool isFinalBlock);
+                           time::milliseconds imsFresh, bool isFinalBlock,
+                           const shared_ptr<CachedDataset>& cached);
+
+  /**
+   * @brief send a cached StatusDataset response as if it were just generated
+   *
+   * The first segment is sent through the face, and all segments are inserted into the
+   * in-memory storage.
+   */
+  void
+  sendCachedDataset(const CachedDataset& cached);
 
   void
   postNotification(const Block& notification, const PartialName& relPrefix);
@@ -472,6 +511,9 @@ private:
   // NotificationStream name => next sequence number
   std::unordered_map<Name, uint64_t> m_streams;
 
+  // StatusDataset request Name => last response
+  std::unordered_map<Name, shared_ptr<CachedDataset>> m_datasetCache;
+
 NDN_CXX_PUBLIC_WITH_TESTS_ELSE_PRIVATE:
   util::InMemoryStorageFifo m_storage;
 };
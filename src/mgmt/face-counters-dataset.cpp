@@ -0,0 +1,110 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2013-2017 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#include "face-counters-dataset.hpp"
+#include "../encoding/block-helpers.hpp"
+#include "../encoding/encoding-buffer.hpp"
+#include "../encoding/tlv-nfd.hpp"
+#include "../transport/transport.hpp"
+
+namespace ndn {
+namespace mgmt {
+
+template<encoding::Tag TAG>
+static size_t
+encodeRttHistogram(EncodingImpl<TAG>& encoder, const util::LatencyHistogram& histogram)
+{
+  size_t totalLength = 0;
+
+  for (size_t i = util::LatencyHistogram::N_BUCKETS; i-- > 0; ) {
+    uint64_t count = histogram.getBucketCount(i);
+    if (count == 0) {
+      continue;
+    }
+
+    size_t bucketLength = 0;
+    bucketLength += prependNonNegativeIntegerBlock(encoder, tlv::face_counters::RttCount, count);
+    bucketLength += prependNonNegativeIntegerBlock(encoder, tlv::face_counters::RttUpperBound,
+                      util::LatencyHistogram::getBucketUpperBound(i).count());
+    bucketLength += encoder.prependVarNumber(bucketLength);
+    bucketLength += encoder.prependVarNumber(tlv::face_counters::RttBucket);
+    totalLength += bucketLength;
+  }
+
+  totalLength += encoder.prependVarNumber(totalLength);
+  totalLength += encoder.prependVarNumber(tlv::face_counters::RttHistogram);
+  return totalLength;
+}
+
+template<encoding::Tag TAG>
+static size_t
+encodeFaceCounters(EncodingImpl<TAG>& encoder, const FaceCounters& counters,
+                   const TransportCounters& transportCounters)
+{
+  size_t totalLength = 0;
+
+  totalLength += encodeRttHistogram(encoder, counters.rtt);
+  totalLength += prependNonNegativeIntegerBlock(encoder, tlv::face_counters::NQueuedBytes,
+                                                transportCounters.nQueuedBytes);
+  totalLength += prependNonNegativeIntegerBlock(encoder, tlv::face_counters::NQueuedPackets,
+                                                transportCounters.nQueuedPackets);
+  totalLength += prependNonNegativeIntegerBlock(encoder, tlv::face_counters::NPendingInterests,
+                                                counters.nPendingInterests);
+  totalLength += prependNonNegativeIntegerBlock(encoder, tlv::face_counters::NTimeouts,
+                                                counters.nTimeouts);
+  totalLength += prependNonNegativeIntegerBlock(encoder, tlv::nfd::NOutBytes,
+                                                transportCounters.nOutBytes);
+  totalLength += prependNonNegativeIntegerBlock(encoder, tlv::nfd::NInBytes,
+                                                transportCounters.nInBytes);
+  totalLength += prependNonNegativeIntegerBlock(encoder, tlv::nfd::NOutNacks, counters.nOutNacks);
+  totalLength += prependNonNegativeIntegerBlock(encoder, tlv::nfd::NOutData, counters.nOutData);
+  totalLength += prependNonNegativeIntegerBlock(encoder, tlv::nfd::NOutInterests,
+                                                counters.nOutInterests);
+  totalLength += prependNonNegativeIntegerBlock(encoder, tlv::nfd::NInNacks, counters.nInNacks);
+  totalLength += prependNonNegativeIntegerBlock(encoder, tlv::nfd::NInData, counters.nInData);
+  totalLength += prependNonNegativeIntegerBlock(encoder, tlv::nfd::NInInterests,
+                                                counters.nInInterests);
+
+  totalLength += encoder.prependVarNumber(totalLength);
+  totalLength += encoder.prependVarNumber(tlv::face_counters::FaceCounters);
+  return totalLength;
+}
+
+Block
+encodeFaceCounters(const Face& face)
+{
+  EncodingBuffer encoder;
+  encodeFaceCounters(encoder, face.getCounters(), face.getTransportCounters());
+  return encoder.block();
+}
+
+StatusDatasetHandler
+makeFaceCountersDatasetHandler(const Face& face)
+{
+  const Face* facePtr = &face;
+  return [facePtr] (const Name&, const Interest&, StatusDatasetContext& context) {
+    context.append(encodeFaceCounters(*facePtr));
+    context.end();
+  };
+}
+
+} // namespace mgmt
+} // namespace ndn
@@ -0,0 +1,92 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2013-2017 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#ifndef NDN_MGMT_FACE_COUNTERS_DATASET_HPP
+#define NDN_MGMT_FACE_COUNTERS_DATASET_HPP
+
+#include "dispatcher.hpp"
+#include "../face.hpp"
+
+namespace ndn {
+
+namespace tlv {
+namespace face_counters {
+
+/** \brief TLV-TYPE numbers of the FaceCounters dataset
+ *
+ *  Packet and byte counters are encoded with the TLV-TYPE numbers of NFD FaceStatus,
+ *  e.g., tlv::nfd::NInInterests.
+ */
+enum {
+  FaceCounters      = 160,
+  NTimeouts         = 161,
+  NPendingInterests = 162,
+  NQueuedPackets    = 163,
+  NQueuedBytes      = 164,
+  RttHistogram      = 165,
+  RttBucket         = 166,
+  RttUpperBound     = 167,
+  RttCount          = 168
+};
+
+} // namespace face_counters
+} // namespace tlv
+
+namespace mgmt {
+
+/** \brief encode the counters of \p face
+ *
+ *  \code
+ *  FaceCounters := FACE-COUNTERS-TYPE TLV-LENGTH
+ *                    NInInterests NInData NInNacks
+ *                    NOutInterests NOutData NOutNacks
+ *                    NInBytes NOutBytes
+ *                    NTimeouts NPendingInterests
+ *                    NQueuedPackets NQueuedBytes
+ *                    RttHistogram
+ *  RttHistogram := RTT-HISTOGRAM-TYPE TLV-LENGTH RttBucket*
+ *  RttBucket := RTT-BUCKET-TYPE TLV-LENGTH
+ *                 RttUpperBound ; exclusive, in microseconds
+ *                 RttCount
+ *  \endcode
+ *
+ *  Only RTT buckets with a positive count are encoded.
+ */
+Block
+encodeFaceCounters(const Face& face);
+
+/** \brief make a StatusDataset handler that publishes the counters of \p face
+ *
+ *  The dataset contains a single FaceCounters element.  For example:
+ *  \code
+ *  dispatcher.addStatusDataset("face-counters", makeAcceptAllAuthorization(),
+ *                              makeFaceCountersDatasetHandler(face));
+ *  \endcode
+ *
+ *  \note \p face must remain valid while the handler is registered.
+ */
+StatusDatasetHandler
+makeFaceCountersDatasetHandler(const Face& face);
+
+} // namespace mgmt
+} // namespace ndn
+
+#endif // NDN_MGMT_FACE_COUNTERS_DATASET_HPP
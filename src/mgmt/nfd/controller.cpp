@@ -142,6 +142,20 @@ Controller::fetchDataset(const Name& prefix,
                         bind(&Controller::processDatasetFetchError, this, onFailure, _1, _2));
 }
 
+void
+Controller::fetchDataset(const Name& prefix,
+                         const std::function<bool(const Block&)>& processSegment,
+                         const DatasetCompleteCallback& onComplete,
+                         const DatasetFailCallback& onFailure,
+                         const CommandOptions& options)
+{
+  Interest baseInterest(prefix);
+  baseInterest.setInterestLifetime(options.getTimeout());
+
+  SegmentFetcher::fetchEach(m_face, baseInterest, m_validator, processSegment, onComplete,
+                            bind(&Controller::processDatasetFetchError, this, onFailure, _1, _2));
+}
+
 void
 Controller::processDatasetFetchError(const DatasetFailCallback& onFailure,
                                      uint32_t code, std::string msg)
@@ -64,6 +64,10 @@ public:
    */
   typedef function<void(uint32_t code, const std::string& reason)> DatasetFailCallback;
 
+  /** \brief a callback on completion of dataset retrieval with fetchEach
+   */
+  typedef function<void()> DatasetCompleteCallback;
+
   /** \brief construct a Controller that uses face for transport,
    *         and uses the passed KeyChain to sign commands
    */
@@ -105,6 +109,37 @@ public:
     this->fetchDataset(make_shared<Dataset>(param), onSuccess, onFailure, options);
   }
 
+  /** \brief start dataset fetching, delivering elements one by one
+   *
+   *  Instead of collecting the whole dataset into a vector, each element is decoded and passed
+   *  to \p onElement as soon as the segment that completes it has been validated, and
+   *  \p onComplete is invoked after the last element.  If retrieval or decoding fails,
+   *  \p onFailure is invoked instead of \p onComplete, possibly after some elements
+   *  have been delivered.
+   */
+  template<typename Dataset>
+  typename std::enable_if<std::is_default_constructible<Dataset>::value>::type
+  fetchEach(const std::function<void(const typename Dataset::ResultType::value_type&)>& onElement,
+            const DatasetCompleteCallback& onComplete,
+            const DatasetFailCallback& onFailure,
+            const CommandOptions& options = CommandOptions())
+  {
+    this->fetchDatasetEach(make_shared<Dataset>(), onElement, onComplete, onFailure, options);
+  }
+
+  /** \brief start dataset fetching, delivering elements one by one
+   */
+  template<typename Dataset, typename ParamType = typename Dataset::ParamType>
+  void
+  fetchEach(const ParamType& param,
+            const std::function<void(const typename Dataset::ResultType::value_type&)>& onElement,
+            const DatasetCompleteCallback& onComplete,
+            const DatasetFailCallback& onFailure,
+            const CommandOptions& options = CommandOptions())
+  {
+    this->fetchDatasetEach(make_shared<Dataset>(param), onElement, onComplete, onFailure, options);
+  }
+
 private:
   void
   startCommand(const shared_ptr<ControlCommand>& command,
@@ -138,6 +173,21 @@ private:
                const DatasetFailCallback& onFailure,
                const CommandOptions& options);
 
+  template<typename Dataset>
+  void
+  fetchDatasetEach(shared_ptr<Dataset> dataset,
+                   const std::function<void(const typename Dataset::ResultType::value_type&)>& onElement,
+                   const DatasetCompleteCallback& onComplete,
+                   const DatasetFailCallback& onFailure,
+                   const CommandOptions& options);
+
+  void
+  fetchDataset(const Name& prefix,
+               const std::function<bool(const Block&)>& processSegment,
+               const DatasetCompleteCallback& onComplete,
+               const DatasetFailCallback& onFailure,
+               const CommandOptions& options);
+
   template<typename Dataset>
   void
   processDatasetResponse(shared_ptr<Dataset> dataset,
@@ -217,6 +267,58 @@ Controller::processDatasetResponse(shared_ptr<Dataset> dataset,
   onSuccess(result);
 }
 
+template<typename Dataset>
+inline void
+Controller::fetchDatasetEach(shared_ptr<Dataset> dataset,
+                             const std::function<void(const typename Dataset::ResultType::value_type&)>& onElement1,
+                             const DatasetCompleteCallback& onComplete1,
+                             const DatasetFailCallback& onFailure1,
+                             const CommandOptions& options)
+{
+  typedef typename Dataset::ResultType::value_type Element;
+
+  std::function<void(const Element&)> onElement = onElement1 ?
+    onElement1 : [] (const Element&) {};
+  DatasetCompleteCallback onComplete = onComplete1 ?
+    onComplete1 : [] {};
+  DatasetFailCallback onFailure = onFailure1 ?
+    onFailure1 : [] (uint32_t, const std::string&) {};
+
+  auto parser = make_shared<StatusDatasetStreamParser>();
+
+  auto processSegment = [parser, onElement, onFailure] (const Block& content) -> bool {
+    // elements completed by this segment; callbacks are invoked outside of the try block
+    // so that exceptions thrown by them are not reported as decoding errors
+    std::vector<Element> elements;
+    try {
+      parser->feed(content, [&elements] (const Block& block) { elements.emplace_back(block); });
+    }
+    catch (const tlv::Error& e) {
+      onFailure(ERROR_SERVER, e.what());
+      return false;
+    }
+
+    for (const Element& element : elements) {
+      onElement(element);
+    }
+    return true;
+  };
+
+  auto processComplete = [parser, onComplete, onFailure] {
+    try {
+      parser->finish();
+    }
+    catch (const tlv::Error& e) {
+      onFailure(ERROR_SERVER, e.what());
+      return;
+    }
+    onComplete();
+  };
+
+  Name prefix = dataset->getDatasetPrefix(options.getPrefix());
+  this->fetchDataset(prefix, processSegment, processComplete, onFailure, options);
+}
+
 } // namespace nfd
 } // namespace ndn
 
@@ -160,5 +160,77 @@ RibDataset::parseResult(ConstBufferPtr payload) const
   return parseDatasetVector<RibEntry>(payload);
 }
 
+/**
+ * \brief determines the size of the element starting at \p begin
+ * \return total size of the element, or 0 if its TLV header is not complete
+ * \throw StatusDataset::ParseResultError the TLV header is invalid
+ */
+template<typename Iterator>
+static size_t
+getElementSize(Iterator begin, const Iterator& end)
+{
+  Iterator pos = begin;
+  uint64_t type = 0;
+  uint64_t length = 0;
+  if (!tlv::readVarNumber(pos, end, type) || !tlv::readVarNumber(pos, end, length)) {
+    return 0;
+  }
+  if (type == 0 || type > std::numeric_limits<uint32_t>::max() ||
+      length > std::numeric_limits<uint32_t>::max()) {
+    BOOST_THROW_EXCEPTION(StatusDataset::ParseResultError("cannot decode Block"));
+  }
+  return std::distance(begin, pos) + static_cast<size_t>(length);
+}
+
+void
+StatusDatasetStreamParser::feed(const Block& content, const ElementCallback& onElement)
+{
+  Buffer::const_iterator pos = content.value_begin();
+  const Buffer::const_iterator end = content.value_end();
+
+  // complete the element left over from the previous segment, starting with its TLV header,
+  // which may be split as well
+  while (!m_partial.empty()) {
+    size_t elementSize = getElementSize(m_partial.cbegin(), m_partial.cend());
+    if (elementSize == 0) {
+      if (pos == end) {
+        return;
+      }
+      m_partial.push_back(*pos++);
+      continue;
+    }
+
+    size_t nCopy = std::min<size_t>(elementSize - m_partial.size(), std::distance(pos, end));
+    m_partial.insert(m_partial.end(), pos, pos + nCopy);
+    pos += nCopy;
+    if (m_partial.size() < elementSize) {
+      return;
+    }
+
+    auto buffer = make_shared<Buffer>();
+    buffer->swap(m_partial);
+    onElement(Block(buffer));
+  }
+
+  while (pos != end) {
+    size_t elementSize = getElementSize(pos, end);
+    if (elementSize == 0 || elementSize > static_cast<size_t>(std::distance(pos, end))) {
+      m_partial.assign(pos, end);
+      return;
+    }
+
+    onElement(Block(content, pos, pos + elementSize));
+    pos += elementSize;
+  }
+}
+
+void
+StatusDatasetStreamParser::finish() const
+{
+  if (!m_partial.empty()) {
+    BOOST_THROW_EXCEPTION(StatusDataset::ParseResultError("payload ends within a Block"));
+  }
+}
+
 } // namespace nfd
 } // namespace ndn
@@ -248,6 +248,39 @@ public:
   parseResult(ConstBufferPtr payload) const;
 };
 
+/**
+ * \ingroup management
+ * \brief decodes the elements of a StatusDataset payload as its segments arrive
+ *
+ * Each complete element is passed on as soon as it is available.  Only the octets of an
+ * element that spans a segment boundary are copied and retained until the rest arrives;
+ * other elements share the buffer of the segment they are in.
+ */
+class StatusDatasetStreamParser : noncopyable
+{
+public:
+  typedef std::function<void(const Block& element)> ElementCallback;
+
+  /**
+   * \brief parses the content of the next segment
+   * \param content Content element of the segment
+   * \param onElement invoked for each element completed by this segment, in order
+   * \throw StatusDataset::ParseResultError an element has an invalid TLV header
+   */
+  void
+  feed(const Block& content, const ElementCallback& onElement);
+
+  /**
+   * \brief indicates that the last segment has been fed
+   * \throw StatusDataset::ParseResultError the payload ends in the middle of an element
+   */
+  void
+  finish() const;
+
+private:
+  Buffer m_partial; ///< leading octets of an element that spans a segment boundary
+};
+
 
 } // namespace nfd
 } // namespace ndn
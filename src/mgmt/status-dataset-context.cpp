@@ -82,7 +82,7 @@ StatusDatasetContext::append(const Block& block)
     nBytesLeft -= nBytesAppend;
 
     if (nBytesLeft > 0) {
-      m_dataSender(Name(m_prefix).appendSegment(m_segmentNo++),
+      m_dataSender(makeSegmentName(m_segmentNo++),
                    makeBinaryBlock(tlv::Content, m_buffer->buf(), m_buffer->size()),
                    m_expiry, false);
 
@@ -100,11 +100,24 @@ StatusDatasetContext::end()
 
   m_state = State::FINALIZED;
 
-  m_dataSender(Name(m_prefix).appendSegment(m_segmentNo),
+  m_dataSender(makeSegmentName(m_segmentNo),
                makeBinaryBlock(tlv::Content, m_buffer->buf(), m_buffer->size()),
                m_expiry, true);
 }
 
+Name
+StatusDatasetContext::makeSegmentName(uint64_t segmentNo)
+{
+  if (m_segmentName == nullptr) {
+    m_segmentName.reset(new NameBuilder(m_prefix));
+    m_segmentName->appendSegment(segmentNo);
+  }
+  else {
+    m_segmentName->replaceLastWithSegment(segmentNo);
+  }
+  return m_segmentName->getName();
+}
+
 void
 StatusDatasetContext::reject(const ControlResponse& resp /*= a ControlResponse with 400*/)
 {
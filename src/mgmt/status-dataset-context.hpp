@@ -24,6 +24,7 @@
 
 #include "../interest.hpp"
 #include "../data.hpp"
+#include "../name-builder.hpp"
 #include "../util/time.hpp"
 #include "../encoding/encoding-buffer.hpp"
 #include "control-response.hpp"
@@ -100,6 +101,13 @@ NDN_CXX_PUBLIC_WITH_TESTS_ELSE_PRIVATE:
                        const DataSender& dataSender,
                        const NackSender& nackSender);
 
+private:
+  /** \return prefix with a segment number component
+   *  \note The prefix must not change after the first call.
+   */
+  Name
+  makeSegmentName(uint64_t segmentNo);
+
 private:
   friend class Dispatcher;
 
@@ -108,6 +116,7 @@ private:
   NackSender m_nackSender;
   Name m_prefix;
   time::milliseconds m_expiry;
+  unique_ptr<NameBuilder> m_segmentName; ///< m_prefix followed by the last segment number
 
 NDN_CXX_PUBLIC_WITH_TESTS_ELSE_PRIVATE:
   shared_ptr<EncodingBuffer> m_buffer;
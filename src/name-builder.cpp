@@ -0,0 +1,218 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2013-2017 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#include "name-builder.hpp"
+#include "encoding/tlv.hpp"
+
+namespace ndn {
+
+/**
+ * @brief Write the VAR-NUMBER encoding of @p number at @p pos
+ * @return number of bytes written, i.e., tlv::sizeOfVarNumber(number)
+ */
+static size_t
+writeVarNumber(uint8_t* pos, uint64_t number)
+{
+  size_t size = tlv::sizeOfVarNumber(number);
+  size_t numberSize = size - 1;
+  if (size == 1) {
+    numberSize = 1;
+  }
+  else {
+    *pos++ = size == 3 ? 253 : size == 5 ? 254 : 255;
+  }
+
+  for (size_t i = numberSize; i > 0; --i) {
+    pos[i - 1] = static_cast<uint8_t>(number & 0xFF);
+    number >>= 8;
+  }
+  return size;
+}
+
+/**
+ * @brief Get the size of the NonNegativeInteger encoding of @p number
+ * @note Unlike tlv::sizeOfNonNegativeInteger, this matches the encoding of
+ *       Encoder::prependNonNegativeInteger, which uses one octet for numbers up to 255.
+ */
+static size_t
+sizeOfNonNegativeInteger(uint64_t number)
+{
+  if (number <= std::numeric_limits<uint8_t>::max())
+    return 1;
+  else if (number <= std::numeric_limits<uint16_t>::max())
+    return 2;
+  else if (number <= std::numeric_limits<uint32_t>::max())
+    return 4;
+  else
+    return 8;
+}
+
+NameBuilder::NameBuilder(const Name& prefix)
+  : m_nComponents(0)
+  , m_lastOffset(0)
+{
+  const Block& wire = prefix.wireEncode();
+  m_value.reserve(wire.value_size() + 16);
+  append(prefix);
+}
+
+NameBuilder&
+NameBuilder::append(const name::Component& component)
+{
+  m_lastOffset = m_value.size();
+  if (component.hasWire()) {
+    m_value.insert(m_value.end(), component.wire(), component.wire() + component.size());
+  }
+  else {
+    appendVarNumber(tlv::NameComponent);
+    appendVarNumber(component.value_size());
+    m_value.insert(m_value.end(), component.value(), component.value() + component.value_size());
+  }
+  ++m_nComponents;
+  return *this;
+}
+
+NameBuilder&
+NameBuilder::append(const uint8_t* value, size_t valueLength)
+{
+  return append(tlv::NameComponent, value, valueLength);
+}
+
+NameBuilder&
+NameBuilder::append(uint32_t type, const uint8_t* value, size_t valueLength)
+{
+  m_lastOffset = m_value.size();
+  appendVarNumber(type);
+  appendVarNumber(valueLength);
+  m_value.insert(m_value.end(), value, value + valueLength);
+  ++m_nComponents;
+  return *this;
+}
+
+NameBuilder&
+NameBuilder::append(const PartialName& name)
+{
+  for (const name::Component& component : name) {
+    append(component);
+  }
+  return *this;
+}
+
+NameBuilder&
+NameBuilder::appendNumber(uint64_t number)
+{
+  m_lastOffset = m_value.size();
+  appendVarNumber(tlv::NameComponent);
+  appendVarNumber(sizeOfNonNegativeInteger(number));
+  appendNonNegativeInteger(number);
+  ++m_nComponents;
+  return *this;
+}
+
+NameBuilder&
+NameBuilder::appendNumberWithMarker(uint8_t marker, uint64_t number)
+{
+  m_lastOffset = m_value.size();
+  appendVarNumber(tlv::NameComponent);
+  appendVarNumber(1 + sizeOfNonNegativeInteger(number));
+  m_value.push_back(marker);
+  appendNonNegativeInteger(number);
+  ++m_nComponents;
+  return *this;
+}
+
+NameBuilder&
+NameBuilder::removeLast()
+{
+  truncateLast();
+
+  // find the new last component by walking the remaining components
+  m_lastOffset = 0;
+  auto begin = m_value.cbegin();
+  auto end = m_value.cend();
+  while (begin != end) {
+    m_lastOffset = begin - m_value.cbegin();
+    tlv::readType(begin, end);
+    uint64_t length = tlv::readVarNumber(begin, end);
+    begin += length;
+  }
+  return *this;
+}
+
+NameBuilder&
+NameBuilder::replaceLast(const name::Component& component)
+{
+  truncateLast();
+  return append(component);
+}
+
+NameBuilder&
+NameBuilder::replaceLastWithNumberWithMarker(uint8_t marker, uint64_t number)
+{
+  truncateLast();
+  return appendNumberWithMarker(marker, number);
+}
+
+Block
+NameBuilder::wireEncode() const
+{
+  size_t headerSize = tlv::sizeOfVarNumber(tlv::Name) + tlv::sizeOfVarNumber(m_value.size());
+  auto buffer = make_shared<Buffer>(headerSize + m_value.size());
+
+  uint8_t* pos = buffer->get();
+  pos += writeVarNumber(pos, tlv::Name);
+  pos += writeVarNumber(pos, m_value.size());
+  std::copy(m_value.begin(), m_value.end(), pos);
+
+  return Block(buffer);
+}
+
+void
+NameBuilder::appendVarNumber(uint64_t number)
+{
+  size_t offset = m_value.size();
+  m_value.resize(offset + tlv::sizeOfVarNumber(number));
+  writeVarNumber(&m_value[offset], number);
+}
+
+void
+NameBuilder::appendNonNegativeInteger(uint64_t number)
+{
+  size_t size = sizeOfNonNegativeInteger(number);
+  size_t offset = m_value.size();
+  m_value.resize(offset + size);
+  for (size_t i = size; i > 0; --i) {
+    m_value[offset + i - 1] = static_cast<uint8_t>(number & 0xFF);
+    number >>= 8;
+  }
+}
+
+void
+NameBuilder::truncateLast()
+{
+  if (m_nComponents == 0) {
+    BOOST_THROW_EXCEPTION(Name::Error("NameBuilder is empty"));
+  }
+  m_value.resize(m_lastOffset);
+  --m_nComponents;
+}
+
+} // namespace ndn
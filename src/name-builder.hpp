@@ -0,0 +1,193 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2013-2017 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#ifndef NDN_NAME_BUILDER_HPP
+#define NDN_NAME_BUILDER_HPP
+
+#include "name.hpp"
+
+namespace ndn {
+
+/**
+ * @brief Builds Names whose components are encoded directly into one contiguous buffer
+ *
+ * Name::append* create a separate Block with its own Buffer for every component, and the
+ * next Name::wireEncode() re-encodes the entire Name.  NameBuilder instead keeps the
+ * TLV-VALUE of the Name in a single growable buffer, so that appending a component only
+ * writes its TLV, and getName() produces a Name with one allocation.
+ *
+ * The last component can be rewritten in place, which allows deriving sibling names
+ * (e.g., the next segment) from a common prefix without copying the prefix components:
+ * @code
+ * NameBuilder builder(prefix);
+ * builder.appendSegment(0);
+ * for (uint64_t segmentNo = 0; segmentNo < nSegments; ++segmentNo) {
+ *   Name segmentName = builder.replaceLastWithSegment(segmentNo).getName();
+ *   ...
+ * }
+ * @endcode
+ */
+class NameBuilder
+{
+public:
+  /**
+   * @brief Create a builder that initially contains the components of @p prefix
+   */
+  explicit
+  NameBuilder(const Name& prefix = Name());
+
+  /**
+   * @brief Get the number of components
+   */
+  size_t
+  size() const
+  {
+    return m_nComponents;
+  }
+
+  bool
+  empty() const
+  {
+    return m_nComponents == 0;
+  }
+
+  NameBuilder&
+  append(const name::Component& component);
+
+  NameBuilder&
+  append(const uint8_t* value, size_t valueLength);
+
+  /**
+   * @brief Append a component of TLV-TYPE @p type
+   */
+  NameBuilder&
+  append(uint32_t type, const uint8_t* value, size_t valueLength);
+
+  NameBuilder&
+  append(const PartialName& name);
+
+  NameBuilder&
+  appendNumber(uint64_t number);
+
+  NameBuilder&
+  appendNumberWithMarker(uint8_t marker, uint64_t number);
+
+  NameBuilder&
+  appendVersion(uint64_t version)
+  {
+    return appendNumberWithMarker(name::VERSION_MARKER, version);
+  }
+
+  NameBuilder&
+  appendSegment(uint64_t segmentNo)
+  {
+    return appendNumberWithMarker(name::SEGMENT_MARKER, segmentNo);
+  }
+
+  NameBuilder&
+  appendSequenceNumber(uint64_t seqNo)
+  {
+    return appendNumberWithMarker(name::SEQUENCE_NUMBER_MARKER, seqNo);
+  }
+
+  /**
+   * @brief Remove the last component
+   * @throw Name::Error the builder is empty
+   */
+  NameBuilder&
+  removeLast();
+
+  /**
+   * @brief Replace the last component with @p component
+   * @throw Name::Error the builder is empty
+   */
+  NameBuilder&
+  replaceLast(const name::Component& component);
+
+  /**
+   * @brief Replace the last component with a number-with-marker component
+   *
+   * Only the encoding of the last component is rewritten; preceding components are untouched.
+   *
+   * @throw Name::Error the builder is empty
+   */
+  NameBuilder&
+  replaceLastWithNumberWithMarker(uint8_t marker, uint64_t number);
+
+  /**
+   * @brief Replace the last component with a version component
+   * @throw Name::Error the builder is empty
+   */
+  NameBuilder&
+  replaceLastWithVersion(uint64_t version)
+  {
+    return replaceLastWithNumberWithMarker(name::VERSION_MARKER, version);
+  }
+
+  /**
+   * @brief Replace the last component with a segment number component
+   * @throw Name::Error the builder is empty
+   */
+  NameBuilder&
+  replaceLastWithSegment(uint64_t segmentNo)
+  {
+    return replaceLastWithNumberWithMarker(name::SEGMENT_MARKER, segmentNo);
+  }
+
+  /**
+   * @brief Encode the Name TLV
+   *
+   * The returned Block owns a new buffer, and is not affected by later modifications
+   * of the builder.
+   */
+  Block
+  wireEncode() const;
+
+  /**
+   * @brief Get the built Name
+   *
+   * The Name is decoded from wireEncode(), so that all its components share one buffer.
+   */
+  Name
+  getName() const
+  {
+    return Name(wireEncode());
+  }
+
+private:
+  void
+  appendVarNumber(uint64_t number);
+
+  void
+  appendNonNegativeInteger(uint64_t number);
+
+  void
+  truncateLast();
+
+private:
+  std::vector<uint8_t> m_value; ///< TLV-VALUE of the Name, i.e., the encoded components
+  size_t m_nComponents;
+  size_t m_lastOffset; ///< offset of the last component in m_value
+};
+
+} // namespace ndn
+
+#endif // NDN_NAME_BUILDER_HPP
@@ -30,7 +30,7 @@
 #include "util/string-helper.hpp"
 #include "util/crypto.hpp"
 
-#include <boost/algorithm/string/trim.hpp>
+#include <cctype>
 
 namespace ndn {
 namespace name {
@@ -88,91 +88,161 @@ Component::Component(const std::string& str)
 }
 
 
-Component
-Component::fromEscapedString(const char* escapedString, size_t beginOffset, size_t endOffset)
+/**
+ * @brief bitmap of characters that are not escaped in NDN URI: 0-9, A-Z, a-z, (+), (-), (.), (_)
+ */
+static const uint64_t URI_UNRESERVED[] = {0x03ff680000000000, 0x07fffffe87fffffe, 0, 0};
+
+static bool
+isUriUnreserved(uint8_t x)
+{
+  return (URI_UNRESERVED[x >> 6] >> (x & 0x3F)) & 1;
+}
+
+static bool
+isSpace(char c)
+{
+  return std::isspace(static_cast<unsigned char>(c)) != 0;
+}
+
+uint32_t
+Component::decodeEscapedString(const char* first, const char* last, std::vector<uint8_t>& value)
 {
-  std::string trimmedString(escapedString + beginOffset, escapedString + endOffset);
-  boost::algorithm::trim(trimmedString);
+  while (first != last && isSpace(*first))
+    ++first;
+  while (first != last && isSpace(*(last - 1)))
+    --last;
 
-  if (trimmedString.compare(0, getSha256DigestUriPrefix().size(),
-                            getSha256DigestUriPrefix()) == 0) {
-    if (trimmedString.size() != getSha256DigestUriPrefix().size() + crypto::SHA256_DIGEST_SIZE * 2)
+  value.clear();
+  size_t size = static_cast<size_t>(last - first);
+  const std::string& digestPrefix = getSha256DigestUriPrefix();
+
+  if (size >= digestPrefix.size() &&
+      std::equal(digestPrefix.begin(), digestPrefix.end(), first)) {
+    if (size != digestPrefix.size() + crypto::SHA256_DIGEST_SIZE * 2)
       BOOST_THROW_EXCEPTION(Error("Cannot convert to ImplicitSha256DigestComponent"
                                   "(expected sha256 in hex encoding)"));
 
-    try {
-      trimmedString.erase(0, getSha256DigestUriPrefix().size());
-      return fromImplicitSha256Digest(fromHex(trimmedString));
-    }
-    catch (const StringHelperError&) {
-      BOOST_THROW_EXCEPTION(Error("Cannot convert to a ImplicitSha256DigestComponent (invalid hex "
-                                  "encoding)"));
+    value.reserve(crypto::SHA256_DIGEST_SIZE);
+    for (const char* i = first + digestPrefix.size(); i != last; i += 2) {
+      int hi = fromHexChar(i[0]);
+      int lo = fromHexChar(i[1]);
+      if (hi < 0 || lo < 0)
+        BOOST_THROW_EXCEPTION(Error("Cannot convert to a ImplicitSha256DigestComponent (invalid hex "
+                                    "encoding)"));
+      value.push_back(static_cast<uint8_t>((hi << 4) | lo));
     }
+    return tlv::ImplicitSha256DigestComponent;
   }
-  else {
-    std::string value = unescape(trimmedString);
-
-    if (value.find_first_not_of(".") == std::string::npos) {
-      // Special case for component of only periods.
-      if (value.size() <= 2)
-        // Zero, one or two periods is illegal.  Ignore this component.
-        BOOST_THROW_EXCEPTION(Error("Illegal URI (name component cannot be . or ..)"));
-      else
-        // Remove 3 periods.
-        return Component(reinterpret_cast<const uint8_t*>(&value[3]), value.size() - 3);
+
+  // same decoding as unescape(): % not followed by two hex characters is kept as is
+  value.reserve(size);
+  bool hasNonPeriod = false;
+  for (size_t i = 0; i < size; ++i) {
+    uint8_t x = static_cast<uint8_t>(first[i]);
+    if (x == '%' && i + 2 < size) {
+      int hi = fromHexChar(first[i + 1]);
+      int lo = fromHexChar(first[i + 2]);
+      if (hi < 0 || lo < 0) {
+        value.insert(value.end(), first + i, first + i + 3);
+        hasNonPeriod = true;
+      }
+      else {
+        x = static_cast<uint8_t>((hi << 4) | lo);
+        value.push_back(x);
+        hasNonPeriod = hasNonPeriod || x != '.';
+      }
+      i += 2;
     }
+    else {
+      value.push_back(x);
+      hasNonPeriod = hasNonPeriod || x != '.';
+    }
+  }
+
+  if (!hasNonPeriod) {
+    // Special case for component of only periods.
+    if (value.size() <= 2)
+      // Zero, one or two periods is illegal.  Ignore this component.
+      BOOST_THROW_EXCEPTION(Error("Illegal URI (name component cannot be . or ..)"));
     else
-      return Component(reinterpret_cast<const uint8_t*>(&value[0]), value.size());
+      // Remove 3 periods.
+      value.erase(value.begin(), value.begin() + 3);
   }
+  return tlv::NameComponent;
 }
 
+Component
+Component::fromEscapedString(const char* escapedString, size_t beginOffset, size_t endOffset)
+{
+  std::vector<uint8_t> value;
+  uint32_t type = decodeEscapedString(escapedString + beginOffset, escapedString + endOffset, value);
+
+  if (type == tlv::ImplicitSha256DigestComponent)
+    return fromImplicitSha256Digest(value.data(), value.size());
+  else
+    return Component(value.data(), value.size());
+}
 
 void
 Component::toUri(std::ostream& result) const
 {
+  std::string uri;
+  toUri(uri);
+  result.write(uri.data(), uri.size());
+}
+
+void
+Component::toUri(std::string& result) const
+{
+  static const char HEX_LOWER[] = "0123456789abcdef";
+  static const char HEX_UPPER[] = "0123456789ABCDEF";
+
+  const uint8_t* value = this->value();
+  size_t valueSize = value_size();
+
   if (type() == tlv::ImplicitSha256DigestComponent) {
-    result << getSha256DigestUriPrefix();
+    const std::string& digestPrefix = getSha256DigestUriPrefix();
+    size_t offset = result.size();
+    result.resize(offset + digestPrefix.size() + valueSize * 2);
+    char* out = &result[offset];
+    out = std::copy(digestPrefix.begin(), digestPrefix.end(), out);
+    for (size_t i = 0; i < valueSize; ++i) {
+      *out++ = HEX_LOWER[value[i] >> 4];
+      *out++ = HEX_LOWER[value[i] & 0xF];
+    }
+    return;
+  }
 
-    printHex(result, value(), value_size(), false);
+  // scan once to determine the output size
+  size_t nEscaped = 0;
+  bool hasNonPeriod = false;
+  for (size_t i = 0; i < valueSize; ++i) {
+    nEscaped += !isUriUnreserved(value[i]);
+    hasNonPeriod = hasNonPeriod || value[i] != '.';
   }
-  else {
-    const uint8_t* value = this->value();
-    size_t valueSize = value_size();
 
-    bool gotNonDot = false;
+  if (!hasNonPeriod) {
+    // Special case for component of zero or more periods.  Add 3 periods.
+    result.append(valueSize + 3, '.');
+  }
+  else if (nEscaped == 0) {
+    result.append(reinterpret_cast<const char*>(value), valueSize);
+  }
+  else {
+    size_t offset = result.size();
+    result.resize(offset + valueSize + nEscaped * 2);
+    char* out = &result[offset];
     for (size_t i = 0; i < valueSize; ++i) {
-      if (value[i] != 0x2e) {
-        gotNonDot = true;
-        break;
+      uint8_t x = value[i];
+      if (isUriUnreserved(x)) {
+        *out++ = static_cast<char>(x);
       }
-    }
-    if (!gotNonDot) {
-      // Special case for component of zero or more periods.  Add 3 periods.
-      result << "...";
-      for (size_t i = 0; i < valueSize; ++i)
-        result << '.';
-    }
-    else {
-      // In case we need to escape, set to upper case hex and save the previous flags.
-      auto savedFlags = result.flags(std::ios::hex | std::ios::uppercase);
-
-      for (size_t i = 0; i < valueSize; ++i) {
-        uint8_t x = value[i];
-        // Check for 0-9, A-Z, a-z, (+), (-), (.), (_)
-        if ((x >= 0x30 && x <= 0x39) || (x >= 0x41 && x <= 0x5a) ||
-            (x >= 0x61 && x <= 0x7a) || x == 0x2b || x == 0x2d ||
-            x == 0x2e || x == 0x5f)
-          result << x;
-        else {
-          result << '%';
-          if (x < 16)
-            result << '0';
-          result << static_cast<uint32_t>(x);
-        }
+      else {
+        *out++ = '%';
+        *out++ = HEX_UPPER[x >> 4];
+        *out++ = HEX_UPPER[x & 0xF];
       }
-
-      // Restore.
-      result.flags(savedFlags);
     }
   }
 }
@@ -180,9 +250,9 @@ Component::toUri(std::ostream& result) const
 std::string
 Component::toUri() const
 {
-  std::ostringstream os;
-  toUri(os);
-  return os.str();
+  std::string uri;
+  toUri(uri);
+  return uri;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -203,6 +203,18 @@ public:
     return fromEscapedString(escapedString.c_str(), 0, escapedString.size());
   }
 
+  /**
+   * @brief Decode an NDN URI-encoded name component without creating a name::Component
+   *
+   * [first, last) is decoded in the same way as fromEscapedString, and the TLV-VALUE is
+   * stored into @p value, whose previous content is discarded.
+   *
+   * @return TLV-TYPE of the decoded component
+   * @throw Error [first, last) is not a valid URI-encoded name component
+   */
+  static uint32_t
+  decodeEscapedString(const char* first, const char* last, std::vector<uint8_t>& value);
+
   /**
    * @brief Write *this to the output stream, escaping characters according to the NDN URI Scheme
    *
@@ -213,6 +225,15 @@ public:
   void
   toUri(std::ostream& os) const;
 
+  /**
+   * @brief Append *this to @p result, escaping characters according to the NDN URI Scheme
+   *
+   * This produces the same output as toUri(std::ostream&), with at most one reallocation
+   * of @p result.
+   */
+  void
+  toUri(std::string& result) const;
+
   /**
    * @brief Convert *this by escaping characters according to the NDN URI Scheme
    *
@@ -24,14 +24,16 @@
  */
 
 #include "name.hpp"
+#include "name-builder.hpp"
 
 #include "util/time.hpp"
 #include "encoding/block.hpp"
 #include "encoding/encoding-buffer.hpp"
 
-#include <boost/algorithm/string/trim.hpp>
 #include <boost/functional/hash.hpp>
 
+#include <cctype>
+
 namespace ndn {
 
 BOOST_CONCEPT_ASSERT((boost::EqualityComparable<Name>));
@@ -59,53 +61,65 @@ Name::Name(const char* uri)
 {
 }
 
+static bool
+isSpace(char c)
+{
+  return std::isspace(static_cast<unsigned char>(c)) != 0;
+}
+
 Name::Name(std::string uri)
 {
-  boost::algorithm::trim(uri);
-  if (uri.empty())
+  const char* first = uri.data();
+  const char* last = first + uri.size();
+
+  while (first != last && isSpace(*first))
+    ++first;
+  while (first != last && isSpace(*(last - 1)))
+    --last;
+  if (first == last)
     return;
 
-  size_t iColon = uri.find(':');
-  if (iColon != std::string::npos) {
+  const char* colon = std::find(first, last, ':');
+  if (colon != last) {
     // Make sure the colon came before a '/'.
-    size_t iFirstSlash = uri.find('/');
-    if (iFirstSlash == std::string::npos || iColon < iFirstSlash) {
+    const char* firstSlash = std::find(first, last, '/');
+    if (firstSlash == last || colon < firstSlash) {
       // Omit the leading protocol such as ndn:
-      uri.erase(0, iColon + 1);
-      boost::algorithm::trim(uri);
+      first = colon + 1;
+      while (first != last && isSpace(*first))
+        ++first;
     }
   }
 
   // Trim the leading slash and possibly the authority.
-  if (uri[0] == '/') {
-    if (uri.size() >= 2 && uri[1] == '/') {
+  if (first != last && *first == '/') {
+    if (last - first >= 2 && first[1] == '/') {
       // Strip the authority following "//".
-      size_t iAfterAuthority = uri.find('/', 2);
-      if (iAfterAuthority == std::string::npos)
+      const char* afterAuthority = std::find(first + 2, last, '/');
+      if (afterAuthority == last)
         // Unusual case: there was only an authority.
         return;
-      else {
-        uri.erase(0, iAfterAuthority + 1);
-        boost::algorithm::trim(uri);
-      }
+      first = afterAuthority + 1;
     }
     else {
-      uri.erase(0, 1);
-      boost::algorithm::trim(uri);
+      ++first;
     }
+    while (first != last && isSpace(*first))
+      ++first;
   }
 
-  size_t iComponentStart = 0;
-
-  // Unescape the components.
-  while (iComponentStart < uri.size()) {
-    size_t iComponentEnd = uri.find("/", iComponentStart);
-    if (iComponentEnd == std::string::npos)
-      iComponentEnd = uri.size();
-
-    append(Component::fromEscapedString(&uri[0], iComponentStart, iComponentEnd));
-    iComponentStart = iComponentEnd + 1;
+  // Unescape the components directly into the Name TLV-VALUE.
+  NameBuilder builder;
+  std::vector<uint8_t> value;
+  while (first != last) {
+    const char* componentEnd = std::find(first, last, '/');
+    uint32_t type = Component::decodeEscapedString(first, componentEnd, value);
+    builder.append(type, value.data(), value.size());
+    first = componentEnd == last ? last : componentEnd + 1;
   }
+
+  m_nameBlock = builder.wireEncode();
+  m_nameBlock.parse();
 }
 
 Name
@@ -170,9 +184,30 @@ Name::wireDecode(const Block& wire)
 std::string
 Name::toUri() const
 {
-  std::ostringstream os;
-  os << *this;
-  return os.str();
+  std::string uri;
+  toUri(uri);
+  return uri;
+}
+
+void
+Name::toUri(std::string& result) const
+{
+  if (empty()) {
+    result.push_back('/');
+    return;
+  }
+
+  // estimate the output size assuming no escaping
+  size_t estimatedSize = result.size();
+  for (const Component& component : *this) {
+    estimatedSize += 1 + component.value_size();
+  }
+  result.reserve(estimatedSize);
+
+  for (const Component& component : *this) {
+    result.push_back('/');
+    component.toUri(result);
+  }
 }
 
 Name&
@@ -340,18 +375,9 @@ Name::compare(size_t pos1, size_t count1, const Name& other, size_t pos2, size_t
 std::ostream&
 operator<<(std::ostream& os, const Name& name)
 {
-  if (name.empty())
-    {
-      os << "/";
-    }
-  else
-    {
-      for (Name::const_iterator i = name.begin(); i != name.end(); i++) {
-        os << "/";
-        i->toUri(os);
-      }
-    }
-  return os;
+  std::string uri;
+  name.toUri(uri);
+  return os.write(uri.data(), uri.size());
 }
 
 std::istream&
@@ -253,6 +253,15 @@ public:
   std::string
   toUri() const;
 
+  /**
+   * @brief Append the URI of this name to @p result
+   *
+   * This produces the same output as toUri() and operator<<, but formats directly into
+   * @p result, which is reserved once for the expected size.
+   */
+  void
+  toUri(std::string& result) const;
+
   /**
    * @brief Append a component with the number encoded as nonNegativeInteger
    *
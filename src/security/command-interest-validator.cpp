@@ -58,18 +58,38 @@ invokeReject(const OnInterestValidationFailed& reject, const Interest& interest,
   reject(interest.shared_from_this(), boost::lexical_cast<std::string>(error));
 }
 
+/** \brief number of cleanup passes over the records of a partition per timestampTtl
+ *
+ *  Expired records are deleted in a batch once per timestampTtl / CLEANUP_PASSES_PER_TTL
+ *  instead of on every command Interest.  A record that has expired but not yet been deleted
+ *  is ignored by checkTimestamp.
+ */
+static const int CLEANUP_PASSES_PER_TTL = 16;
+
 CommandInterestValidator::CommandInterestValidator(unique_ptr<Validator> inner,
                                                    const Options& options)
   : m_inner(std::move(inner))
   , m_options(options)
-  , m_index(m_container.get<0>())
-  , m_queue(m_container.get<1>())
 {
   if (m_inner == nullptr) {
     BOOST_THROW_EXCEPTION(std::invalid_argument("inner validator is nullptr"));
   }
 
   m_options.gracePeriod = std::max(m_options.gracePeriod, time::nanoseconds::zero());
+  m_options.nShards = std::max<size_t>(m_options.nShards, 1);
+
+  m_maxTimestampsPerShard = m_options.maxTimestamps;
+  if (m_maxTimestampsPerShard > 0) {
+    ssize_t nShards = static_cast<ssize_t>(m_options.nShards);
+    m_maxTimestampsPerShard = (m_maxTimestampsPerShard + nShards - 1) / nShards;
+  }
+  m_cleanupInterval = std::max(m_options.timestampTtl / CLEANUP_PASSES_PER_TTL,
+                               time::nanoseconds::zero());
+
+  m_shards.reserve(m_options.nShards);
+  for (size_t i = 0; i < m_options.nShards; ++i) {
+    m_shards.push_back(make_unique<Shard>());
+  }
 }
 
 void
@@ -79,7 +99,6 @@ CommandInterestValidator::checkPolicy(const Interest& interest, int nSteps,
                                       std::vector<shared_ptr<ValidationRequest>>& nextSteps)
 {
   BOOST_ASSERT(nSteps == 0);
-  this->cleanup();
 
   Name keyName;
   uint64_t timestamp;
@@ -101,14 +120,17 @@ CommandInterestValidator::checkPolicy(const Interest& interest, int nSteps,
 }
 
 void
-CommandInterestValidator::cleanup()
+CommandInterestValidator::cleanup(Shard& shard, time::steady_clock::TimePoint now)
 {
-  time::steady_clock::TimePoint expiring = time::steady_clock::now() - m_options.timestampTtl;
+  if (now < shard.nextCleanup) {
+    return;
+  }
+  shard.nextCleanup = now + m_cleanupInterval;
 
-  while ((!m_queue.empty() && m_queue.front().lastRefreshed <= expiring) ||
-         (m_options.maxTimestamps >= 0 &&
-          m_queue.size() > static_cast<size_t>(m_options.maxTimestamps))) {
-    m_queue.pop_front();
+  time::steady_clock::TimePoint expiring = now - m_options.timestampTtl;
+  Queue& queue = shard.container.get<1>();
+  while (!queue.empty() && queue.front().lastRefreshed <= expiring) {
+    queue.pop_front();
   }
 }
 
@@ -160,34 +182,48 @@ CommandInterestValidator::ErrorCode
 CommandInterestValidator::checkTimestamp(const Name& keyName, uint64_t timestamp,
                                          time::system_clock::TimePoint receiveTime)
 {
-  time::steady_clock::TimePoint now = time::steady_clock::now();
+  size_t keyNameHash = std::hash<Name>()(keyName);
+  Shard& shard = *m_shards[keyNameHash % m_shards.size()];
+  std::lock_guard<std::mutex> lock(shard.mutex);
 
-  // try to insert new record
-  Queue::iterator i = m_queue.end();
-  bool isNew = false;
-  std::tie(i, isNew) = m_queue.push_back({keyName, timestamp, now});
+  time::steady_clock::TimePoint now = time::steady_clock::now();
+  this->cleanup(shard, now);
+  Index& index = shard.container.get<0>();
+  Queue& queue = shard.container.get<1>();
+
+  Index::iterator i = index.find(HashedKeyName{keyName, keyNameHash},
+                                 RecordHash(), RecordEqual());
+  if (i != index.end() && i->lastRefreshed <= now - m_options.timestampTtl) {
+    // expired, but not yet deleted by cleanup
+    index.erase(i);
+    i = index.end();
+  }
 
-  if (isNew) {
+  if (i == index.end()) {
     // check grace period
     time::system_clock::TimePoint sigTime = time::fromUnixTimestamp(time::milliseconds(timestamp));
     if (time::abs(sigTime - receiveTime) > m_options.gracePeriod) {
-      // out of grace period, delete new record
-      m_queue.erase(i);
       return ErrorCode::TIMESTAMP_OUT_OF_GRACE;
     }
+
+    queue.push_back({keyName, keyNameHash, timestamp, now});
+    while (m_maxTimestampsPerShard >= 0 &&
+           queue.size() > static_cast<size_t>(m_maxTimestampsPerShard)) {
+      queue.pop_front();
+    }
   }
   else {
-    BOOST_ASSERT(i->keyName == keyName);
-
     // compare timestamp with last timestamp
     if (timestamp <= i->timestamp) {
       return ErrorCode::TIMESTAMP_REORDER;
     }
 
-    // set lastRefreshed field, and move to queue tail
-    m_queue.erase(i);
-    isNew = m_queue.push_back({keyName, timestamp, now}).second;
-    BOOST_ASSERT(isNew);
+    // set timestamp and lastRefreshed fields, and move to queue tail
+    index.modify(i, [=] (LastTimestampRecord& record) {
+      record.timestamp = timestamp;
+      record.lastRefreshed = now;
+    });
+    queue.relocate(queue.end(), shard.container.project<1>(i));
   }
 
   return ErrorCode::NONE;
@@ -24,10 +24,12 @@
 
 #include "validator.hpp"
 #include <boost/multi_index_container.hpp>
-#include <boost/multi_index/ordered_index.hpp>
+#include <boost/multi_index/hashed_index.hpp>
 #include <boost/multi_index/sequenced_index.hpp>
 #include <boost/multi_index/key_extractors.hpp>
 
+#include <mutex>
+
 namespace ndn {
 namespace security {
 
@@ -36,6 +38,10 @@ namespace security {
  *
  *  This validator checks timestamp field of a stop-and-wait command Interest.
  *  Signed Interest validation and Data validation requests are delegated to an inner validator.
+ *
+ *  Last timestamp records are kept in Options::nShards partitions, each protected by its own
+ *  mutex, so that the timestamp check can run concurrently when the inner validator completes
+ *  validation on several threads.
  */
 class CommandInterestValidator : public Validator
 {
@@ -88,6 +94,18 @@ public:
      *  and causes every command Interest to be processed as initial.
      */
     time::nanoseconds timestampTtl = time::hours(1);
+
+    /** \brief number of partitions of last timestamp records
+     *
+     *  Records are assigned to partitions by the hash of the public key name, and each
+     *  partition is protected by its own mutex.  Use more than one partition when command
+     *  Interests are validated on several threads, to reduce contention.
+     *
+     *  maxTimestamps is divided evenly among the partitions, rounding up; with more than one
+     *  partition, the record evicted when a partition is full is the oldest in that partition.
+     *  Setting this option to 0 is the same as setting it to 1.
+     */
+    size_t nShards = 1;
   };
 
   /** \brief error codes
@@ -145,32 +163,67 @@ protected:
               std::vector<shared_ptr<ValidationRequest>>& nextSteps) override;
 
 private:
-  void
-  cleanup();
-
-  ErrorCode
-  parseCommandInterest(const Interest& interest, Name& keyName, uint64_t& timestamp) const;
-
-  ErrorCode
-  checkTimestamp(const Name& keyName, uint64_t timestamp,
-                 time::system_clock::TimePoint receiveTime);
-
-private:
-  unique_ptr<Validator> m_inner;
-  Options m_options;
-
   struct LastTimestampRecord
   {
     Name keyName;
+    size_t keyNameHash; ///< std::hash<Name> of keyName, which also selects the shard
     uint64_t timestamp;
     time::steady_clock::TimePoint lastRefreshed;
   };
 
+  /** \brief lookup key of a LastTimestampRecord, carrying a precomputed keyNameHash
+   */
+  struct HashedKeyName
+  {
+    const Name& keyName;
+    size_t keyNameHash;
+  };
+
+  /** \brief hashes records by their stored keyNameHash, so that Name is hashed only once
+   */
+  struct RecordHash
+  {
+    size_t
+    operator()(const LastTimestampRecord& record) const
+    {
+      return record.keyNameHash;
+    }
+
+    size_t
+    operator()(const HashedKeyName& key) const
+    {
+      return key.keyNameHash;
+    }
+  };
+
+  struct RecordEqual
+  {
+    bool
+    operator()(const LastTimestampRecord& a, const LastTimestampRecord& b) const
+    {
+      return a.keyNameHash == b.keyNameHash && a.keyName == b.keyName;
+    }
+
+    bool
+    operator()(const HashedKeyName& key, const LastTimestampRecord& record) const
+    {
+      return key.keyNameHash == record.keyNameHash && key.keyName == record.keyName;
+    }
+
+    bool
+    operator()(const LastTimestampRecord& record, const HashedKeyName& key) const
+    {
+      return (*this)(key, record);
+    }
+  };
+
   typedef boost::multi_index_container<
     LastTimestampRecord,
     boost::multi_index::indexed_by<
-      boost::multi_index::ordered_unique<
-        boost::multi_index::member<LastTimestampRecord, Name, &LastTimestampRecord::keyName>
+      boost::multi_index::hashed_unique<
+        boost::multi_index::identity<LastTimestampRecord>,
+        RecordHash,
+        RecordEqual
       >,
       boost::multi_index::sequenced<>
     >
@@ -178,9 +231,37 @@ private:
   typedef Container::nth_index<0>::type Index;
   typedef Container::nth_index<1>::type Queue;
 
-  Container m_container;
-  Index& m_index;
-  Queue& m_queue;
+  /** \brief a partition of last timestamp records
+   *
+   *  The queue is ordered by lastRefreshed, oldest first.
+   */
+  struct Shard
+  {
+    std::mutex mutex;
+    Container container;
+    time::steady_clock::TimePoint nextCleanup;
+  };
+
+  /** \brief delete expired records from \p shard, at most once per cleanup interval
+   *  \pre shard.mutex is locked
+   */
+  void
+  cleanup(Shard& shard, time::steady_clock::TimePoint now);
+
+  ErrorCode
+  parseCommandInterest(const Interest& interest, Name& keyName, uint64_t& timestamp) const;
+
+  ErrorCode
+  checkTimestamp(const Name& keyName, uint64_t timestamp,
+                 time::system_clock::TimePoint receiveTime);
+
+private:
+  unique_ptr<Validator> m_inner;
+  Options m_options;
+  ssize_t m_maxTimestampsPerShard;
+  time::nanoseconds m_cleanupInterval;
+
+  std::vector<unique_ptr<Shard>> m_shards;
 };
 
 std::ostream&
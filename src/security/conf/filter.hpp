@@ -70,6 +70,18 @@ public:
     return matchName(unsignedName);
   }
 
+  /**
+   * @brief Get the name prefix that every name matched by this filter starts with
+   *
+   * For Interest packets the prefix applies to the name without signature components.
+   * An empty name is returned if the filter may match names under any prefix.
+   */
+  virtual Name
+  getRequiredPrefix() const
+  {
+    return Name();
+  }
+
 protected:
   virtual bool
   matchName(const Name& name) = 0;
@@ -96,6 +108,12 @@ public:
   {
   }
 
+  virtual Name
+  getRequiredPrefix() const
+  {
+    return m_name;
+  }
+
 protected:
   virtual bool
   matchName(const Name& name)
@@ -124,6 +142,7 @@ public:
   explicit
   RegexNameFilter(const Regex& regex)
     : m_regex(regex)
+    , m_requiredPrefix(extractRequiredPrefix(regex.getExpr()))
   {
   }
 
@@ -132,6 +151,12 @@ public:
   {
   }
 
+  virtual Name
+  getRequiredPrefix() const
+  {
+    return m_requiredPrefix;
+  }
+
 protected:
   virtual bool
   matchName(const Name& name)
@@ -139,8 +164,53 @@ protected:
     return m_regex.match(name);
   }
 
+private:
+  /**
+   * @brief Extract the literal components at the beginning of an anchored regex
+   *
+   * Extraction stops at the first component that is not a plain literal or that is
+   * followed by a repetition, so that the result is a prefix of every matched name.
+   */
+  static Name
+  extractRequiredPrefix(const std::string& expr)
+  {
+    Name prefix;
+    if (expr.empty() || expr[0] != '^')
+      return prefix;
+
+    size_t pos = 1;
+    while (pos < expr.size() && expr[pos] == '<') {
+      size_t end = expr.find('>', pos);
+      if (end == std::string::npos)
+        break;
+
+      std::string literal = expr.substr(pos + 1, end - pos - 1);
+      if (literal.empty() || literal.find_first_of(".[]{}()\\*+?|^$<") != std::string::npos)
+        break;
+
+      if (end + 1 < expr.size() && std::string("*+?{").find(expr[end + 1]) != std::string::npos)
+        break;
+
+      try {
+        name::Component component = name::Component::fromEscapedString(literal);
+        // the component matcher compares against the URI representation
+        if (component.toUri() != literal)
+          break;
+        prefix.append(component);
+      }
+      catch (const name::Component::Error&) {
+        break;
+      }
+
+      pos = end + 1;
+    }
+
+    return prefix;
+  }
+
 private:
   Regex m_regex;
+  Name m_requiredPrefix;
 };
 
 class FilterFactory
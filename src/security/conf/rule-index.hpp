@@ -0,0 +1,145 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2013-2017 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#ifndef NDN_SECURITY_CONF_RULE_INDEX_HPP
+#define NDN_SECURITY_CONF_RULE_INDEX_HPP
+
+#include "rule.hpp"
+
+#include <map>
+
+namespace ndn {
+namespace security {
+namespace conf {
+
+/**
+ * @brief Index of ValidatorConfig rules by the name prefix required by their filters
+ *
+ * Rules are kept in a name prefix trie, each rule being attached to the node of
+ * Rule::getRequiredPrefix().  A lookup walks the trie along the packet name and only
+ * evaluates the filters of rules attached to the visited nodes.  Candidates are evaluated
+ * in insertion order, so the first matching rule is the same as with a linear scan.
+ */
+template<class Packet>
+class RuleIndex
+{
+public:
+  typedef Rule<Packet> RuleType;
+
+  /**
+   * @brief Append a rule to the index
+   *
+   * Rules must be inserted in the order in which they appear in the configuration.
+   */
+  void
+  insert(const shared_ptr<RuleType>& rule)
+  {
+    Node* node = &m_root;
+    for (const name::Component& component : rule->getRequiredPrefix()) {
+      unique_ptr<Node>& child = node->children[component];
+      if (child == nullptr)
+        child.reset(new Node);
+      node = child.get();
+    }
+
+    node->rules.push_back(m_rules.size());
+    m_rules.push_back(rule);
+  }
+
+  void
+  clear()
+  {
+    m_root = Node();
+    m_rules.clear();
+  }
+
+  size_t
+  size() const
+  {
+    return m_rules.size();
+  }
+
+  bool
+  empty() const
+  {
+    return m_rules.empty();
+  }
+
+  /**
+   * @brief Find the first rule matching @p packet
+   * @return the matched rule, or nullptr if no rule matches
+   */
+  shared_ptr<RuleType>
+  findMatch(const Packet& packet) const
+  {
+    const Name& name = getMatchName(packet);
+
+    std::vector<size_t> candidates(m_root.rules);
+    const Node* node = &m_root;
+    for (const name::Component& component : name) {
+      auto it = node->children.find(component);
+      if (it == node->children.end())
+        break;
+      node = it->second.get();
+      candidates.insert(candidates.end(), node->rules.begin(), node->rules.end());
+    }
+
+    std::sort(candidates.begin(), candidates.end());
+    for (size_t i : candidates) {
+      if (m_rules[i]->match(packet))
+        return m_rules[i];
+    }
+
+    return nullptr;
+  }
+
+private:
+  static const Name&
+  getMatchName(const Data& data)
+  {
+    return data.getName();
+  }
+
+  static Name
+  getMatchName(const Interest& interest)
+  {
+    // filters match command Interests on the name without signature components
+    if (interest.getName().size() < command_interest::MIN_SIZE)
+      return Name();
+    return interest.getName().getPrefix(-command_interest::MIN_SIZE);
+  }
+
+private:
+  struct Node
+  {
+    std::map<name::Component, unique_ptr<Node>> children;
+    std::vector<size_t> rules; ///< positions in m_rules, in increasing order
+  };
+
+  Node m_root;
+  std::vector<shared_ptr<RuleType>> m_rules;
+};
+
+} // namespace conf
+} // namespace security
+} // namespace ndn
+
+#endif // NDN_SECURITY_CONF_RULE_INDEX_HPP
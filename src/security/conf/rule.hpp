@@ -82,6 +82,23 @@ public:
     return true;
   }
 
+  /**
+   * @brief Get the name prefix that every packet matched by this rule starts with
+   *
+   * All filters must match, so the longest of the filters' required prefixes is used.
+   */
+  Name
+  getRequiredPrefix() const
+  {
+    Name prefix;
+    for (const auto& filter : m_filters) {
+      Name filterPrefix = filter->getRequiredPrefix();
+      if (filterPrefix.size() > prefix.size())
+        prefix = filterPrefix;
+    }
+    return prefix;
+  }
+
   /**
    * @brief check if packet satisfies certain condition
    *
@@ -63,6 +63,35 @@ EvpPkeyCtx::~EvpPkeyCtx()
   EVP_PKEY_CTX_free(m_ctx);
 }
 
+EvpMdCtx::EvpMdCtx()
+#if OPENSSL_VERSION_NUMBER < 0x1010000fL
+  : m_ctx(EVP_MD_CTX_create())
+#else
+  : m_ctx(EVP_MD_CTX_new())
+#endif // OPENSSL_VERSION_NUMBER < 0x1010000fL
+{
+  BOOST_ASSERT(m_ctx != nullptr);
+}
+
+EvpMdCtx::~EvpMdCtx()
+{
+#if OPENSSL_VERSION_NUMBER < 0x1010000fL
+  EVP_MD_CTX_destroy(m_ctx);
+#else
+  EVP_MD_CTX_free(m_ctx);
+#endif // OPENSSL_VERSION_NUMBER < 0x1010000fL
+}
+
+void
+EvpMdCtx::reset()
+{
+#if OPENSSL_VERSION_NUMBER < 0x1010000fL
+  EVP_MD_CTX_cleanup(m_ctx);
+#else
+  EVP_MD_CTX_reset(m_ctx);
+#endif // OPENSSL_VERSION_NUMBER < 0x1010000fL
+}
+
 #if OPENSSL_VERSION_NUMBER < 0x1010000fL
 Bio::Bio(BIO_METHOD* method)
 #else
@@ -76,6 +76,29 @@ private:
   EVP_PKEY_CTX* m_ctx;
 };
 
+class EvpMdCtx
+{
+public:
+  EvpMdCtx();
+
+  ~EvpMdCtx();
+
+  EVP_MD_CTX*
+  get() const
+  {
+    return m_ctx;
+  }
+
+  /**
+   * @brief Release resources held by the context, so that it can be initialized again
+   */
+  void
+  reset();
+
+private:
+  EVP_MD_CTX* m_ctx;
+};
+
 class Bio
 {
 public:
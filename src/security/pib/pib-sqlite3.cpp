@@ -191,7 +191,12 @@ CREATE TRIGGER IF NOT EXISTS
   END;
 )SQL";
 
+const time::nanoseconds PibSqlite3::DEFAULT_CACHE_VALIDATION_INTERVAL = time::seconds(1);
+
 PibSqlite3::PibSqlite3(const std::string& location)
+  : m_dataVersion(0)
+  , m_lastValidation(time::steady_clock::TimePoint::min())
+  , m_cacheValidationInterval(DEFAULT_CACHE_VALIDATION_INTERVAL)
 {
   // Determine the path of PIB DB
   boost::filesystem::path dbDir;
@@ -228,6 +233,12 @@ PibSqlite3::PibSqlite3(const std::string& location)
   // enable foreign key
   sqlite3_exec(m_database, "PRAGMA foreign_keys=ON", nullptr, nullptr, nullptr);
 
+#ifndef NDN_CXX_DISABLE_SQLITE3_FS_LOCKING
+  // enable write-ahead logging, so that readers do not block on other processes' writes;
+  // WAL requires shared memory, which is not available with the unix-dotfile VFS
+  sqlite3_exec(m_database, "PRAGMA journal_mode=WAL", nullptr, nullptr, nullptr);
+#endif // NDN_CXX_DISABLE_SQLITE3_FS_LOCKING
+
   // initialize PIB tables
   char* errorMessage = nullptr;
   result = sqlite3_exec(m_database, INITIALIZATION.c_str(), nullptr, nullptr, &errorMessage);
@@ -235,10 +246,14 @@ PibSqlite3::PibSqlite3(const std::string& location)
     sqlite3_free(errorMessage);
     BOOST_THROW_EXCEPTION(PibImpl::Error("PIB DB cannot be initialized"));
   }
+
+  m_statements.reset(new util::Sqlite3StatementCache(m_database));
 }
 
 PibSqlite3::~PibSqlite3()
 {
+  // prepared statements must be finalized before closing the database
+  m_statements.reset();
   sqlite3_close(m_database);
 }
 
@@ -249,16 +264,42 @@ PibSqlite3::getScheme()
   return scheme;
 }
 
+void
+PibSqlite3::validateCache() const
+{
+  auto now = time::steady_clock::now();
+  if (now < m_lastValidation + m_cacheValidationInterval)
+    return;
+  m_lastValidation = now;
+
+  Sqlite3Statement statement(*m_statements, "PRAGMA data_version");
+  if (statement.step() != SQLITE_ROW)
+    return;
+
+  // data_version changes only when another connection commits a modification
+  int dataVersion = statement.getInt(0);
+  if (dataVersion != m_dataVersion) {
+    m_cache = Cache();
+    m_dataVersion = dataVersion;
+  }
+}
+
+void
+PibSqlite3::invalidateCache()
+{
+  m_cache = Cache();
+}
+
 void
 PibSqlite3::setTpmLocator(const std::string& tpmLocator)
 {
-  Sqlite3Statement statement(m_database, "UPDATE tpmInfo SET tpm_locator=?");
+  Sqlite3Statement statement(*m_statements, "UPDATE tpmInfo SET tpm_locator=?");
   statement.bind(1, tpmLocator, SQLITE_TRANSIENT);
   statement.step();
 
   if (sqlite3_changes(m_database) == 0) {
     // no row is updated, tpm_locator does not exist, insert it directly
-    Sqlite3Statement insertStatement(m_database, "INSERT INTO tpmInfo (tpm_locator) values (?)");
+    Sqlite3Statement insertStatement(*m_statements, "INSERT INTO tpmInfo (tpm_locator) values (?)");
     insertStatement.bind(1, tpmLocator, SQLITE_TRANSIENT);
     insertStatement.step();
   }
@@ -267,7 +308,7 @@ PibSqlite3::setTpmLocator(const std::string& tpmLocator)
 std::string
 PibSqlite3::getTpmLocator() const
 {
-  Sqlite3Statement statement(m_database, "SELECT tpm_locator FROM tpmInfo");
+  Sqlite3Statement statement(*m_statements, "SELECT tpm_locator FROM tpmInfo");
   int res = statement.step();
   if (res == SQLITE_ROW)
     return statement.getString(0);
@@ -275,21 +316,34 @@ PibSqlite3::getTpmLocator() const
     return "";
 }
 
+void
+PibSqlite3::loadIdentities() const
+{
+  validateCache();
+  if (m_cache.hasIdentities)
+    return;
+
+  Sqlite3Statement statement(*m_statements, "SELECT identity FROM identities");
+  while (statement.step() == SQLITE_ROW)
+    m_cache.identities.insert(Name(statement.getBlock(0)));
+  m_cache.hasIdentities = true;
+}
+
 bool
 PibSqlite3::hasIdentity(const Name& identity) const
 {
-  Sqlite3Statement statement(m_database, "SELECT id FROM identities WHERE identity=?");
-  statement.bind(1, identity.wireEncode(), SQLITE_TRANSIENT);
-  return (statement.step() == SQLITE_ROW);
+  loadIdentities();
+  return m_cache.identities.count(identity) > 0;
 }
 
 void
 PibSqlite3::addIdentity(const Name& identity)
 {
   if (!hasIdentity(identity)) {
-    Sqlite3Statement statement(m_database, "INSERT INTO identities (identity) values (?)");
+    Sqlite3Statement statement(*m_statements, "INSERT INTO identities (identity) values (?)");
     statement.bind(1, identity.wireEncode(), SQLITE_TRANSIENT);
     statement.step();
+    invalidateCache();
   }
 
   if (!hasDefaultIdentity()) {
@@ -300,63 +354,85 @@ PibSqlite3::addIdentity(const Name& identity)
 void
 PibSqlite3::removeIdentity(const Name& identity)
 {
-  Sqlite3Statement statement(m_database, "DELETE FROM identities WHERE identity=?");
+  Sqlite3Statement statement(*m_statements, "DELETE FROM identities WHERE identity=?");
   statement.bind(1, identity.wireEncode(), SQLITE_TRANSIENT);
   statement.step();
+  invalidateCache();
 }
 
 void
 PibSqlite3::clearIdentities()
 {
-  Sqlite3Statement statement(m_database, "DELETE FROM identities");
+  Sqlite3Statement statement(*m_statements, "DELETE FROM identities");
   statement.step();
+  invalidateCache();
 }
 
 std::set<Name>
 PibSqlite3::getIdentities() const
 {
-  std::set<Name> identities;
-  Sqlite3Statement statement(m_database, "SELECT identity FROM identities");
-
-  while (statement.step() == SQLITE_ROW)
-    identities.insert(Name(statement.getBlock(0)));
-
-  return identities;
+  loadIdentities();
+  return m_cache.identities;
 }
 
 void
 PibSqlite3::setDefaultIdentity(const Name& identityName)
 {
-  Sqlite3Statement statement(m_database, "UPDATE identities SET is_default=1 WHERE identity=?");
+  Sqlite3Statement statement(*m_statements, "UPDATE identities SET is_default=1 WHERE identity=?");
   statement.bind(1, identityName.wireEncode(), SQLITE_TRANSIENT);
   statement.step();
+  invalidateCache();
+}
+
+const Name*
+PibSqlite3::findDefaultIdentity() const
+{
+  validateCache();
+  if (!m_cache.hasDefaultIdentity) {
+    Sqlite3Statement statement(*m_statements, "SELECT identity FROM identities WHERE is_default=1");
+    if (statement.step() == SQLITE_ROW)
+      m_cache.defaultIdentity = Name(statement.getBlock(0));
+    m_cache.hasDefaultIdentity = true;
+  }
+  return m_cache.defaultIdentity ? &*m_cache.defaultIdentity : nullptr;
 }
 
 Name
 PibSqlite3::getDefaultIdentity() const
 {
-  Sqlite3Statement statement(m_database, "SELECT identity FROM identities WHERE is_default=1");
-
-  if (statement.step() == SQLITE_ROW)
-    return Name(statement.getBlock(0));
-  else
+  const Name* identity = findDefaultIdentity();
+  if (identity == nullptr)
     BOOST_THROW_EXCEPTION(Pib::Error("No default identity"));
+  return *identity;
 }
 
 bool
 PibSqlite3::hasDefaultIdentity() const
 {
-  Sqlite3Statement statement(m_database, "SELECT identity FROM identities WHERE is_default=1");
-  return (statement.step() == SQLITE_ROW);
+  return findDefaultIdentity() != nullptr;
+}
+
+const Buffer*
+PibSqlite3::findKeyBits(const Name& keyName) const
+{
+  validateCache();
+  auto it = m_cache.keyBits.find(keyName);
+  if (it == m_cache.keyBits.end()) {
+    Sqlite3Statement statement(*m_statements, "SELECT key_bits FROM keys WHERE key_name=?");
+    statement.bind(1, keyName.wireEncode(), SQLITE_TRANSIENT);
+    optional<Buffer> keyBits;
+    if (statement.step() == SQLITE_ROW)
+      keyBits = Buffer(statement.getBlob(0), statement.getSize(0));
+
+    it = m_cache.keyBits.emplace(keyName, std::move(keyBits)).first;
+  }
+  return it->second ? &*it->second : nullptr;
 }
 
 bool
 PibSqlite3::hasKey(const Name& keyName) const
 {
-  Sqlite3Statement statement(m_database, "SELECT id FROM keys WHERE key_name=?");
-  statement.bind(1, keyName.wireEncode(), SQLITE_TRANSIENT);
-
-  return (statement.step() == SQLITE_ROW);
+  return findKeyBits(keyName) != nullptr;
 }
 
 void
@@ -367,7 +443,7 @@ PibSqlite3::addKey(const Name& identity, const Name& keyName,
   addIdentity(identity);
 
   if (!hasKey(keyName)) {
-    Sqlite3Statement statement(m_database,
+    Sqlite3Statement statement(*m_statements,
                                "INSERT INTO keys (identity_id, key_name, key_bits) "
                                "VALUES ((SELECT id FROM identities WHERE identity=?), ?, ?)");
     statement.bind(1, identity.wireEncode(), SQLITE_TRANSIENT);
@@ -376,12 +452,13 @@ PibSqlite3::addKey(const Name& identity, const Name& keyName,
     statement.step();
   }
   else {
-    Sqlite3Statement statement(m_database,
+    Sqlite3Statement statement(*m_statements,
                                "UPDATE keys SET key_bits=? WHERE key_name=?");
     statement.bind(1, key, keyLen, SQLITE_STATIC);
     statement.bind(2, keyName.wireEncode(), SQLITE_TRANSIENT);
     statement.step();
   }
+  invalidateCache();
 
   if (!hasDefaultKeyOfIdentity(identity)) {
     setDefaultKeyOfIdentity(identity, keyName);
@@ -391,29 +468,32 @@ PibSqlite3::addKey(const Name& identity, const Name& keyName,
 void
 PibSqlite3::removeKey(const Name& keyName)
 {
-  Sqlite3Statement statement(m_database, "DELETE FROM keys WHERE key_name=?");
+  Sqlite3Statement statement(*m_statements, "DELETE FROM keys WHERE key_name=?");
   statement.bind(1, keyName.wireEncode(), SQLITE_TRANSIENT);
   statement.step();
+  invalidateCache();
 }
 
 Buffer
 PibSqlite3::getKeyBits(const Name& keyName) const
 {
-  Sqlite3Statement statement(m_database, "SELECT key_bits FROM keys WHERE key_name=?");
-  statement.bind(1, keyName.wireEncode(), SQLITE_TRANSIENT);
-
-  if (statement.step() == SQLITE_ROW)
-    return Buffer(statement.getBlob(0), statement.getSize(0));
-  else
+  const Buffer* keyBits = findKeyBits(keyName);
+  if (keyBits == nullptr)
     BOOST_THROW_EXCEPTION(Pib::Error("Key `" + keyName.toUri() + "` does not exist"));
+  return *keyBits;
 }
 
 std::set<Name>
 PibSqlite3::getKeysOfIdentity(const Name& identity) const
 {
+  validateCache();
+  auto it = m_cache.keysOfIdentity.find(identity);
+  if (it != m_cache.keysOfIdentity.end())
+    return it->second;
+
   std::set<Name> keyNames;
 
-  Sqlite3Statement statement(m_database,
+  Sqlite3Statement statement(*m_statements,
                              "SELECT key_name "
                              "FROM keys JOIN identities ON keys.identity_id=identities.id "
                              "WHERE identities.identity=?");
@@ -423,6 +503,7 @@ PibSqlite3::getKeysOfIdentity(const Name& identity) const
     keyNames.insert(Name(statement.getBlock(0)));
   }
 
+  m_cache.keysOfIdentity[identity] = keyNames;
   return keyNames;
 }
 
@@ -433,9 +514,30 @@ PibSqlite3::setDefaultKeyOfIdentity(const Name& identity, const Name& keyName)
     BOOST_THROW_EXCEPTION(Pib::Error("Key `" + keyName.toUri() + "` does not exist"));
   }
 
-  Sqlite3Statement statement(m_database, "UPDATE keys SET is_default=1 WHERE key_name=?");
+  Sqlite3Statement statement(*m_statements, "UPDATE keys SET is_default=1 WHERE key_name=?");
   statement.bind(1, keyName.wireEncode(), SQLITE_TRANSIENT);
   statement.step();
+  invalidateCache();
+}
+
+const Name*
+PibSqlite3::findDefaultKeyOfIdentity(const Name& identity) const
+{
+  validateCache();
+  auto it = m_cache.defaultKeyOfIdentity.find(identity);
+  if (it == m_cache.defaultKeyOfIdentity.end()) {
+    Sqlite3Statement statement(*m_statements,
+                               "SELECT key_name "
+                               "FROM keys JOIN identities ON keys.identity_id=identities.id "
+                               "WHERE identities.identity=? AND keys.is_default=1");
+    statement.bind(1, identity.wireEncode(), SQLITE_TRANSIENT);
+    optional<Name> keyName;
+    if (statement.step() == SQLITE_ROW)
+      keyName = Name(statement.getBlock(0));
+
+    it = m_cache.defaultKeyOfIdentity.emplace(identity, std::move(keyName)).first;
+  }
+  return it->second ? &*it->second : nullptr;
 }
 
 Name
@@ -445,37 +547,40 @@ PibSqlite3::getDefaultKeyOfIdentity(const Name& identity) const
     BOOST_THROW_EXCEPTION(Pib::Error("Identity `" + identity.toUri() + "` does not exist"));
   }
 
-  Sqlite3Statement statement(m_database,
-                             "SELECT key_name "
-                             "FROM keys JOIN identities ON keys.identity_id=identities.id "
-                             "WHERE identities.identity=? AND keys.is_default=1");
-  statement.bind(1, identity.wireEncode(), SQLITE_TRANSIENT);
-
-  if (statement.step() == SQLITE_ROW) {
-    return Name(statement.getBlock(0));
-  }
-  else
+  const Name* keyName = findDefaultKeyOfIdentity(identity);
+  if (keyName == nullptr)
     BOOST_THROW_EXCEPTION(Pib::Error("No default key for identity `" + identity.toUri() + "`"));
+  return *keyName;
 }
 
 bool
 PibSqlite3::hasDefaultKeyOfIdentity(const Name& identity) const
 {
-  Sqlite3Statement statement(m_database,
-                             "SELECT key_name "
-                             "FROM keys JOIN identities ON keys.identity_id=identities.id "
-                             "WHERE identities.identity=? AND keys.is_default=1");
-  statement.bind(1, identity.wireEncode(), SQLITE_TRANSIENT);
+  return findDefaultKeyOfIdentity(identity) != nullptr;
+}
 
-  return (statement.step() == SQLITE_ROW);
+const v2::Certificate*
+PibSqlite3::findCertificate(const Name& certName) const
+{
+  validateCache();
+  auto it = m_cache.certificates.find(certName);
+  if (it == m_cache.certificates.end()) {
+    Sqlite3Statement statement(*m_statements,
+                               "SELECT certificate_data FROM certificates WHERE certificate_name=?");
+    statement.bind(1, certName.wireEncode(), SQLITE_TRANSIENT);
+    optional<v2::Certificate> certificate;
+    if (statement.step() == SQLITE_ROW)
+      certificate = v2::Certificate(statement.getBlock(0));
+
+    it = m_cache.certificates.emplace(certName, std::move(certificate)).first;
+  }
+  return it->second ? &*it->second : nullptr;
 }
 
 bool
 PibSqlite3::hasCertificate(const Name& certName) const
 {
-  Sqlite3Statement statement(m_database, "SELECT id FROM certificates WHERE certificate_name=?");
-  statement.bind(1, certName.wireEncode(), SQLITE_TRANSIENT);
-  return (statement.step() == SQLITE_ROW);
+  return findCertificate(certName) != nullptr;
 }
 
 void
@@ -486,7 +591,7 @@ PibSqlite3::addCertificate(const v2::Certificate& certificate)
   addKey(certificate.getIdentity(), certificate.getKeyName(), content.value(), content.value_size());
 
   if (!hasCertificate(certificate.getName())) {
-    Sqlite3Statement statement(m_database,
+    Sqlite3Statement statement(*m_statements,
                                "INSERT INTO certificates "
                                "(key_id, certificate_name, certificate_data) "
                                "VALUES ((SELECT id FROM keys WHERE key_name=?), ?, ?)");
@@ -496,12 +601,13 @@ PibSqlite3::addCertificate(const v2::Certificate& certificate)
     statement.step();
   }
   else {
-    Sqlite3Statement statement(m_database,
+    Sqlite3Statement statement(*m_statements,
                                "UPDATE certificates SET certificate_data=? WHERE certificate_name=?");
     statement.bind(1, certificate.wireEncode(), SQLITE_STATIC);
     statement.bind(2, certificate.getName().wireEncode(), SQLITE_TRANSIENT);
     statement.step();
   }
+  invalidateCache();
 
   if (!hasDefaultCertificateOfKey(certificate.getKeyName())) {
     setDefaultCertificateOfKey(certificate.getKeyName(), certificate.getName());
@@ -511,30 +617,32 @@ PibSqlite3::addCertificate(const v2::Certificate& certificate)
 void
 PibSqlite3::removeCertificate(const Name& certName)
 {
-  Sqlite3Statement statement(m_database, "DELETE FROM certificates WHERE certificate_name=?");
+  Sqlite3Statement statement(*m_statements, "DELETE FROM certificates WHERE certificate_name=?");
   statement.bind(1, certName.wireEncode(), SQLITE_TRANSIENT);
   statement.step();
+  invalidateCache();
 }
 
 v2::Certificate
 PibSqlite3::getCertificate(const Name& certName) const
 {
-  Sqlite3Statement statement(m_database,
-                             "SELECT certificate_data FROM certificates WHERE certificate_name=?");
-  statement.bind(1, certName.wireEncode(), SQLITE_TRANSIENT);
-
-  if (statement.step() == SQLITE_ROW)
-    return v2::Certificate(statement.getBlock(0));
-  else
+  const v2::Certificate* certificate = findCertificate(certName);
+  if (certificate == nullptr)
     BOOST_THROW_EXCEPTION(Pib::Error("Certificate `" + certName.toUri() + "` does not exit"));
+  return *certificate;
 }
 
 std::set<Name>
 PibSqlite3::getCertificatesOfKey(const Name& keyName) const
 {
+  validateCache();
+  auto it = m_cache.certificatesOfKey.find(keyName);
+  if (it != m_cache.certificatesOfKey.end())
+    return it->second;
+
   std::set<Name> certNames;
 
-  Sqlite3Statement statement(m_database,
+  Sqlite3Statement statement(*m_statements,
                              "SELECT certificate_name "
                              "FROM certificates JOIN keys ON certificates.key_id=keys.id "
                              "WHERE keys.key_name=?");
@@ -543,6 +651,7 @@ PibSqlite3::getCertificatesOfKey(const Name& keyName) const
   while (statement.step() == SQLITE_ROW)
     certNames.insert(Name(statement.getBlock(0)));
 
+  m_cache.certificatesOfKey[keyName] = certNames;
   return certNames;
 }
 
@@ -553,37 +662,46 @@ PibSqlite3::setDefaultCertificateOfKey(const Name& keyName, const Name& certName
     BOOST_THROW_EXCEPTION(Pib::Error("Certificate `" + certName.toUri() + "` does not exist"));
   }
 
-  Sqlite3Statement statement(m_database,
+  Sqlite3Statement statement(*m_statements,
                              "UPDATE certificates SET is_default=1 WHERE certificate_name=?");
   statement.bind(1, certName.wireEncode(), SQLITE_TRANSIENT);
   statement.step();
+  invalidateCache();
+}
+
+const v2::Certificate*
+PibSqlite3::findDefaultCertificateOfKey(const Name& keyName) const
+{
+  validateCache();
+  auto it = m_cache.defaultCertificateOfKey.find(keyName);
+  if (it == m_cache.defaultCertificateOfKey.end()) {
+    Sqlite3Statement statement(*m_statements,
+                               "SELECT certificate_data "
+                               "FROM certificates JOIN keys ON certificates.key_id=keys.id "
+                               "WHERE certificates.is_default=1 AND keys.key_name=?");
+    statement.bind(1, keyName.wireEncode(), SQLITE_TRANSIENT);
+    optional<v2::Certificate> certificate;
+    if (statement.step() == SQLITE_ROW)
+      certificate = v2::Certificate(statement.getBlock(0));
+
+    it = m_cache.defaultCertificateOfKey.emplace(keyName, std::move(certificate)).first;
+  }
+  return it->second ? &*it->second : nullptr;
 }
 
 v2::Certificate
 PibSqlite3::getDefaultCertificateOfKey(const Name& keyName) const
 {
-  Sqlite3Statement statement(m_database,
-                             "SELECT certificate_data "
-                             "FROM certificates JOIN keys ON certificates.key_id=keys.id "
-                             "WHERE certificates.is_default=1 AND keys.key_name=?");
-  statement.bind(1, keyName.wireEncode(), SQLITE_TRANSIENT);
-
-  if (statement.step() == SQLITE_ROW)
-    return v2::Certificate(statement.getBlock(0));
-  else
+  const v2::Certificate* certificate = findDefaultCertificateOfKey(keyName);
+  if (certificate == nullptr)
     BOOST_THROW_EXCEPTION(Pib::Error("No default certificate for key `" + keyName.toUri() + "`"));
+  return *certificate;
 }
 
 bool
 PibSqlite3::hasDefaultCertificateOfKey(const Name& keyName) const
 {
-  Sqlite3Statement statement(m_database,
-                             "SELECT certificate_data "
-                             "FROM certificates JOIN keys ON certificates.key_id=keys.id "
-                             "WHERE certificates.is_default=1 AND keys.key_name=?");
-  statement.bind(1, keyName.wireEncode(), SQLITE_TRANSIENT);
-
-  return (statement.step() == SQLITE_ROW);
+  return findDefaultCertificateOfKey(keyName) != nullptr;
 }
 
 } // namespace pib
@@ -23,10 +23,18 @@
 #define NDN_SECURITTY_PIB_PIB_SQLITE3_HPP
 
 #include "pib-impl.hpp"
+#include "../../util/time.hpp"
+
+#include <map>
 
 struct sqlite3;
 
 namespace ndn {
+
+namespace util {
+class Sqlite3StatementCache;
+} // namespace util
+
 namespace security {
 namespace pib {
 
@@ -35,6 +43,15 @@ namespace pib {
  *
  * All the contents in Pib are stored in a SQLite3 database file.
  * This backend provides more persistent storage than PibMemory.
+ *
+ * The database is opened in write-ahead logging mode, and prepared statements are reused
+ * across calls.  Contents read from the database, including the absence of an entry, are
+ * kept in memory, so that repeated lookups are answered without accessing the database.
+ * The in-memory copy is dropped on every modification made through this instance, and when
+ * SQLite's data_version indicates that another connection (e.g., another process) has
+ * modified the database.  data_version is checked at most once per cache validation
+ * interval, so that modifications made by other connections become visible within that
+ * interval.
  */
 class PibSqlite3 : public PibImpl
 {
@@ -62,6 +79,21 @@ public:
   static const std::string&
   getScheme();
 
+  /**
+   * @brief Set how often the in-memory copy is checked against modifications made by other
+   *        connections to the database
+   *
+   * Lookups answered from the in-memory copy do not access the database in between checks.
+   * Zero checks before every lookup.  The default is DEFAULT_CACHE_VALIDATION_INTERVAL.
+   */
+  void
+  setCacheValidationInterval(time::nanoseconds interval)
+  {
+    m_cacheValidationInterval = interval;
+  }
+
+  static const time::nanoseconds DEFAULT_CACHE_VALIDATION_INTERVAL;
+
 public: // TpmLocator management
   void
   setTpmLocator(const std::string& tpmLocator) final;
@@ -146,8 +178,72 @@ private:
   bool
   hasDefaultCertificateOfKey(const Name& keyName) const;
 
+  /**
+   * @brief Drop the in-memory copy if another connection has modified the database
+   *
+   * Does nothing if the last check was less than the cache validation interval ago.
+   */
+  void
+  validateCache() const;
+
+  /**
+   * @brief Drop the in-memory copy, must be called after every modification
+   */
+  void
+  invalidateCache();
+
+  /**
+   * @brief Load the set of identities into the in-memory copy if not yet loaded
+   */
+  void
+  loadIdentities() const;
+
+  // The following methods return nullptr if the entry does not exist in the database;
+  // the absence is also kept in the in-memory copy.
+  // Returned pointers are valid until the in-memory copy is dropped.
+
+  const Name*
+  findDefaultIdentity() const;
+
+  const Buffer*
+  findKeyBits(const Name& keyName) const;
+
+  const Name*
+  findDefaultKeyOfIdentity(const Name& identity) const;
+
+  const v2::Certificate*
+  findCertificate(const Name& certName) const;
+
+  const v2::Certificate*
+  findDefaultCertificateOfKey(const Name& keyName) const;
+
 private:
   sqlite3* m_database;
+  unique_ptr<util::Sqlite3StatementCache> m_statements;
+
+  /**
+   * @brief In-memory copy of PIB contents read from the database
+   *
+   * In the maps, nullopt records that the entry does not exist in the database.
+   */
+  struct Cache
+  {
+    bool hasIdentities = false; ///< whether identities holds all identities in the database
+    std::set<Name> identities;
+    bool hasDefaultIdentity = false; ///< whether defaultIdentity has been read
+    optional<Name> defaultIdentity;
+    std::map<Name, optional<Buffer>> keyBits;
+    std::map<Name, std::set<Name>> keysOfIdentity;
+    std::map<Name, optional<Name>> defaultKeyOfIdentity;
+    std::map<Name, optional<v2::Certificate>> certificates;
+    std::map<Name, std::set<Name>> certificatesOfKey;
+    std::map<Name, optional<v2::Certificate>> defaultCertificateOfKey;
+  };
+
+  mutable Cache m_cache;
+  mutable int m_dataVersion;
+  mutable time::steady_clock::TimePoint m_lastValidation;
+  time::nanoseconds m_cacheValidationInterval;
 };
 
 } // namespace pib
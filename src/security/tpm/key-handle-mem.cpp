@@ -20,8 +20,7 @@
  */
 
 #include "key-handle-mem.hpp"
-#include "../../encoding/buffer-stream.hpp"
-#include "../transform.hpp"
+#include "../transform/fused-pipeline.hpp"
 #include "../transform/private-key.hpp"
 
 namespace ndn {
@@ -41,11 +40,12 @@ KeyHandleMem::doSign(DigestAlgorithm digestAlgorithm, const uint8_t* buf, size_t
 {
   switch (digestAlgorithm) {
     case DigestAlgorithm::SHA256: {
-      using namespace transform;
-
-      OBufferStream sigOs;
-      bufferSource(buf, size) >> signerFilter(digestAlgorithm, *m_key) >> streamSink(sigOs);
-      return sigOs.buf();
+      // sign directly into the returned buffer
+      transform::fused::Signer signer(digestAlgorithm, *m_key);
+      auto sig = make_shared<Buffer>(signer.getMaxSignatureSize());
+      signer.update(buf, size);
+      sig->resize(signer.finalize(sig->buf(), sig->size()));
+      return sig;
     }
     default:
       return nullptr;
@@ -40,4 +40,6 @@
 #include "transform/signer-filter.hpp"
 #include "transform/verifier-filter.hpp"
 
+#include "transform/fused-pipeline.hpp"
+
 #endif // NDN_CXX_SECURITY_TRANSFORM_HPP
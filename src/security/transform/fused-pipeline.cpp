@@ -0,0 +1,146 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2013-2017 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#include "fused-pipeline.hpp"
+#include "private-key.hpp"
+#include "public-key.hpp"
+#include "../detail/openssl-helper.hpp"
+
+#include <boost/lexical_cast.hpp>
+
+namespace ndn {
+namespace security {
+namespace transform {
+namespace fused {
+
+/// index of the stage in a pipeline, for error reporting
+static const size_t STAGE_INDEX = 1;
+
+static const EVP_MD*
+getEvpMd(DigestAlgorithm algo)
+{
+  const EVP_MD* md = detail::toDigestEvpMd(algo);
+  if (md == nullptr) {
+    BOOST_THROW_EXCEPTION(Error(STAGE_INDEX, "Unsupported digest algorithm " +
+                                boost::lexical_cast<std::string>(algo)));
+  }
+  return md;
+}
+
+Digest::Digest(DigestAlgorithm algo)
+  : m_ctx(make_unique<detail::EvpMdCtx>())
+{
+  if (EVP_DigestInit_ex(m_ctx->get(), getEvpMd(algo), nullptr) != 1)
+    BOOST_THROW_EXCEPTION(Error(STAGE_INDEX, "Cannot initialize digest"));
+}
+
+Digest::~Digest() = default;
+
+void
+Digest::update(const uint8_t* buf, size_t size)
+{
+  if (EVP_DigestUpdate(m_ctx->get(), buf, size) != 1)
+    BOOST_THROW_EXCEPTION(Error(STAGE_INDEX, "Failed to accept more input"));
+}
+
+size_t
+Digest::finalize(uint8_t* out, size_t capacity)
+{
+  if (capacity < static_cast<size_t>(EVP_MD_CTX_size(m_ctx->get())))
+    BOOST_THROW_EXCEPTION(Error(STAGE_INDEX, "Output buffer is too small"));
+
+  unsigned int mdLen = 0;
+  if (EVP_DigestFinal_ex(m_ctx->get(), out, &mdLen) != 1)
+    BOOST_THROW_EXCEPTION(Error(STAGE_INDEX, "Failed to compute digest"));
+  return mdLen;
+}
+
+Signer::Signer(DigestAlgorithm algo, const PrivateKey& key)
+  : m_ctx(make_unique<detail::EvpMdCtx>())
+  , m_key(key)
+{
+  EVP_PKEY* pkey = reinterpret_cast<EVP_PKEY*>(key.getEvpPkey());
+  if (pkey == nullptr ||
+      EVP_DigestSignInit(m_ctx->get(), nullptr, getEvpMd(algo), nullptr, pkey) != 1)
+    BOOST_THROW_EXCEPTION(Error(STAGE_INDEX, "Cannot initialize signing"));
+}
+
+Signer::~Signer() = default;
+
+void
+Signer::update(const uint8_t* buf, size_t size)
+{
+  if (EVP_DigestSignUpdate(m_ctx->get(), buf, size) != 1)
+    BOOST_THROW_EXCEPTION(Error(STAGE_INDEX, "Failed to accept more input"));
+}
+
+size_t
+Signer::finalize(uint8_t* out, size_t capacity)
+{
+  if (capacity < getMaxSignatureSize())
+    BOOST_THROW_EXCEPTION(Error(STAGE_INDEX, "Output buffer is too small"));
+
+  size_t sigLen = capacity;
+  if (EVP_DigestSignFinal(m_ctx->get(), out, &sigLen) != 1)
+    BOOST_THROW_EXCEPTION(Error(STAGE_INDEX, "Failed to sign"));
+  return sigLen;
+}
+
+size_t
+Signer::getMaxSignatureSize() const
+{
+  return EVP_PKEY_size(reinterpret_cast<EVP_PKEY*>(m_key.getEvpPkey()));
+}
+
+Verifier::Verifier(DigestAlgorithm algo, const PublicKey& key, const uint8_t* sig, size_t sigLen)
+  : m_ctx(make_unique<detail::EvpMdCtx>())
+  , m_sig(sig)
+  , m_sigLen(sigLen)
+{
+  EVP_PKEY* pkey = reinterpret_cast<EVP_PKEY*>(key.getEvpPkey());
+  if (pkey == nullptr ||
+      EVP_DigestVerifyInit(m_ctx->get(), nullptr, getEvpMd(algo), nullptr, pkey) != 1)
+    BOOST_THROW_EXCEPTION(Error(STAGE_INDEX, "Cannot initialize verification"));
+}
+
+Verifier::~Verifier() = default;
+
+void
+Verifier::update(const uint8_t* buf, size_t size)
+{
+  if (EVP_DigestVerifyUpdate(m_ctx->get(), buf, size) != 1)
+    BOOST_THROW_EXCEPTION(Error(STAGE_INDEX, "Failed to accept more input"));
+}
+
+bool
+Verifier::finalize()
+{
+  // OpenSSL < 1.0.2 takes a non-const signature buffer, but does not modify it
+  int res = EVP_DigestVerifyFinal(m_ctx->get(), const_cast<uint8_t*>(m_sig), m_sigLen);
+  if (res < 0)
+    BOOST_THROW_EXCEPTION(Error(STAGE_INDEX, "Verification error"));
+  return res != 0;
+}
+
+} // namespace fused
+} // namespace transform
+} // namespace security
+} // namespace ndn
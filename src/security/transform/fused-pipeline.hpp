@@ -0,0 +1,270 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2013-2017 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#ifndef NDN_CXX_SECURITY_TRANSFORM_FUSED_PIPELINE_HPP
+#define NDN_CXX_SECURITY_TRANSFORM_FUSED_PIPELINE_HPP
+
+#include "transform-base.hpp"
+#include "../security-common.hpp"
+
+namespace ndn {
+namespace security {
+
+namespace detail {
+class EvpMdCtx;
+} // namespace detail
+
+namespace transform {
+
+class PublicKey;
+class PrivateKey;
+
+/**
+ * @brief Statically composed transformation pipelines
+ *
+ * A fused pipeline combines one transformation stage and one sink into a single object
+ * whose type is known at compile time.  Unlike a chain built with operator>>, the stage and
+ * the sink are held by value rather than allocated as separate modules, no intermediate
+ * output buffer is used, and the final output is written directly into memory provided by
+ * the caller.  Each stage still allocates one OpenSSL digest context on construction:
+ *
+ *   uint8_t digest[32];
+ *   size_t digestLen = 0;
+ *   fused::DigestPipeline pipeline(fused::BufferSink(digest, sizeof(digest), digestLen),
+ *                                  DigestAlgorithm::SHA256);
+ *   pipeline.write(buf, size);
+ *   pipeline.end();
+ *
+ * A stage must provide update(buf, size), which consumes input, and finalize(...), which is
+ * invoked once by the sink.  Errors are reported with transform::Error, where the index of
+ * the stage is 1, as in a `source >> filter >> sink` chain.
+ */
+namespace fused {
+
+/**
+ * @brief Stage computing a message digest
+ */
+class Digest : noncopyable
+{
+public:
+  /**
+   * @throw transform::Error @p algo is not supported
+   */
+  explicit
+  Digest(DigestAlgorithm algo);
+
+  ~Digest();
+
+  void
+  update(const uint8_t* buf, size_t size);
+
+  /**
+   * @brief Write the digest into @p out
+   * @return size of the digest
+   * @throw transform::Error @p capacity is smaller than the digest
+   */
+  size_t
+  finalize(uint8_t* out, size_t capacity);
+
+private:
+  const unique_ptr<detail::EvpMdCtx> m_ctx;
+};
+
+/**
+ * @brief Stage computing a signature with a private key
+ */
+class Signer : noncopyable
+{
+public:
+  /**
+   * @throw transform::Error @p algo is not supported or @p key cannot be used for signing
+   */
+  Signer(DigestAlgorithm algo, const PrivateKey& key);
+
+  ~Signer();
+
+  void
+  update(const uint8_t* buf, size_t size);
+
+  /**
+   * @brief Write the signature into @p out
+   * @return size of the signature
+   * @throw transform::Error @p capacity is smaller than getMaxSignatureSize(), or signing failed
+   */
+  size_t
+  finalize(uint8_t* out, size_t capacity);
+
+  /**
+   * @return upper bound of the signature size for the private key
+   */
+  size_t
+  getMaxSignatureSize() const;
+
+private:
+  const unique_ptr<detail::EvpMdCtx> m_ctx;
+  const PrivateKey& m_key;
+};
+
+/**
+ * @brief Stage verifying a signature with a public key
+ */
+class Verifier : noncopyable
+{
+public:
+  /**
+   * @throw transform::Error @p algo is not supported or @p key cannot be used for verification
+   */
+  Verifier(DigestAlgorithm algo, const PublicKey& key, const uint8_t* sig, size_t sigLen);
+
+  ~Verifier();
+
+  void
+  update(const uint8_t* buf, size_t size);
+
+  /**
+   * @return whether the signature is valid
+   * @throw transform::Error the signature cannot be processed, e.g., it is malformed
+   */
+  bool
+  finalize();
+
+private:
+  const unique_ptr<detail::EvpMdCtx> m_ctx;
+  const uint8_t* m_sig;
+  size_t m_sigLen;
+};
+
+/**
+ * @brief Sink storing the output of a stage into a caller-provided buffer
+ */
+class BufferSink
+{
+public:
+  /**
+   * @param buf      output buffer, which must remain valid until the pipeline is ended
+   * @param capacity size of @p buf
+   * @param size     receives the number of bytes written into @p buf
+   */
+  BufferSink(uint8_t* buf, size_t capacity, size_t& size)
+    : m_buf(buf)
+    , m_capacity(capacity)
+    , m_size(size)
+  {
+  }
+
+  template<class Stage>
+  void
+  drain(Stage& stage)
+  {
+    m_size = stage.finalize(m_buf, m_capacity);
+  }
+
+private:
+  uint8_t* m_buf;
+  size_t m_capacity;
+  size_t& m_size;
+};
+
+/**
+ * @brief Sink storing the boolean outcome of a stage
+ */
+class BoolSink
+{
+public:
+  explicit
+  BoolSink(bool& value)
+    : m_value(value)
+  {
+  }
+
+  template<class Stage>
+  void
+  drain(Stage& stage)
+  {
+    m_value = stage.finalize();
+  }
+
+private:
+  bool& m_value;
+};
+
+/**
+ * @brief A stage and a sink fused into one object
+ */
+template<class Stage, class Sink>
+class Pipeline : noncopyable
+{
+public:
+  /**
+   * @brief Create the pipeline, constructing the stage in place from @p stageArgs
+   */
+  template<class... Args>
+  explicit
+  Pipeline(const Sink& sink, Args&&... stageArgs)
+    : m_stage(std::forward<Args>(stageArgs)...)
+    , m_sink(sink)
+    , m_isEnd(false)
+  {
+  }
+
+  /**
+   * @brief Write input into the pipeline
+   * @throw transform::Error the pipeline has been ended, or the stage failed
+   */
+  Pipeline&
+  write(const uint8_t* buf, size_t size)
+  {
+    if (m_isEnd)
+      BOOST_THROW_EXCEPTION(Error(1, "Module is closed, no more input"));
+    m_stage.update(buf, size);
+    return *this;
+  }
+
+  /**
+   * @brief Finalize the stage and store its output into the sink
+   *
+   * Only the first invocation takes effect.
+   */
+  void
+  end()
+  {
+    if (m_isEnd)
+      return;
+    m_isEnd = true;
+    m_sink.drain(m_stage);
+  }
+
+private:
+  Stage m_stage;
+  Sink m_sink;
+  bool m_isEnd;
+};
+
+typedef Pipeline<Digest, BufferSink> DigestPipeline;
+typedef Pipeline<Signer, BufferSink> SignerPipeline;
+typedef Pipeline<Verifier, BoolSink> VerifierPipeline;
+
+} // namespace fused
+} // namespace transform
+} // namespace security
+} // namespace ndn
+
+#endif // NDN_CXX_SECURITY_TRANSFORM_FUSED_PIPELINE_HPP
@@ -32,6 +32,10 @@ class KeyParams;
 namespace security {
 namespace transform {
 
+namespace fused {
+class Signer;
+} // namespace fused
+
 /**
  * @brief Abstraction of private key in crypto transformation
  */
@@ -49,6 +53,7 @@ public:
   };
 
   friend class SignerFilter;
+  friend class fused::Signer;
 
   /**
    * @brief Callback for application to handle password input
@@ -31,6 +31,10 @@ namespace transform {
 
 class VerifierFilter;
 
+namespace fused {
+class Verifier;
+} // namespace fused
+
 /**
  * @brief Abstraction of public key in crypto transformation
  */
@@ -48,6 +52,7 @@ public:
   };
 
   friend class VerifierFilter;
+  friend class fused::Verifier;
 
 public:
   /**
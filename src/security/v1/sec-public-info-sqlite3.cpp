@@ -885,6 +885,98 @@ SecPublicInfoSqlite3::getAllCertificateNamesOfKey(const Name& keyName,
   sqlite3_finalize(stmt);
 }
 
+void
+SecPublicInfoSqlite3::listEntries(const Name& prefix, ListDepth depth,
+                                  const ListEntryCallback& visit)
+{
+  string sql = "SELECT i.identity_name, i.default_identity";
+  if (depth >= LIST_KEYS)
+    sql += ", k.key_identifier, k.default_key";
+  if (depth >= LIST_CERTIFICATE_NAMES)
+    sql += ", c.cert_name, c.default_cert";
+  if (depth >= LIST_CERTIFICATES)
+    sql += ", c.certificate_data";
+
+  sql += " FROM Identity i";
+  if (depth >= LIST_KEYS)
+    sql += " LEFT JOIN Key k ON k.identity_name=i.identity_name";
+  if (depth >= LIST_CERTIFICATE_NAMES)
+    sql += " LEFT JOIN Certificate c"
+           " ON c.identity_name=k.identity_name AND c.key_identifier=k.key_identifier";
+
+  // identity names are stored as URIs, so the identities under a prefix other than "/" are
+  // the prefix itself and the URIs in [prefix + "/", prefix + "0"), as '0' follows '/'
+  if (!prefix.empty())
+    sql += " WHERE i.identity_name=? OR (i.identity_name>=? AND i.identity_name<?)";
+
+  sql += " ORDER BY i.default_identity DESC, i.identity_name";
+  if (depth >= LIST_KEYS)
+    sql += ", k.default_key DESC, k.key_identifier";
+  if (depth >= LIST_CERTIFICATE_NAMES)
+    sql += ", c.default_cert DESC, c.cert_name";
+
+  sqlite3_stmt* stmt;
+  sqlite3_prepare_v2(m_database, sql.c_str(), -1, &stmt, 0);
+
+  if (!prefix.empty()) {
+    string prefixUri = prefix.toUri();
+    sqlite3_bind_string(stmt, 1, prefixUri, SQLITE_TRANSIENT);
+    sqlite3_bind_string(stmt, 2, prefixUri + "/", SQLITE_TRANSIENT);
+    sqlite3_bind_string(stmt, 3, prefixUri + "0", SQLITE_TRANSIENT);
+  }
+
+  ListEntry entry;
+  string identityUri;
+  while (sqlite3_step(stmt) == SQLITE_ROW) {
+    // consecutive rows mostly share the identity, so its name is decoded only when it changes
+    string uri = sqlite3_column_string(stmt, 0);
+    if (uri != identityUri) {
+      identityUri = uri;
+      entry.identity = Name(identityUri);
+    }
+    entry.isDefaultIdentity = sqlite3_column_int(stmt, 1) != 0;
+
+    entry.keyName.clear();
+    entry.isDefaultKey = false;
+    if (depth >= LIST_KEYS && sqlite3_column_type(stmt, 2) != SQLITE_NULL) {
+      entry.keyName = entry.identity;
+      entry.keyName.append(sqlite3_column_string(stmt, 2));
+      entry.isDefaultKey = sqlite3_column_int(stmt, 3) != 0;
+    }
+
+    entry.certName.clear();
+    entry.isDefaultCertificate = false;
+    entry.certificate = nullptr;
+    if (depth >= LIST_CERTIFICATE_NAMES && sqlite3_column_type(stmt, 4) != SQLITE_NULL) {
+      entry.certName = Name(sqlite3_column_string(stmt, 4));
+      entry.isDefaultCertificate = sqlite3_column_int(stmt, 5) != 0;
+
+      if (depth >= LIST_CERTIFICATES) {
+        entry.certificate = make_shared<IdentityCertificate>();
+        try {
+          entry.certificate->wireDecode(Block(static_cast<const uint8_t*>(sqlite3_column_blob(stmt, 6)),
+                                              sqlite3_column_bytes(stmt, 6)));
+        }
+        catch (const tlv::Error&) {
+          sqlite3_finalize(stmt);
+          BOOST_THROW_EXCEPTION(Error("SecPublicInfoSqlite3::listEntries  certificate cannot be "
+                                      "decoded"));
+        }
+      }
+    }
+
+    try {
+      visit(entry);
+    }
+    catch (...) {
+      sqlite3_finalize(stmt);
+      throw;
+    }
+  }
+
+  sqlite3_finalize(stmt);
+}
+
 void
 SecPublicInfoSqlite3::deleteCertificateInfo(const Name& certName)
 {
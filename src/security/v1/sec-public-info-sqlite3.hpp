@@ -122,6 +122,15 @@ public:
   virtual void
   getAllCertificateNamesOfKey(const Name& keyName, std::vector<Name>& nameList, bool isDefault);
 
+  /**
+   * @brief Visit identities, keys, and certificates with a single query
+   *
+   * Filtering by @p prefix is done by the database.  Identities, keys, and certificates with
+   * the same default flag are visited in the order of their names.
+   */
+  virtual void
+  listEntries(const Name& prefix, ListDepth depth, const ListEntryCallback& visit);
+
   virtual void
   deleteCertificateInfo(const Name& certificateName);
 
@@ -105,6 +105,81 @@ SecPublicInfo::getNewKeyName(const Name& identityName, bool useKsk)
   return keyName;
 }
 
+void
+SecPublicInfo::listEntries(const Name& prefix, ListDepth depth, const ListEntryCallback& visit)
+{
+  ListEntry entry;
+  for (bool isDefaultIdentity : {true, false}) {
+    std::vector<Name> identities;
+    getAllIdentities(identities, isDefaultIdentity);
+
+    for (const Name& identity : identities) {
+      if (!prefix.isPrefixOf(identity)) {
+        continue;
+      }
+      entry.identity = identity;
+      entry.isDefaultIdentity = isDefaultIdentity;
+      entry.keyName.clear();
+      entry.isDefaultKey = false;
+      entry.certName.clear();
+      entry.isDefaultCertificate = false;
+      entry.certificate = nullptr;
+
+      if (depth == LIST_IDENTITIES) {
+        visit(entry);
+        continue;
+      }
+
+      bool hasKey = false;
+      for (bool isDefaultKey : {true, false}) {
+        std::vector<Name> keyNames;
+        getAllKeyNamesOfIdentity(identity, keyNames, isDefaultKey);
+
+        for (const Name& keyName : keyNames) {
+          hasKey = true;
+          entry.keyName = keyName;
+          entry.isDefaultKey = isDefaultKey;
+          entry.certName.clear();
+          entry.isDefaultCertificate = false;
+          entry.certificate = nullptr;
+
+          if (depth == LIST_KEYS) {
+            visit(entry);
+            continue;
+          }
+
+          bool hasCert = false;
+          for (bool isDefaultCert : {true, false}) {
+            std::vector<Name> certNames;
+            getAllCertificateNamesOfKey(keyName, certNames, isDefaultCert);
+
+            for (const Name& certName : certNames) {
+              hasCert = true;
+              entry.certName = certName;
+              entry.isDefaultCertificate = isDefaultCert;
+              if (depth == LIST_CERTIFICATES) {
+                entry.certificate = getCertificate(certName);
+              }
+              visit(entry);
+            }
+          }
+
+          if (!hasCert) {
+            entry.certName.clear();
+            entry.isDefaultCertificate = false;
+            entry.certificate = nullptr;
+            visit(entry);
+          }
+        }
+      }
+
+      if (!hasKey) {
+        visit(entry);
+      }
+    }
+  }
+}
+
 void
 SecPublicInfo::addCertificateAsKeyDefault(const IdentityCertificate& certificate)
 {
@@ -270,6 +270,54 @@ public:
   virtual void
   getAllCertificateNamesOfKey(const Name& keyName, std::vector<Name>& nameList, bool isDefault) = 0;
 
+  /**
+   * @brief Level of detail of listEntries
+   */
+  enum ListDepth {
+    LIST_IDENTITIES,        ///< identities only
+    LIST_KEYS,              ///< identities and keys
+    LIST_CERTIFICATE_NAMES, ///< identities, keys, and certificate names
+    LIST_CERTIFICATES       ///< identities, keys, and decoded certificates
+  };
+
+  /**
+   * @brief An identity, key, or certificate visited by listEntries
+   */
+  struct ListEntry
+  {
+    Name identity;
+    bool isDefaultIdentity = false;
+    /// empty if keys are not listed, or if the identity has no key
+    Name keyName;
+    bool isDefaultKey = false;
+    /// empty if certificates are not listed, or if the key has no certificate
+    Name certName;
+    bool isDefaultCertificate = false;
+    /// set only if the depth is LIST_CERTIFICATES and certName is not empty
+    shared_ptr<IdentityCertificate> certificate;
+  };
+
+  typedef function<void(const ListEntry& entry)> ListEntryCallback;
+
+  /**
+   * @brief Visit identities under @p prefix together with their keys and certificates
+   *
+   * @p visit is invoked once for each identity, key, or certificate, according to @p depth.
+   * An identity without keys, or a key without certificates, is visited once with an empty
+   * key or certificate name.  The default identity is visited first, followed by the other
+   * identities; the same order applies to the keys of an identity and to the certificates
+   * of a key.
+   *
+   * The default implementation is built on the getAll* methods.  A backend should override it
+   * with set-based queries when that is cheaper than one query per identity and key.
+   *
+   * @param prefix only identities under this prefix are visited
+   * @param depth  level of detail
+   * @param visit  callback invoked for each entry, as soon as the entry is available
+   */
+  virtual void
+  listEntries(const Name& prefix, ListDepth depth, const ListEntryCallback& visit);
+
   /*****************************************
    *            Delete Methods             *
    *****************************************/
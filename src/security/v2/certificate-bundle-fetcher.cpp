@@ -165,13 +165,7 @@ CertificateBundleFetcher::dataCallback(const Data& bundleData,
       state->setTag(make_shared<FinalBlockIdTag>(finalBlockId));
     }
 
-    Block bundleContent = bundleData.getContent();
-    bundleContent.parse();
-
-    // store all the certificates in unverified cache
-    for (const auto& block : bundleContent.elements()) {
-      m_certStorage->cacheUnverifiedCert(Certificate(block));
-    }
+    cacheBundleSegment(bundleData);
 
     auto cert = m_certStorage->getUnverifiedCertCache().find(certRequest->m_interest);
     continueValidation(*cert, state);
@@ -202,6 +196,110 @@ CertificateBundleFetcher::timeoutCallback(const shared_ptr<CertificateRequest>&
   m_inner->fetch(certRequest, state, continueValidation);
 }
 
+void
+CertificateBundleFetcher::cacheBundleSegment(const Data& bundleData)
+{
+  Block bundleContent = bundleData.getContent();
+  bundleContent.parse();
+
+  // store all the certificates in unverified cache
+  for (const auto& block : bundleContent.elements()) {
+    m_certStorage->cacheUnverifiedCert(Certificate(block));
+  }
+}
+
+void
+CertificateBundleFetcher::prefetchBundle(const Name& dataName)
+{
+  BOOST_ASSERT(m_certStorage != nullptr);
+
+  Interest bundleInterest(deriveBundleName(dataName));
+  bundleInterest.setInterestLifetime(m_bundleInterestLifetime);
+  bundleInterest.setMustBeFresh(true);
+  bundleInterest.setChildSelector(1);
+
+  m_face.expressInterest(bundleInterest,
+                         [this] (const Interest& interest, const Data& data) {
+                           prefetchCallback(data);
+                         },
+                         [] (const Interest& interest, const lp::Nack& nack) {
+                           NDN_LOG_DEBUG("NACK (" << nack.getReason() << ") while prefetching "
+                                         "certificate bundle " << interest.getName());
+                         },
+                         [] (const Interest& interest) {
+                           NDN_LOG_DEBUG("Timeout while prefetching certificate bundle "
+                                         << interest.getName());
+                         });
+}
+
+void
+CertificateBundleFetcher::prefetchCallback(const Data& bundleData)
+{
+  NDN_LOG_DEBUG("Prefetched certificate bundle " << bundleData.getName());
+
+  name::Component currentSegment = bundleData.getName().get(-1);
+  if (!currentSegment.isSegment()) {
+    return;
+  }
+
+  try {
+    cacheBundleSegment(bundleData);
+  }
+  catch (const tlv::Error& e) {
+    NDN_LOG_DEBUG("Malformed certificate bundle " << bundleData.getName() << ": " << e.what());
+    return;
+  }
+
+  uint64_t segmentNo = currentSegment.toSegment();
+  uint64_t lastSegmentNo = segmentNo;
+  const name::Component& finalBlockId = bundleData.getMetaInfo().getFinalBlockId();
+  if (finalBlockId.isSegment()) {
+    lastSegmentNo = std::max(lastSegmentNo, finalBlockId.toSegment());
+  }
+
+  prefetchNextBundleSegment(bundleData.getName().getPrefix(-1), 0, segmentNo, lastSegmentNo);
+}
+
+void
+CertificateBundleFetcher::prefetchNextBundleSegment(const Name& versionedBundleName,
+                                                    uint64_t segmentNo, uint64_t skippedSegmentNo,
+                                                    uint64_t lastSegmentNo)
+{
+  if (segmentNo == skippedSegmentNo) {
+    ++segmentNo;
+  }
+  if (segmentNo > lastSegmentNo) {
+    return;
+  }
+
+  Interest bundleInterest(Name(versionedBundleName).appendSegment(segmentNo));
+  bundleInterest.setInterestLifetime(m_bundleInterestLifetime);
+  bundleInterest.setMustBeFresh(false);
+
+  m_face.expressInterest(bundleInterest,
+                         [=] (const Interest& interest, const Data& data) {
+                           NDN_LOG_DEBUG("Prefetched certificate bundle " << data.getName());
+                           try {
+                             cacheBundleSegment(data);
+                           }
+                           catch (const tlv::Error& e) {
+                             NDN_LOG_DEBUG("Malformed certificate bundle " << data.getName()
+                                           << ": " << e.what());
+                             return;
+                           }
+                           prefetchNextBundleSegment(versionedBundleName, segmentNo + 1,
+                                                     skippedSegmentNo, lastSegmentNo);
+                         },
+                         [] (const Interest& interest, const lp::Nack& nack) {
+                           NDN_LOG_DEBUG("NACK (" << nack.getReason() << ") while prefetching "
+                                         "certificate bundle " << interest.getName());
+                         },
+                         [] (const Interest& interest) {
+                           NDN_LOG_DEBUG("Timeout while prefetching certificate bundle "
+                                         << interest.getName());
+                         });
+}
+
 Name
 CertificateBundleFetcher::deriveBundleName(const Name& name)
 {
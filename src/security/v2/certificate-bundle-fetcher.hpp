@@ -63,6 +63,19 @@ public:
   void
   setCertificateStorage(CertificateStorage& certStorage) override;
 
+  /**
+   * @brief Fetch the certificate bundle for @p dataName in the background
+   *
+   * All segments of the latest version of the bundle are retrieved, and their certificates
+   * are stored in the unverified certificate cache, so that validation of Data under
+   * @p dataName shortly afterwards does not need to wait for certificate retrieval.
+   * Failures are logged and otherwise ignored.
+   *
+   * @pre setCertificateStorage has been called, e.g., by constructing a Validator
+   */
+  void
+  prefetchBundle(const Name& dataName);
+
 protected:
   void
   doFetch(const shared_ptr<CertificateRequest>& certRequest, const shared_ptr<ValidationState>& state,
@@ -111,6 +124,25 @@ private:
   static Name
   deriveBundleName(const Name& name);
 
+  /**
+   * @brief Store the certificates in @p bundleData in the unverified certificate cache
+   */
+  void
+  cacheBundleSegment(const Data& bundleData);
+
+  /**
+   * @brief Callback invoked when the first prefetched bundle segment is retrieved.
+   */
+  void
+  prefetchCallback(const Data& bundleData);
+
+  /**
+   * @brief Prefetch bundle segments @p segmentNo to @p lastSegmentNo, except @p skippedSegmentNo
+   */
+  void
+  prefetchNextBundleSegment(const Name& versionedBundleName, uint64_t segmentNo,
+                            uint64_t skippedSegmentNo, uint64_t lastSegmentNo);
+
   /**
    * @brief Callback invoked when certificate bundle is retrieved.
    */
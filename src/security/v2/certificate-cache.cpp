@@ -22,12 +22,19 @@
 #include "certificate-cache.hpp"
 #include "util/logger.hpp"
 
+#include <iterator>
+
 namespace ndn {
 namespace security {
 namespace v2 {
 
 NDN_LOG_INIT(ndn.security.v2.CertificateCache);
 
+/// TLV-TYPE of a snapshot entry, containing SNAPSHOT_REMOVAL_TIME and the certificate
+static const uint32_t SNAPSHOT_ENTRY = 128;
+/// TLV-TYPE of the removal time of a snapshot entry, in milliseconds since Unix epoch
+static const uint32_t SNAPSHOT_REMOVAL_TIME = 129;
+
 const time::nanoseconds&
 CertificateCache::getDefaultLifetime()
 {
@@ -93,6 +100,74 @@ CertificateCache::find(const Interest& interest) const
   return nullptr;
 }
 
+void
+CertificateCache::save(std::ostream& os)
+{
+  refresh();
+
+  for (const Entry& entry : m_certsByName) {
+    Block block(SNAPSHOT_ENTRY);
+    block.push_back(makeNonNegativeIntegerBlock(SNAPSHOT_REMOVAL_TIME,
+                                                time::toUnixTimestamp(entry.removalTime).count()));
+    block.push_back(entry.cert.wireEncode());
+    block.encode();
+    os.write(reinterpret_cast<const char*>(block.wire()), block.size());
+  }
+}
+
+size_t
+CertificateCache::load(std::istream& is)
+{
+  auto buffer = make_shared<Buffer>(std::istreambuf_iterator<char>(is),
+                                    std::istreambuf_iterator<char>());
+  time::system_clock::TimePoint now = time::system_clock::now();
+
+  size_t nLoaded = 0;
+  size_t offset = 0;
+  while (offset < buffer->size()) {
+    bool isOk = false;
+    Block block;
+    std::tie(isOk, block) = Block::fromBuffer(buffer, offset);
+    if (!isOk) {
+      NDN_LOG_WARN("Ignoring truncated snapshot entry at offset " << offset);
+      break;
+    }
+    offset += block.size();
+
+    if (block.type() != SNAPSHOT_ENTRY) {
+      continue;
+    }
+
+    try {
+      block.parse();
+      if (block.elements_size() != 2 || block.elements()[0].type() != SNAPSHOT_REMOVAL_TIME) {
+        NDN_LOG_WARN("Ignoring malformed snapshot entry");
+        continue;
+      }
+
+      auto removalTime = time::fromUnixTimestamp(
+                           time::milliseconds(readNonNegativeInteger(block.elements()[0])));
+      Certificate cert(block.elements()[1]);
+      if (removalTime < now || !cert.isValid(now)) {
+        NDN_LOG_DEBUG("Not loading " << cert.getName() << ": expired");
+        continue;
+      }
+
+      removalTime = std::min(removalTime, now + m_maxLifetime);
+      if (m_certs.insert(Entry(cert, removalTime)).second) {
+        NDN_LOG_DEBUG("Loaded " << cert.getName() << ", will remove in "
+                      << time::duration_cast<time::seconds>(removalTime - now));
+        ++nLoaded;
+      }
+    }
+    catch (const tlv::Error& e) {
+      NDN_LOG_WARN("Ignoring malformed snapshot entry: " << e.what());
+    }
+  }
+
+  return nLoaded;
+}
+
 void
 CertificateCache::refresh()
 {
@@ -84,6 +84,38 @@ public:
   const Certificate*
   find(const Interest& interest) const;
 
+  /**
+   * @brief Write a snapshot of the cached certificates to @p os
+   *
+   * Each certificate is saved together with its removal time, so that reloading a snapshot
+   * does not extend the time a certificate stays in the cache.  Expired certificates are
+   * removed from the cache before writing.
+   */
+  void
+  save(std::ostream& os);
+
+  /**
+   * @brief Insert certificates from a snapshot written by save()
+   *
+   * A certificate is skipped if its removal time has passed, if it is outside of its validity
+   * period, or if it is already in the cache.  Its removal time is capped to maxLifetime
+   * from now.  Reading stops at the first truncated entry; malformed entries are skipped.
+   *
+   * @return number of inserted certificates
+   */
+  size_t
+  load(std::istream& is);
+
+  /**
+   * @return number of certificates in the cache, including those not yet removed after
+   *         their removal time
+   */
+  size_t
+  size() const
+  {
+    return m_certs.size();
+  }
+
 private:
   class Entry
   {
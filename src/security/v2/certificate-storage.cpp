@@ -20,17 +20,34 @@
  */
 
 #include "certificate-storage.hpp"
+#include "util/logger.hpp"
+
+#include <cerrno>
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+
+#include <stdlib.h>
+#include <sys/stat.h>
+#include <unistd.h>
 
 namespace ndn {
 namespace security {
 namespace v2 {
 
+NDN_LOG_INIT(ndn.security.v2.CertificateStorage);
+
 CertificateStorage::CertificateStorage()
   : m_verifiedCertCache(time::hours(1))
   , m_unverifiedCertCache(time::minutes(5))
 {
 }
 
+CertificateStorage::~CertificateStorage()
+{
+  saveVerifiedCertSnapshot();
+}
+
 const Certificate*
 CertificateStorage::findTrustedCert(const Interest& interestForCert) const
 {
@@ -94,6 +111,70 @@ CertificateStorage::getUnverifiedCertCache() const
   return m_unverifiedCertCache;
 }
 
+size_t
+CertificateStorage::setVerifiedCertSnapshot(const std::string& filename)
+{
+  m_snapshotFile = filename;
+
+  std::ifstream is(filename, std::ios::binary);
+  if (!is) {
+    NDN_LOG_DEBUG("Snapshot " << filename << " cannot be opened, starting with empty cache");
+    return 0;
+  }
+
+  // snapshot certificates are not trusted until verified under the current configuration
+  size_t nLoaded = m_unverifiedCertCache.load(is);
+  NDN_LOG_INFO("Loaded " << nLoaded << " certificates from " << filename);
+  return nLoaded;
+}
+
+bool
+CertificateStorage::saveVerifiedCertSnapshot()
+{
+  if (m_snapshotFile.empty()) {
+    return false;
+  }
+
+  std::ostringstream os;
+  m_verifiedCertCache.save(os);
+  const std::string& snapshot = os.str();
+
+  // mkstemp creates a new file with mode 0600, so that the temporary file cannot be
+  // a pre-existing file or symlink planted by another user
+  std::string tmpFile = m_snapshotFile + ".XXXXXX";
+  int fd = ::mkstemp(&tmpFile[0]);
+  if (fd < 0) {
+    NDN_LOG_WARN("Cannot create temporary file for snapshot " << m_snapshotFile);
+    return false;
+  }
+
+  bool isOk = ::fchmod(fd, S_IRUSR | S_IWUSR) == 0;
+  for (size_t offset = 0; isOk && offset < snapshot.size();) {
+    ssize_t nWritten = ::write(fd, snapshot.data() + offset, snapshot.size() - offset);
+    if (nWritten < 0 && errno != EINTR) {
+      isOk = false;
+    }
+    else if (nWritten > 0) {
+      offset += static_cast<size_t>(nWritten);
+    }
+  }
+  isOk = ::close(fd) == 0 && isOk;
+  if (!isOk) {
+    NDN_LOG_WARN("Cannot write snapshot " << tmpFile);
+    ::unlink(tmpFile.data());
+    return false;
+  }
+
+  if (std::rename(tmpFile.data(), m_snapshotFile.data()) != 0) {
+    NDN_LOG_WARN("Cannot rename " << tmpFile << " to " << m_snapshotFile);
+    ::unlink(tmpFile.data());
+    return false;
+  }
+
+  NDN_LOG_TRACE("Saved verified certificates to " << m_snapshotFile);
+  return true;
+}
+
 } // namespace v2
 } // namespace security
 } // namespace ndn
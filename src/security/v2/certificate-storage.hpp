@@ -38,6 +38,12 @@ class CertificateStorage : noncopyable
 public:
   CertificateStorage();
 
+  /**
+   * @brief Save the verified certificate cache if a snapshot file is set
+   * @sa setVerifiedCertSnapshot
+   */
+  ~CertificateStorage();
+
   /**
    * @brief Find a trusted certificate in trust anchor container or in verified cache
    * @param interestForCert Interest for certificate
@@ -82,6 +88,37 @@ public:
   const CertificateCache&
   getUnverifiedCertCache() const;
 
+  /**
+   * @brief Persist the verified certificate cache in @p filename
+   *
+   * Certificates saved in @p filename are loaded into the unverified certificate cache
+   * immediately, so that a restarted process does not need to fetch them again.  They are
+   * verified again against the current trust anchors and validation policy before they are
+   * used, and enter the verified certificate cache only then; a snapshot written under a
+   * different trust configuration, or modified by someone else, cannot make a certificate
+   * trusted.  Expired certificates are not loaded.  Afterwards, the verified certificate cache
+   * is saved to @p filename on destruction and whenever saveVerifiedCertSnapshot is invoked.
+   * Validation never writes the snapshot; an application that wants periodic saves should
+   * schedule saveVerifiedCertSnapshot on its own io_service.
+   *
+   * @param filename snapshot file; a missing file is treated as an empty snapshot
+   * @return number of certificates loaded from @p filename
+   */
+  size_t
+  setVerifiedCertSnapshot(const std::string& filename);
+
+  /**
+   * @brief Save the verified certificate cache to the snapshot file now
+   *
+   * The snapshot is written to a new file with a unique name, readable and writable only by
+   * the owner, in the directory of the snapshot file, which is then renamed to the snapshot
+   * file.
+   *
+   * @return whether the snapshot has been written; false if no snapshot file is set
+   */
+  bool
+  saveVerifiedCertSnapshot();
+
 protected:
   /**
    * @brief load static trust anchor.
@@ -122,6 +159,9 @@ protected:
   TrustAnchorContainer m_trustAnchors;
   CertificateCache m_verifiedCertCache;
   CertificateCache m_unverifiedCertCache;
+
+private:
+  std::string m_snapshotFile;
 };
 
 } // namespace v2
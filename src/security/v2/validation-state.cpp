@@ -62,23 +62,50 @@ ValidationState::addCertificate(const Certificate& cert)
   m_certificateChain.push_front(cert);
 }
 
+void
+ValidationState::verifyOriginalPacket(const Certificate& trustedCert)
+{
+  finishOriginalPacket(checkOriginalPacketSignature(trustedCert));
+}
+
 const Certificate*
 ValidationState::verifyCertificateChain(const Certificate& trustedCert)
 {
-  const Certificate* validatedCert = &trustedCert;
-  for (auto it = m_certificateChain.begin(); it != m_certificateChain.end(); ++it) {
-    const auto& certToValidate = *it;
+  return finishCertificateChain(trustedCert, countValidCertificates(trustedCert));
+}
 
+size_t
+ValidationState::countValidCertificates(const Certificate& trustedCert) const
+{
+  size_t nValidCerts = 0;
+  const Certificate* validatedCert = &trustedCert;
+  for (const auto& certToValidate : m_certificateChain) {
     if (!verifySignature(certToValidate, *validatedCert)) {
-      this->fail({ValidationError::Code::INVALID_SIGNATURE, "Invalid signature of certificate `" +
-                  certToValidate.getName().toUri() + "`"});
-      m_certificateChain.erase(it, m_certificateChain.end());
-      return nullptr;
-    }
-    else {
-      NDN_LOG_TRACE_DEPTH("OK signature for certificate `" << certToValidate.getName() << "`");
-      validatedCert = &certToValidate;
+      break;
     }
+    ++nValidCerts;
+    validatedCert = &certToValidate;
+  }
+  return nValidCerts;
+}
+
+const Certificate*
+ValidationState::finishCertificateChain(const Certificate& trustedCert, size_t nValidCerts)
+{
+  BOOST_ASSERT(nValidCerts <= m_certificateChain.size());
+
+  const Certificate* validatedCert = &trustedCert;
+  auto it = m_certificateChain.begin();
+  for (size_t i = 0; i < nValidCerts; ++i, ++it) {
+    NDN_LOG_TRACE_DEPTH("OK signature for certificate `" << it->getName() << "`");
+    validatedCert = &*it;
+  }
+
+  if (it != m_certificateChain.end()) {
+    this->fail({ValidationError::Code::INVALID_SIGNATURE, "Invalid signature of certificate `" +
+                it->getName().toUri() + "`"});
+    m_certificateChain.erase(it, m_certificateChain.end());
+    return nullptr;
   }
   return validatedCert;
 }
@@ -104,10 +131,16 @@ DataValidationState::~DataValidationState()
   }
 }
 
+bool
+DataValidationState::checkOriginalPacketSignature(const Certificate& trustedCert) const
+{
+  return verifySignature(m_data, trustedCert);
+}
+
 void
-DataValidationState::verifyOriginalPacket(const Certificate& trustedCert)
+DataValidationState::finishOriginalPacket(bool isSignatureValid)
 {
-  if (verifySignature(m_data, trustedCert)) {
+  if (isSignatureValid) {
     NDN_LOG_TRACE_DEPTH("OK signature for data `" << m_data.getName() << "`");
     m_successCb(m_data);
     BOOST_ASSERT(!m_hasOutcome);
@@ -164,10 +197,16 @@ InterestValidationState::~InterestValidationState()
   }
 }
 
+bool
+InterestValidationState::checkOriginalPacketSignature(const Certificate& trustedCert) const
+{
+  return verifySignature(m_interest, trustedCert);
+}
+
 void
-InterestValidationState::verifyOriginalPacket(const Certificate& trustedCert)
+InterestValidationState::finishOriginalPacket(bool isSignatureValid)
 {
-  if (verifySignature(m_interest, trustedCert)) {
+  if (isSignatureValid) {
     NDN_LOG_TRACE_DEPTH("OK signature for interest `" << m_interest.getName() << "`");
     m_successCb(m_interest);
     BOOST_ASSERT(!m_hasOutcome);
@@ -101,8 +101,25 @@ private: // Interface intended to be used only by Validator class
    *
    * @param trustCert The certificate that signs the original packet
    */
+  void
+  verifyOriginalPacket(const Certificate& trustedCert);
+
+  /**
+   * @brief Check signature of the original packet without invoking any callback
+   *
+   * @param trustCert The certificate that signs the original packet
+   * @note This method does not modify the state and can be called from a verification thread.
+   */
+  virtual bool
+  checkOriginalPacketSignature(const Certificate& trustedCert) const = 0;
+
+  /**
+   * @brief Call success or failure callback of the original packet
+   *
+   * @param isSignatureValid Result of checkOriginalPacketSignature()
+   */
   virtual void
-  verifyOriginalPacket(const Certificate& trustedCert) = 0;
+  finishOriginalPacket(bool isSignatureValid) = 0;
 
   /**
    * @brief Call success callback of the original packet without signature validation
@@ -127,6 +144,23 @@ private: // Interface intended to be used only by Validator class
   const Certificate*
   verifyCertificateChain(const Certificate& trustedCert);
 
+  /**
+   * @brief Check signatures of certificates in the certificate chain without modifying the state
+   *
+   * @return Number of certificates at the beginning of m_certificateChain with valid signatures
+   * @note This method can be called from a verification thread.
+   */
+  size_t
+  countValidCertificates(const Certificate& trustedCert) const;
+
+  /**
+   * @brief Update the certificate chain with the result of countValidCertificates()
+   *
+   * @return Same as verifyCertificateChain()
+   */
+  const Certificate*
+  finishCertificateChain(const Certificate& trustedCert, size_t nValidCerts);
+
 protected:
   bool m_hasOutcome;
 
@@ -178,8 +212,11 @@ public:
   getOriginalData() const;
 
 private:
+  bool
+  checkOriginalPacketSignature(const Certificate& trustedCert) const final;
+
   void
-  verifyOriginalPacket(const Certificate& trustedCert) final;
+  finishOriginalPacket(bool isSignatureValid) final;
 
   void
   bypassValidation() final;
@@ -224,8 +261,11 @@ public:
   getOriginalInterest() const;
 
 private:
+  bool
+  checkOriginalPacketSignature(const Certificate& trustedCert) const final;
+
   void
-  verifyOriginalPacket(const Certificate& trustedCert) final;
+  finishOriginalPacket(bool isSignatureValid) final;
 
   void
   bypassValidation() final;
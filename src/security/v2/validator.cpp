@@ -20,6 +20,7 @@
  */
 
 #include "validator.hpp"
+#include "verification-pool.hpp"
 
 #include "face.hpp"
 #include "security/transform/public-key.hpp"
@@ -58,6 +59,12 @@ Validator::getMaxDepth() const
   return m_maxDepth;
 }
 
+void
+Validator::setVerificationPool(unique_ptr<VerificationPool> pool)
+{
+  m_verificationPool = std::move(pool);
+}
+
 void
 Validator::validate(const Data& data,
                     const DataValidationSuccessCallback& successCb,
@@ -144,16 +151,7 @@ Validator::requestCertificate(const shared_ptr<CertificateRequest>& certRequest,
   auto cert = findTrustedCert(certRequest->m_interest);
   if (cert != nullptr) {
     NDN_LOG_TRACE_DEPTH("Found trusted certificate " << cert->getName());
-
-    cert = state->verifyCertificateChain(*cert);
-    if (cert != nullptr) {
-      state->verifyOriginalPacket(*cert);
-    }
-    for (auto trustedCert = std::make_move_iterator(state->m_certificateChain.begin());
-         trustedCert != std::make_move_iterator(state->m_certificateChain.end());
-         ++trustedCert) {
-      cacheVerifiedCertificate(*trustedCert);
-    }
+    verifySignatures(*cert, state);
     return;
   }
 
@@ -162,6 +160,66 @@ Validator::requestCertificate(const shared_ptr<CertificateRequest>& certRequest,
     });
 }
 
+void
+Validator::verifySignatures(const Certificate& trustedCert, const shared_ptr<ValidationState>& state)
+{
+  struct Result
+  {
+    size_t nValidCerts;
+    bool isPacketSignatureValid;
+  };
+
+  // does not modify the state, so it can be executed on a verification thread
+  auto checkSignatures = [] (const Certificate& trustedCert, const ValidationState& state) -> Result {
+    Result result{state.countValidCertificates(trustedCert), false};
+    if (result.nValidCerts == state.m_certificateChain.size()) {
+      const Certificate& signer = state.m_certificateChain.empty() ?
+                                  trustedCert : state.m_certificateChain.back();
+      result.isPacketSignatureValid = state.checkOriginalPacketSignature(signer);
+    }
+    return result;
+  };
+
+  if (m_verificationPool != nullptr) {
+    // The trusted certificate is copied, as it may be evicted from the certificate storage
+    // before the job completes.  The state is not accessed by the validator until then.
+    auto result = make_shared<Result>();
+    bool isQueued = m_verificationPool->post(
+      [checkSignatures, trustedCert, state, result] {
+        *result = checkSignatures(trustedCert, *state);
+      },
+      [this, trustedCert, state, result] {
+        finishValidation(trustedCert, state, result->nValidCerts, result->isPacketSignatureValid);
+      },
+      [state] {
+        state->fail({ValidationError::Code::IMPLEMENTATION_ERROR,
+                     "Verification pool was stopped before signatures were verified"});
+      });
+
+    if (isQueued) {
+      return;
+    }
+    NDN_LOG_TRACE_DEPTH("Verification queue is full, verifying signatures synchronously");
+  }
+
+  Result result = checkSignatures(trustedCert, *state);
+  finishValidation(trustedCert, state, result.nValidCerts, result.isPacketSignatureValid);
+}
+
+void
+Validator::finishValidation(const Certificate& trustedCert, const shared_ptr<ValidationState>& state,
+                            size_t nValidCerts, bool isPacketSignatureValid)
+{
+  if (state->finishCertificateChain(trustedCert, nValidCerts) != nullptr) {
+    state->finishOriginalPacket(isPacketSignatureValid);
+  }
+  for (auto cert = std::make_move_iterator(state->m_certificateChain.begin());
+       cert != std::make_move_iterator(state->m_certificateChain.end());
+       ++cert) {
+    cacheVerifiedCertificate(*cert);
+  }
+}
+
 ////////////////////////////////////////////////////////////////////////
 // Trust anchor management
 ////////////////////////////////////////////////////////////////////////
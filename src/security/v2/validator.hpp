@@ -36,6 +36,8 @@ class Face;
 namespace security {
 namespace v2 {
 
+class VerificationPool;
+
 /**
  * @brief Interface for validating data and interest packets.
  *
@@ -83,6 +85,20 @@ public:
   size_t
   getMaxDepth() const;
 
+  /**
+   * @brief Verify signatures on the worker threads of @p pool
+   *
+   * Once the certificate chain of a packet reaches a trusted certificate, the signatures of the
+   * chain and of the packet are checked by a worker thread, and the validation callbacks are
+   * invoked from the io_service of @p pool, which must be the one running this validator.
+   * Signatures are verified synchronously when the queue of @p pool is full.  Validations
+   * waiting on the previous pool fail with ValidationError::IMPLEMENTATION_ERROR.
+   *
+   * @param pool Verification thread pool, or nullptr to verify signatures synchronously
+   */
+  void
+  setVerificationPool(unique_ptr<VerificationPool> pool);
+
   /**
    * @brief Asynchronously validate @p data
    *
@@ -158,10 +174,27 @@ private: // Common validator operations
   requestCertificate(const shared_ptr<CertificateRequest>& certRequest,
                      const shared_ptr<ValidationState>& state);
 
+  /**
+   * @brief Verify signatures of the certificate chain and the original packet
+   *
+   * @param trustedCert The trusted certificate that signs the first certificate in the chain
+   * @param state       The current validation state.
+   */
+  void
+  verifySignatures(const Certificate& trustedCert, const shared_ptr<ValidationState>& state);
+
+  /**
+   * @brief Complete validation with the results of signature verification
+   */
+  void
+  finishValidation(const Certificate& trustedCert, const shared_ptr<ValidationState>& state,
+                   size_t nValidCerts, bool isPacketSignatureValid);
+
 private:
   unique_ptr<ValidationPolicy> m_policy;
   unique_ptr<CertificateFetcher> m_certFetcher;
   size_t m_maxDepth;
+  unique_ptr<VerificationPool> m_verificationPool;
 };
 
 } // namespace v2
@@ -0,0 +1,138 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2013-2017 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#include "verification-pool.hpp"
+
+namespace ndn {
+namespace security {
+namespace v2 {
+
+VerificationPool::VerificationPool(boost::asio::io_service& io, size_t nThreads, size_t maxQueueSize)
+  : m_io(io)
+  , m_maxQueueSize(maxQueueSize)
+  , m_shouldStop(false)
+  , m_isAlive(make_shared<bool>(true))
+{
+  if (nThreads == 0) {
+    BOOST_THROW_EXCEPTION(Error("Number of verification threads must be positive"));
+  }
+  if (maxQueueSize == 0) {
+    BOOST_THROW_EXCEPTION(Error("Verification queue size must be positive"));
+  }
+
+  m_threads.reserve(nThreads);
+  for (size_t i = 0; i < nThreads; ++i) {
+    m_threads.emplace_back(&VerificationPool::run, this);
+  }
+}
+
+VerificationPool::~VerificationPool()
+{
+  std::deque<shared_ptr<Job>> unstartedJobs;
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_shouldStop = true;
+    unstartedJobs.swap(m_queue);
+  }
+  m_cv.notify_all();
+
+  for (auto& thread : m_threads) {
+    thread.join();
+  }
+
+  *m_isAlive = false;
+
+  for (const shared_ptr<Job>& job : unstartedJobs) {
+    job->job = nullptr;
+    m_io.post([job] { finish(*job, false); });
+  }
+}
+
+bool
+VerificationPool::post(const std::function<void()>& job, const std::function<void()>& onComplete,
+                       const std::function<void()>& onCancel)
+{
+  BOOST_ASSERT(job != nullptr);
+  BOOST_ASSERT(onComplete != nullptr);
+  BOOST_ASSERT(onCancel != nullptr);
+
+  auto entry = make_shared<Job>();
+  entry->job = job;
+  entry->onComplete = onComplete;
+  entry->onCancel = onCancel;
+  entry->work = make_shared<boost::asio::io_service::work>(m_io);
+
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (m_queue.size() >= m_maxQueueSize) {
+      return false;
+    }
+    m_queue.push_back(std::move(entry));
+  }
+  m_cv.notify_one();
+  return true;
+}
+
+void
+VerificationPool::run()
+{
+  while (true) {
+    shared_ptr<Job> job;
+    {
+      std::unique_lock<std::mutex> lock(m_mutex);
+      m_cv.wait(lock, [this] { return m_shouldStop || !m_queue.empty(); });
+      if (m_shouldStop) {
+        return;
+      }
+      job = std::move(m_queue.front());
+      m_queue.pop_front();
+    }
+
+    job->job();
+    // objects captured by the job are also held by the handlers, so this is not their last
+    // reference; it must be dropped before the handlers can run and release theirs
+    job->job = nullptr;
+
+    shared_ptr<bool> isAlive = m_isAlive;
+    m_io.post([job, isAlive] { finish(*job, *isAlive); });
+  }
+}
+
+void
+VerificationPool::finish(Job& job, bool isCompleted)
+{
+  std::function<void()> onComplete;
+  std::function<void()> onCancel;
+  onComplete.swap(job.onComplete);
+  onCancel.swap(job.onCancel);
+
+  if (isCompleted) {
+    onComplete();
+  }
+  else {
+    onCancel();
+  }
+  job.work.reset();
+}
+
+} // namespace v2
+} // namespace security
+} // namespace ndn
@@ -0,0 +1,154 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2013-2017 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#ifndef NDN_SECURITY_V2_VERIFICATION_POOL_HPP
+#define NDN_SECURITY_V2_VERIFICATION_POOL_HPP
+
+#include "../../common.hpp"
+
+#include <boost/asio/io_service.hpp>
+
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+
+namespace ndn {
+namespace security {
+namespace v2 {
+
+/**
+ * @brief Pool of worker threads for signature verification
+ *
+ * Jobs are placed in a bounded queue and executed by the worker threads.  When a job
+ * finishes, its completion handler is posted to the io_service given to the constructor,
+ * so that validation callbacks are invoked on the thread that drives the Validator.
+ * Exactly one of the completion and cancellation handlers of a queued job is invoked, and
+ * both are invoked and destroyed on the io_service.
+ *
+ * While a job is queued or running, the io_service is kept from running out of work.
+ *
+ * @sa Validator::setVerificationPool
+ */
+class VerificationPool : noncopyable
+{
+public:
+  class Error : public std::runtime_error
+  {
+  public:
+    explicit
+    Error(const std::string& what)
+      : std::runtime_error(what)
+    {
+    }
+  };
+
+  /**
+   * @brief Start @p nThreads worker threads
+   *
+   * @param io           io_service on which completion handlers are invoked
+   * @param nThreads     number of worker threads, must be positive
+   * @param maxQueueSize maximum number of jobs waiting for a worker thread, must be positive
+   * @throw Error @p nThreads or @p maxQueueSize is zero
+   */
+  VerificationPool(boost::asio::io_service& io, size_t nThreads, size_t maxQueueSize = 1024);
+
+  /**
+   * @brief Stop and join the worker threads
+   *
+   * Jobs still in the queue are not executed.  The cancellation handler is posted to the
+   * io_service for each of them, and is invoked instead of the completion handler for jobs
+   * whose completion has not been invoked yet.  Must be called from the thread that runs
+   * the io_service.
+   */
+  ~VerificationPool();
+
+  /**
+   * @brief Queue a job for execution on a worker thread
+   *
+   * @param job        function executed on a worker thread; it must not throw and must not
+   *                   access objects that can be used concurrently by other threads.  It is
+   *                   destroyed on the worker thread right after it returns, before
+   *                   @p onComplete can be invoked.
+   * @param onComplete function invoked on the io_service after @p job returns
+   * @param onCancel   function invoked on the io_service instead of @p onComplete, if the pool
+   *                   is destroyed before @p onComplete is invoked.  It must not access the
+   *                   owner of the pool.
+   * @retval true the job has been queued
+   * @retval false the queue is full; none of the functions will be invoked
+   */
+  bool
+  post(const std::function<void()>& job, const std::function<void()>& onComplete,
+       const std::function<void()>& onCancel);
+
+  size_t
+  getNThreads() const
+  {
+    return m_threads.size();
+  }
+
+  size_t
+  getMaxQueueSize() const
+  {
+    return m_maxQueueSize;
+  }
+
+private:
+  void
+  run();
+
+  struct Job
+  {
+    std::function<void()> job;
+    std::function<void()> onComplete;
+    std::function<void()> onCancel;
+    shared_ptr<boost::asio::io_service::work> work;
+  };
+
+  /**
+   * @brief Invoke and destroy the completion or cancellation handler of @p job
+   *
+   * Executed on the io_service, so that objects captured by the handlers are released there
+   * regardless of which thread drops the last reference to @p job.
+   */
+  static void
+  finish(Job& job, bool isCompleted);
+
+private:
+  boost::asio::io_service& m_io;
+  const size_t m_maxQueueSize;
+
+  std::mutex m_mutex;
+  std::condition_variable m_cv;
+  std::deque<shared_ptr<Job>> m_queue;
+  bool m_shouldStop;
+
+  /// cleared on destruction to turn completions already posted to the io_service into cancellations
+  shared_ptr<bool> m_isAlive;
+
+  std::vector<std::thread> m_threads;
+};
+
+} // namespace v2
+} // namespace security
+} // namespace ndn
+
+#endif // NDN_SECURITY_V2_VERIFICATION_POOL_HPP
@@ -22,12 +22,17 @@
 #include "validator-config.hpp"
 #include "certificate-cache-ttl.hpp"
 #include "../util/io.hpp"
+#include "transform/fused-pipeline.hpp"
 #include "../lp/tags.hpp"
 
 #include <boost/filesystem.hpp>
 #include <boost/property_tree/info_parser.hpp>
 #include <boost/algorithm/string.hpp>
 
+#include <fstream>
+
+#include <sys/stat.h>
+
 namespace ndn {
 namespace security {
 
@@ -119,8 +124,6 @@ ValidatorConfig::load(const security::conf::ConfigSection& configSection,
 {
   BOOST_ASSERT(!filename.empty());
 
-  reset();
-
   if (configSection.begin() == configSection.end()) {
     std::string msg = "Error processing configuration file";
     msg += ": ";
@@ -129,25 +132,75 @@ ValidatorConfig::load(const security::conf::ConfigSection& configSection,
     BOOST_THROW_EXCEPTION(security::conf::Error(msg));
   }
 
-  for (security::conf::ConfigSection::const_iterator i = configSection.begin();
-       i != configSection.end(); ++i) {
-    const std::string& sectionName = i->first;
-    const security::conf::ConfigSection& section = i->second;
+  // Build the new configuration on empty containers and put the current one back
+  // if the new one cannot be processed, so that a bad reload keeps the old policy.
+  bool oldShouldValidate = m_shouldValidate;
+  InterestRuleList oldInterestRules;
+  DataRuleList oldDataRules;
+  security::conf::RuleIndex<Interest> oldInterestRuleIndex;
+  security::conf::RuleIndex<Data> oldDataRuleIndex;
+  AnchorList oldAnchors;
+  TrustAnchorContainer oldStaticContainer;
+  DynamicContainers oldDynamicContainers;
+
+  auto swapRules = [&] {
+    std::swap(m_interestRules, oldInterestRules);
+    std::swap(m_dataRules, oldDataRules);
+    std::swap(m_interestRuleIndex, oldInterestRuleIndex);
+    std::swap(m_dataRuleIndex, oldDataRuleIndex);
+  };
+  auto swapConfig = [&] {
+    swapRules();
+    std::swap(m_anchors, oldAnchors);
+    std::swap(m_staticContainer, oldStaticContainer);
+    std::swap(m_dynamicContainers, oldDynamicContainers);
+  };
+  swapConfig();
+
+  // Filters and checkers, including their regular expressions, are kept if nothing they are
+  // built from has changed.  Trust anchors are always processed, relying on m_anchorFileCache.
+  Digest rulesDigest = computeRulesDigest(configSection, filename);
+  bool isRulesReused = m_rulesDigest && *m_rulesDigest == rulesDigest;
+  if (isRulesReused) {
+    swapRules();
+  }
 
-    if (boost::iequals(sectionName, "rule")) {
-      onConfigRule(section, filename);
-    }
-    else if (boost::iequals(sectionName, "trust-anchor")) {
-      onConfigTrustAnchor(section, filename);
+  try {
+    for (security::conf::ConfigSection::const_iterator i = configSection.begin();
+         i != configSection.end(); ++i) {
+      const std::string& sectionName = i->first;
+      const security::conf::ConfigSection& section = i->second;
+
+      if (boost::iequals(sectionName, "rule")) {
+        if (!isRulesReused) {
+          onConfigRule(section, filename);
+        }
+      }
+      else if (boost::iequals(sectionName, "trust-anchor")) {
+        onConfigTrustAnchor(section, filename);
+      }
+      else {
+        std::string msg = "Error processing configuration file";
+        msg += " ";
+        msg += filename;
+        msg += " unrecognized section: " + sectionName;
+        BOOST_THROW_EXCEPTION(security::conf::Error(msg));
+      }
     }
-    else {
-      std::string msg = "Error processing configuration file";
-      msg += " ";
-      msg += filename;
-      msg += " unrecognized section: " + sectionName;
-      BOOST_THROW_EXCEPTION(security::conf::Error(msg));
+  }
+  catch (...) {
+    if (isRulesReused) {
+      swapRules();
     }
+    swapConfig();
+    m_shouldValidate = oldShouldValidate;
+    throw;
   }
+  m_rulesDigest = rulesDigest;
+
+  if (m_certificateCache != nullptr)
+    m_certificateCache->reset();
+  m_anchorFileCache.prune();
 }
 
 void
@@ -219,6 +272,7 @@ ValidatorConfig::onConfigRule(const security::conf::ConfigSection& configSection
       rule->addChecker(checker);
 
     m_dataRules.push_back(rule);
+    m_dataRuleIndex.insert(rule);
   }
   else {
     shared_ptr<InterestRule> rule = make_shared<InterestRule>(ruleId);;
@@ -228,6 +282,7 @@ ValidatorConfig::onConfigRule(const security::conf::ConfigSection& configSection
       rule->addChecker(checker);
 
     m_interestRules.push_back(rule);
+    m_interestRuleIndex.insert(rule);
   }
 }
 
@@ -260,7 +315,7 @@ ValidatorConfig::onConfigTrustAnchor(const security::conf::ConfigSection& config
       BOOST_THROW_EXCEPTION(Error("Expect the end of trust-anchor!"));
 
     path certfilePath = absolute(file, path(filename).parent_path());
-    auto idCert = io::load<v1::IdentityCertificate>(certfilePath.string());
+    auto idCert = m_anchorFileCache.load(certfilePath);
 
     if (idCert != nullptr) {
       BOOST_ASSERT(idCert->getName().size() >= 1);
@@ -332,7 +387,7 @@ ValidatorConfig::onConfigTrustAnchor(const security::conf::ConfigSection& config
       directory_iterator end;
 
       for (directory_iterator it(dirPath); it != end; it++) {
-        auto idCert = io::load<v1::IdentityCertificate>(it->path().string());
+        auto idCert = m_anchorFileCache.load(it->path());
 
         if (idCert != nullptr)
           m_staticContainer.add(idCert);
@@ -355,12 +410,15 @@ ValidatorConfig::reset()
     m_certificateCache->reset();
   m_interestRules.clear();
   m_dataRules.clear();
+  m_interestRuleIndex.clear();
+  m_dataRuleIndex.clear();
 
   m_anchors.clear();
 
   m_staticContainer = TrustAnchorContainer();
 
   m_dynamicContainers.clear();
+  m_rulesDigest = nullopt;
 }
 
 bool
@@ -417,7 +475,7 @@ ValidatorConfig::refreshAnchors()
        cIt != m_dynamicContainers.end() && cIt->getLastRefresh() + cIt->getRefreshPeriod() < now;
        cIt++) {
     isRefreshed = true;
-    cIt->refresh();
+    cIt->refresh(m_anchorFileCache);
     cIt->setLastRefresh(now);
   }
 
@@ -449,20 +507,12 @@ ValidatorConfig::checkPolicy(const Data& data,
   if (!m_shouldValidate)
     return onValidated(data.shared_from_this());
 
-  bool isMatched = false;
-  int8_t checkResult = -1;
-
-  for (const auto& dataRule : m_dataRules) {
-    if (dataRule->match(data)) {
-      isMatched = true;
-      checkResult = dataRule->check(data, onValidated, onValidationFailed);
-      break;
-    }
-  }
-
-  if (!isMatched)
+  shared_ptr<DataRule> dataRule = m_dataRuleIndex.findMatch(data);
+  if (dataRule == nullptr)
     return onValidationFailed(data.shared_from_this(), "No rule matched!");
 
+  int8_t checkResult = dataRule->check(data, onValidated, onValidationFailed);
+
   if (checkResult == 0) {
     const Signature& signature = data.getSignature();
     checkSignature(data, signature, nSteps,
@@ -501,23 +551,15 @@ ValidatorConfig::checkPolicy(const Interest& interest,
 
     Name keyName = v1::IdentityCertificate::certificateNameToPublicKeyName(keyLocator.getName());
 
-    bool isMatched = false;
-    int8_t checkResult = -1;
-
-    for (const auto& interestRule : m_interestRules) {
-      if (interestRule->match(interest)) {
-        isMatched = true;
-        checkResult = interestRule->check(interest,
-                                          bind(&ValidatorConfig::checkTimestamp, this, _1,
-                                               keyName, onValidated, onValidationFailed),
-                                          onValidationFailed);
-        break;
-      }
-    }
-
-    if (!isMatched)
+    shared_ptr<InterestRule> interestRule = m_interestRuleIndex.findMatch(interest);
+    if (interestRule == nullptr)
       return onValidationFailed(interest.shared_from_this(), "No rule matched!");
 
+    int8_t checkResult = interestRule->check(interest,
+                                             bind(&ValidatorConfig::checkTimestamp, this, _1,
+                                                  keyName, onValidated, onValidationFailed),
+                                             onValidationFailed);
+
     if (checkResult == 0) {
       checkSignature<Interest, OnInterestValidated, OnInterestValidationFailed>
         (interest, signature, nSteps,
@@ -619,8 +661,113 @@ ValidatorConfig::cleanOldKeys()
     m_lastTimestamp.erase(oldestKeyIt);
 }
 
+optional<ValidatorConfig::FileStatus>
+ValidatorConfig::getFileStatus(const boost::filesystem::path& path)
+{
+  struct stat st;
+  if (::stat(path.c_str(), &st) != 0) {
+    return nullopt;
+  }
+
+#ifdef __APPLE__
+  const struct timespec& mtime = st.st_mtimespec;
+  const struct timespec& ctime = st.st_ctimespec;
+#else
+  const struct timespec& mtime = st.st_mtim;
+  const struct timespec& ctime = st.st_ctim;
+#endif // __APPLE__
+
+  FileStatus status;
+  status.device = static_cast<uint64_t>(st.st_dev);
+  status.inode = static_cast<uint64_t>(st.st_ino);
+  status.size = static_cast<uint64_t>(st.st_size);
+  status.mtime = static_cast<int64_t>(mtime.tv_sec) * 1000000000 + mtime.tv_nsec;
+  status.ctime = static_cast<int64_t>(ctime.tv_sec) * 1000000000 + ctime.tv_nsec;
+  return status;
+}
+
+ValidatorConfig::Digest
+ValidatorConfig::computeRulesDigest(const security::conf::ConfigSection& configSection,
+                                    const std::string& filename)
+{
+  using namespace boost::filesystem;
+
+  std::ostringstream os;
+  os << filename << '\n';
+  for (const auto& section : configSection) {
+    if (!boost::iequals(section.first, "rule")) {
+      continue;
+    }
+    boost::property_tree::write_info(os, section.second);
+
+    // fixed-signer checkers read their signer certificate files when the rule is built
+    for (const auto& checker : section.second) {
+      if (!boost::iequals(checker.first, "checker")) {
+        continue;
+      }
+      for (const auto& signer : checker.second) {
+        if (!boost::iequals(signer.first, "signer") ||
+            !boost::iequals(signer.second.get<std::string>("type", ""), "file")) {
+          continue;
+        }
+        path certfilePath = absolute(signer.second.get<std::string>("file-name", ""),
+                                     path(filename).parent_path());
+        os << certfilePath.native() << '\n';
+        optional<FileStatus> status = getFileStatus(certfilePath);
+        if (status) {
+          os << status->device << ' ' << status->inode << ' ' << status->size << ' '
+             << status->mtime << ' ' << status->ctime << '\n';
+        }
+      }
+    }
+  }
+  const std::string& sources = os.str();
+
+  Digest digest;
+  size_t digestSize = 0;
+  security::transform::fused::DigestPipeline pipeline(
+    security::transform::fused::BufferSink(digest.data(), digest.size(), digestSize),
+    DigestAlgorithm::SHA256);
+  pipeline.write(reinterpret_cast<const uint8_t*>(sources.data()), sources.size());
+  pipeline.end();
+  BOOST_ASSERT(digestSize == digest.size());
+  return digest;
+}
+
+shared_ptr<v1::IdentityCertificate>
+ValidatorConfig::AnchorFileCache::load(const boost::filesystem::path& path)
+{
+  optional<FileStatus> status = getFileStatus(path);
+  if (!status) {
+    m_entries.erase(path);
+    return nullptr;
+  }
+
+  auto it = m_entries.find(path);
+  if (it != m_entries.end() && it->second.status == *status) {
+    return it->second.certificate;
+  }
+
+  Entry& entry = m_entries[path];
+  entry.status = *status;
+  entry.certificate = io::load<v1::IdentityCertificate>(path.string());
+  return entry.certificate;
+}
+
+void
+ValidatorConfig::AnchorFileCache::prune()
+{
+  for (auto it = m_entries.begin(); it != m_entries.end();) {
+    boost::system::error_code ec;
+    if (!boost::filesystem::exists(it->first, ec))
+      it = m_entries.erase(it);
+    else
+      ++it;
+  }
+}
+
 void
-ValidatorConfig::DynamicTrustAnchorContainer::refresh()
+ValidatorConfig::DynamicTrustAnchorContainer::refresh(AnchorFileCache& fileCache)
 {
   using namespace boost::filesystem;
 
@@ -630,14 +777,14 @@ ValidatorConfig::DynamicTrustAnchorContainer::refresh()
     directory_iterator end;
 
     for (directory_iterator it(m_path); it != end; it++) {
-      auto idCert = io::load<v1::IdentityCertificate>(it->path().string());
+      auto idCert = fileCache.load(it->path());
 
       if (idCert != nullptr)
         m_certificates.push_back(idCert);
     }
   }
   else {
-    auto idCert = io::load<v1::IdentityCertificate>(m_path.string());
+    auto idCert = fileCache.load(m_path);
 
     if (idCert != nullptr)
       m_certificates.push_back(idCert);
@@ -25,8 +25,12 @@
 #include "validator.hpp"
 #include "certificate-cache.hpp"
 #include "conf/rule.hpp"
+#include "conf/rule-index.hpp"
 #include "conf/common.hpp"
 
+#include <array>
+#include <tuple>
+
 namespace ndn {
 namespace security {
 
@@ -151,6 +155,84 @@ private:
   void
   cleanOldKeys();
 
+  /**
+   * @brief identity and change times of a file, as reported by stat(2)
+   */
+  struct FileStatus
+  {
+    uint64_t device;
+    uint64_t inode;
+    uint64_t size;
+    int64_t mtime; ///< nanoseconds since the epoch
+    int64_t ctime; ///< nanoseconds since the epoch
+
+    bool
+    operator==(const FileStatus& other) const
+    {
+      return std::tie(device, inode, size, mtime, ctime) ==
+             std::tie(other.device, other.inode, other.size, other.mtime, other.ctime);
+    }
+  };
+
+  /**
+   * @return status of the file at @p path, or nullopt if it cannot be read
+   */
+  static optional<FileStatus>
+  getFileStatus(const boost::filesystem::path& path);
+
+  typedef std::array<uint8_t, 32> Digest;
+
+  /**
+   * @brief SHA-256 digest of everything the rules are built from
+   *
+   * This covers @p filename, the rule sections of @p configSection, and the status of
+   * the signer certificate files named in fixed-signer checkers.
+   */
+  static Digest
+  computeRulesDigest(const security::conf::ConfigSection& configSection,
+                     const std::string& filename);
+
+  /**
+   * @brief Cache of trust anchor certificates decoded from files
+   *
+   * An entry is reused as long as the status of its file, i.e., its device, inode, size,
+   * modification and change times, is unchanged, so reloading the configuration or
+   * refreshing a trust anchor directory reads and decodes only files that changed since
+   * they were last read.  Replacing an anchor by renaming a new file over it always changes
+   * the inode.
+   */
+  class AnchorFileCache
+  {
+  public:
+    /**
+     * @brief Get the certificate stored in @p path, decoding the file only if it changed
+     * @return the certificate, or nullptr if the file cannot be read or decoded
+     */
+    shared_ptr<v1::IdentityCertificate>
+    load(const boost::filesystem::path& path);
+
+    /**
+     * @brief Remove entries of files that no longer exist
+     */
+    void
+    prune();
+
+    size_t
+    size() const
+    {
+      return m_entries.size();
+    }
+
+  private:
+    struct Entry
+    {
+      FileStatus status;
+      shared_ptr<v1::IdentityCertificate> certificate;
+    };
+
+    std::map<boost::filesystem::path, Entry> m_entries;
+  };
+
   class TrustAnchorContainer
   {
   public:
@@ -200,7 +282,7 @@ private:
     }
 
     void
-    refresh();
+    refresh(AnchorFileCache& fileCache);
 
   private:
     boost::filesystem::path m_path;
@@ -243,10 +325,15 @@ NDN_CXX_PUBLIC_WITH_TESTS_ELSE_PRIVATE:
 
   InterestRuleList m_interestRules;
   DataRuleList m_dataRules;
+  security::conf::RuleIndex<Interest> m_interestRuleIndex;
+  security::conf::RuleIndex<Data> m_dataRuleIndex;
 
   AnchorList m_anchors;
   TrustAnchorContainer m_staticContainer;
   DynamicContainers m_dynamicContainers;
+  AnchorFileCache m_anchorFileCache;
+  /// digest of the sources of the current rules; rules are not rebuilt while it is unchanged
+  optional<Digest> m_rulesDigest;
 
   time::milliseconds m_graceInterval;
   size_t m_maxTrackedKeys;
@@ -29,6 +29,11 @@
 #include "security/transform.hpp"
 #include "security/v2/certificate.hpp"
 #include "security/detail/openssl.hpp"
+#include "security/detail/openssl-helper.hpp"
+
+#include <map>
+#include <numeric>
+#include <thread>
 
 namespace ndn {
 namespace security {
@@ -40,8 +45,9 @@ verifySignature(const uint8_t* blob, size_t blobLen, const uint8_t* sig, size_t
   bool result = false;
   try {
     using namespace transform;
-    bufferSource(blob, blobLen) >> verifierFilter(DigestAlgorithm::SHA256, pKey, sig, sigLen)
-                                >> boolSink(result);
+    fused::VerifierPipeline pipeline(fused::BoolSink(result), DigestAlgorithm::SHA256, pKey, sig, sigLen);
+    pipeline.write(blob, blobLen);
+    pipeline.end();
   }
   catch (const transform::Error&) {
     return false;
@@ -184,6 +190,134 @@ verifySignature(const Interest& interest, const v2::Certificate& cert)
   return verifySignature(parse(interest), cert.getContent().value(), cert.getContent().value_size());
 }
 
+namespace {
+
+struct BatchItem
+{
+  std::tuple<bool, const uint8_t*, size_t, const uint8_t*, size_t> params;
+  EVP_PKEY* key; ///< nullptr if the public key cannot be decoded
+};
+
+struct KeyBits
+{
+  const uint8_t* buf;
+  size_t size;
+
+  bool
+  operator<(const KeyBits& other) const
+  {
+    return std::lexicographical_compare(buf, buf + size, other.buf, other.buf + other.size);
+  }
+};
+
+} // namespace
+
+static bool
+verifySignature(detail::EvpMdCtx& ctx, const BatchItem& item)
+{
+  bool isParsable = false;
+  const uint8_t* buf = nullptr;
+  size_t bufLen = 0;
+  const uint8_t* sig = nullptr;
+  size_t sigLen = 0;
+
+  std::tie(isParsable, buf, bufLen, sig, sigLen) = item.params;
+
+  if (!isParsable || item.key == nullptr)
+    return false;
+
+  bool result = EVP_DigestVerifyInit(ctx.get(), nullptr, EVP_sha256(), nullptr, item.key) == 1 &&
+                EVP_DigestVerifyUpdate(ctx.get(), buf, bufLen) == 1 &&
+                // OpenSSL < 1.0.2 takes a non-const signature buffer, but does not modify it
+                EVP_DigestVerifyFinal(ctx.get(), const_cast<uint8_t*>(sig), sigLen) == 1;
+  ctx.reset();
+  return result;
+}
+
+static void
+verifySignatures(const std::vector<BatchItem>& items,
+                 std::vector<size_t>::const_iterator first, std::vector<size_t>::const_iterator last,
+                 std::vector<uint8_t>& results)
+{
+  // one context per thread, reused for every packet in the range
+  detail::EvpMdCtx ctx;
+  for (; first != last; ++first) {
+    results[*first] = verifySignature(ctx, items[*first]);
+  }
+}
+
+template<class Packet>
+static std::vector<bool>
+verifySignatures(const std::vector<std::pair<const Packet*, const v2::Certificate*>>& packets,
+                 size_t nThreads)
+{
+  std::map<KeyBits, size_t> keyIndex;
+  std::vector<unique_ptr<detail::EvpPkey>> keys;
+  std::vector<BatchItem> items;
+  std::vector<size_t> keyOf; // index in keys of the public key of each item
+  items.reserve(packets.size());
+  keyOf.reserve(packets.size());
+
+  for (const auto& packet : packets) {
+    BOOST_ASSERT(packet.first != nullptr && packet.second != nullptr);
+    const Block& content = packet.second->getContent();
+
+    auto it = keyIndex.find({content.value(), content.value_size()});
+    if (it == keyIndex.end()) {
+      unique_ptr<detail::EvpPkey> key(new detail::EvpPkey);
+      const uint8_t* buf = content.value();
+      if (d2i_PUBKEY(&(*key), &buf, content.value_size()) == nullptr)
+        key.reset();
+      it = keyIndex.emplace(KeyBits{content.value(), content.value_size()}, keys.size()).first;
+      keys.push_back(std::move(key));
+    }
+
+    const unique_ptr<detail::EvpPkey>& key = keys[it->second];
+    items.push_back({parse(*packet.first), key == nullptr ? nullptr : key->get()});
+    keyOf.push_back(it->second);
+  }
+
+  // positions in items, grouped by public key
+  std::vector<size_t> order(items.size());
+  std::iota(order.begin(), order.end(), 0);
+  std::stable_sort(order.begin(), order.end(),
+                   [&keyOf] (size_t a, size_t b) { return keyOf[a] < keyOf[b]; });
+
+  std::vector<uint8_t> results(items.size(), 0);
+  nThreads = std::max<size_t>(1, std::min(nThreads, items.size()));
+  size_t chunkSize = (items.size() + nThreads - 1) / nThreads;
+
+  std::vector<std::thread> threads;
+  for (size_t i = 1; i < nThreads; ++i) {
+    auto first = order.cbegin() + std::min(i * chunkSize, order.size());
+    auto last = order.cbegin() + std::min((i + 1) * chunkSize, order.size());
+    threads.emplace_back([&items, first, last, &results] {
+      verifySignatures(items, first, last, results);
+    });
+  }
+  verifySignatures(items, order.cbegin(), order.cbegin() + std::min(chunkSize, order.size()), results);
+
+  for (std::thread& thread : threads) {
+    thread.join();
+  }
+
+  return std::vector<bool>(results.begin(), results.end());
+}
+
+std::vector<bool>
+verifySignatures(const std::vector<std::pair<const Data*, const v2::Certificate*>>& items,
+                 size_t nThreads)
+{
+  return verifySignatures<Data>(items, nThreads);
+}
+
+std::vector<bool>
+verifySignatures(const std::vector<std::pair<const Interest*, const v2::Certificate*>>& items,
+                 size_t nThreads)
+{
+  return verifySignatures<Interest>(items, nThreads);
+}
+
 ///////////////////////////////////////////////////////////////////////
 
 bool
@@ -112,6 +112,31 @@ verifySignature(const Data& data, const v2::Certificate& cert);
 bool
 verifySignature(const Interest& interest, const v2::Certificate& cert);
 
+/**
+ * @brief Verify a batch of Data packets, each against the public key in its paired certificate
+ *
+ * Each distinct public key is decoded only once, and packets are verified with a signature
+ * context that is reused across the whole batch instead of a transform pipeline per packet.
+ * Packets signed with the same key are verified consecutively.
+ *
+ * @param items    pairs of (packet, certificate); both pointers must be non-null
+ * @param nThreads number of threads used for verification; 0 is treated as 1.
+ *                 Additional threads are created for the duration of the call only.
+ * @return verification results, in the same order as @p items
+ */
+std::vector<bool>
+verifySignatures(const std::vector<std::pair<const Data*, const v2::Certificate*>>& items,
+                 size_t nThreads = 1);
+
+/**
+ * @brief Verify a batch of signed Interests, each against the public key in its paired certificate
+ * @note This method verifies only signature of the signed interests
+ * @sa verifySignatures(const std::vector<std::pair<const Data*, const v2::Certificate*>>&, size_t)
+ */
+std::vector<bool>
+verifySignatures(const std::vector<std::pair<const Interest*, const v2::Certificate*>>& items,
+                 size_t nThreads = 1);
+
 //////////////////////////////////////////////////////////////////
 
 /**
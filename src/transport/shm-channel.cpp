@@ -0,0 +1,262 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2013-2017 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#include "shm-channel.hpp"
+#include "../encoding/block-helpers.hpp"
+#include "../util/random.hpp"
+
+#include <cerrno>
+#include <cstring>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#ifdef NDN_CXX_HAVE_EVENTFD
+#include <sys/eventfd.h>
+#endif // NDN_CXX_HAVE_EVENTFD
+
+namespace ndn {
+
+const size_t ShmChannel::DEFAULT_RING_CAPACITY = 1 << 20;
+
+static const size_t N_REQUEST_FDS = 3; // region, client wakeup, server wakeup
+
+static std::string
+makeErrorMessage(const std::string& what)
+{
+  return what + ": " + std::strerror(errno);
+}
+
+static void
+closeFd(int fd)
+{
+  if (fd >= 0) {
+    ::close(fd);
+  }
+}
+
+ShmChannel::ShmChannel(int regionFd, size_t ringCapacity, bool isClient,
+                       int localWakeupFd, int peerWakeupFd)
+  : m_regionFd(regionFd)
+  , m_region(MAP_FAILED)
+  , m_regionSize(2 * ShmRing::getRegionSize(ringCapacity))
+  , m_localWakeupFd(localWakeupFd)
+  , m_peerWakeupFd(peerWakeupFd)
+{
+  try {
+    m_region = ::mmap(nullptr, m_regionSize, PROT_READ | PROT_WRITE, MAP_SHARED, m_regionFd, 0);
+    if (m_region == MAP_FAILED) {
+      BOOST_THROW_EXCEPTION(Error(makeErrorMessage("mmap")));
+    }
+
+    // the first ring carries blocks from the client to the server
+    uint8_t* clientToServer = reinterpret_cast<uint8_t*>(m_region);
+    uint8_t* serverToClient = clientToServer + ShmRing::getRegionSize(ringCapacity);
+    try {
+      unique_ptr<ShmRing> upstream(new ShmRing(clientToServer, ringCapacity, isClient));
+      unique_ptr<ShmRing> downstream(new ShmRing(serverToClient, ringCapacity, isClient));
+      m_sendRing = std::move(isClient ? upstream : downstream);
+      m_receiveRing = std::move(isClient ? downstream : upstream);
+    }
+    catch (const ShmRing::Error& e) {
+      BOOST_THROW_EXCEPTION(Error(e.what()));
+    }
+  }
+  catch (const Error&) {
+    if (m_region != MAP_FAILED) {
+      ::munmap(m_region, m_regionSize);
+    }
+    closeFd(m_regionFd);
+    closeFd(m_localWakeupFd);
+    closeFd(m_peerWakeupFd);
+    throw;
+  }
+}
+
+ShmChannel::~ShmChannel()
+{
+  m_sendRing.reset();
+  m_receiveRing.reset();
+  ::munmap(m_region, m_regionSize);
+  closeFd(m_regionFd);
+  closeFd(m_localWakeupFd);
+  closeFd(m_peerWakeupFd);
+}
+
+unique_ptr<ShmChannel>
+ShmChannel::create(size_t ringCapacity)
+{
+#ifdef NDN_CXX_HAVE_EVENTFD
+  std::string name = "/ndn-cxx-shm-" + to_string(::getpid()) + "-" +
+                     to_string(random::generateWord32());
+  int regionFd = ::shm_open(name.c_str(), O_RDWR | O_CREAT | O_EXCL, 0600);
+  if (regionFd < 0) {
+    BOOST_THROW_EXCEPTION(Error(makeErrorMessage("shm_open")));
+  }
+  // the region is passed by file descriptor and needs no name
+  ::shm_unlink(name.c_str());
+
+  if (::ftruncate(regionFd, 2 * ShmRing::getRegionSize(ringCapacity)) != 0) {
+    std::string message = makeErrorMessage("ftruncate");
+    closeFd(regionFd);
+    BOOST_THROW_EXCEPTION(Error(message));
+  }
+
+  int clientWakeupFd = ::eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+  int serverWakeupFd = ::eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+  if (clientWakeupFd < 0 || serverWakeupFd < 0) {
+    std::string message = makeErrorMessage("eventfd");
+    closeFd(regionFd);
+    closeFd(clientWakeupFd);
+    closeFd(serverWakeupFd);
+    BOOST_THROW_EXCEPTION(Error(message));
+  }
+
+  return unique_ptr<ShmChannel>(new ShmChannel(regionFd, ringCapacity, true,
+                                               clientWakeupFd, serverWakeupFd));
+#else
+  BOOST_THROW_EXCEPTION(Error("shared memory channel is not supported on this platform"));
+#endif // NDN_CXX_HAVE_EVENTFD
+}
+
+void
+ShmChannel::sendRequest(int socketFd) const
+{
+  Block request = makeEmptyBlock(TLV_REQUEST);
+  iovec iov;
+  iov.iov_base = const_cast<uint8_t*>(request.wire());
+  iov.iov_len = request.size();
+
+  int fds[N_REQUEST_FDS] = {m_regionFd, m_localWakeupFd, m_peerWakeupFd};
+  union {
+    cmsghdr header;
+    uint8_t buffer[CMSG_SPACE(sizeof(fds))];
+  } control;
+  std::memset(&control, 0, sizeof(control));
+
+  msghdr msg;
+  std::memset(&msg, 0, sizeof(msg));
+  msg.msg_iov = &iov;
+  msg.msg_iovlen = 1;
+  msg.msg_control = control.buffer;
+  msg.msg_controllen = sizeof(control.buffer);
+
+  cmsghdr* cmsg = CMSG_FIRSTHDR(&msg);
+  cmsg->cmsg_level = SOL_SOCKET;
+  cmsg->cmsg_type = SCM_RIGHTS;
+  cmsg->cmsg_len = CMSG_LEN(sizeof(fds));
+  std::memcpy(CMSG_DATA(cmsg), fds, sizeof(fds));
+
+  ssize_t nSent = 0;
+  do {
+    nSent = ::sendmsg(socketFd, &msg, 0);
+  } while (nSent < 0 && errno == EINTR);
+
+  if (nSent < 0) {
+    BOOST_THROW_EXCEPTION(Error(makeErrorMessage("sendmsg")));
+  }
+  if (static_cast<size_t>(nSent) != request.size()) {
+    BOOST_THROW_EXCEPTION(Error("request has been partially sent"));
+  }
+}
+
+unique_ptr<ShmChannel>
+ShmChannel::receiveRequest(int socketFd)
+{
+  Block expected = makeEmptyBlock(TLV_REQUEST);
+  std::vector<uint8_t> buffer(expected.size());
+  iovec iov;
+  iov.iov_base = buffer.data();
+  iov.iov_len = buffer.size();
+
+  union {
+    cmsghdr header;
+    uint8_t buffer[CMSG_SPACE(sizeof(int) * N_REQUEST_FDS)];
+  } control;
+  std::memset(&control, 0, sizeof(control));
+
+  msghdr msg;
+  std::memset(&msg, 0, sizeof(msg));
+  msg.msg_iov = &iov;
+  msg.msg_iovlen = 1;
+  msg.msg_control = control.buffer;
+  msg.msg_controllen = sizeof(control.buffer);
+
+  ssize_t nReceived = 0;
+  do {
+    nReceived = ::recvmsg(socketFd, &msg, MSG_WAITALL | MSG_CMSG_CLOEXEC);
+  } while (nReceived < 0 && errno == EINTR);
+
+  if (nReceived < 0) {
+    BOOST_THROW_EXCEPTION(Error(makeErrorMessage("recvmsg")));
+  }
+
+  int fds[N_REQUEST_FDS] = {-1, -1, -1};
+  cmsghdr* cmsg = CMSG_FIRSTHDR(&msg);
+  bool hasFds = cmsg != nullptr && cmsg->cmsg_level == SOL_SOCKET &&
+                cmsg->cmsg_type == SCM_RIGHTS && cmsg->cmsg_len == CMSG_LEN(sizeof(fds));
+  if (hasFds) {
+    std::memcpy(fds, CMSG_DATA(cmsg), sizeof(fds));
+  }
+
+  auto fail = [&fds] (const std::string& message) {
+    for (int fd : fds) {
+      closeFd(fd);
+    }
+    BOOST_THROW_EXCEPTION(Error(message));
+  };
+
+  if (static_cast<size_t>(nReceived) != buffer.size() ||
+      !std::equal(buffer.begin(), buffer.end(), expected.wire())) {
+    fail("first block on the socket is not a shared memory channel request");
+  }
+  if (!hasFds || (msg.msg_flags & MSG_CTRUNC) != 0) {
+    fail("shared memory channel request does not carry the expected file descriptors");
+  }
+
+  struct stat st;
+  if (::fstat(fds[0], &st) != 0) {
+    fail(makeErrorMessage("fstat"));
+  }
+  size_t regionSize = static_cast<size_t>(st.st_size);
+  if (regionSize % 2 != 0 || regionSize / 2 < ShmRing::getRegionSize(0)) {
+    fail("shared memory region has an invalid size");
+  }
+  size_t ringCapacity = regionSize / 2 - ShmRing::getRegionSize(0);
+
+  return unique_ptr<ShmChannel>(new ShmChannel(fds[0], ringCapacity, false, fds[2], fds[1]));
+}
+
+void
+ShmChannel::notifyPeer()
+{
+  uint64_t one = 1;
+  // EAGAIN means the counter is saturated and the peer will be woken up anyway
+  ssize_t nWritten = 0;
+  do {
+    nWritten = ::write(m_peerWakeupFd, &one, sizeof(one));
+  } while (nWritten < 0 && errno == EINTR);
+}
+
+} // namespace ndn
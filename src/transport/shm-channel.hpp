@@ -0,0 +1,142 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2013-2017 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#ifndef NDN_TRANSPORT_SHM_CHANNEL_HPP
+#define NDN_TRANSPORT_SHM_CHANNEL_HPP
+
+#include "shm-ring.hpp"
+
+namespace ndn {
+
+/** \brief one endpoint of a pair of shared memory rings between two processes
+ *
+ *  A channel consists of a shared memory region holding two ShmRings, one in each
+ *  direction, and two eventfds used to wake up the consumer of each ring.
+ *
+ *  The client creates the channel and sends a request over a connected Unix stream socket.
+ *  The request is an empty TLV block of type TLV_REQUEST, accompanied by the file
+ *  descriptors of the region and of both eventfds.  A server that supports shared memory
+ *  receives the request with receiveRequest(), and responds with an empty TLV block of type
+ *  TLV_ACCEPT on the stream.  Both sides may use the rings afterwards.  A server that does
+ *  not support shared memory discards the request as an unknown TLV block, and the client
+ *  continues to use the stream.
+ *
+ *  \note Shared memory channels are available on platforms with eventfd.
+ */
+class ShmChannel : noncopyable
+{
+public:
+  class Error : public std::runtime_error
+  {
+  public:
+    explicit
+    Error(const std::string& what)
+      : std::runtime_error(what)
+    {
+    }
+  };
+
+  enum : uint32_t {
+    TLV_REQUEST = 32760,
+    TLV_ACCEPT = 32761
+  };
+
+  static const size_t DEFAULT_RING_CAPACITY;
+
+  /** \brief create a channel on the client side
+   *  \param ringCapacity capacity of each ring, see ShmRing
+   *  \throw Error shared memory or eventfd cannot be created
+   */
+  static unique_ptr<ShmChannel>
+  create(size_t ringCapacity = DEFAULT_RING_CAPACITY);
+
+  /** \brief receive a request on the server side
+   *
+   *  This blocks until the request has been received.  It must be invoked before anything
+   *  else is read from the socket.
+   *
+   *  \param socketFd connected Unix stream socket
+   *  \throw Error the request cannot be received, or is malformed
+   */
+  static unique_ptr<ShmChannel>
+  receiveRequest(int socketFd);
+
+  ~ShmChannel();
+
+  /** \brief send the request on the client side
+   *
+   *  This blocks until the request has been sent.  It must be invoked before anything else
+   *  is written to the socket.
+   *
+   *  \param socketFd connected Unix stream socket
+   *  \throw Error the request cannot be sent
+   */
+  void
+  sendRequest(int socketFd) const;
+
+  /** \return ring of blocks sent by this endpoint
+   */
+  ShmRing&
+  getSendRing()
+  {
+    return *m_sendRing;
+  }
+
+  /** \return ring of blocks received by this endpoint
+   */
+  ShmRing&
+  getReceiveRing()
+  {
+    return *m_receiveRing;
+  }
+
+  /** \return file descriptor that becomes readable when this endpoint is woken up
+   *
+   *  Reading 8 octets from the descriptor resets it.  The descriptor is non-blocking.
+   */
+  int
+  getWakeupFd() const
+  {
+    return m_localWakeupFd;
+  }
+
+  /** \brief wake up the other endpoint
+   */
+  void
+  notifyPeer();
+
+private:
+  ShmChannel(int regionFd, size_t ringCapacity, bool isClient,
+             int localWakeupFd, int peerWakeupFd);
+
+private:
+  int m_regionFd;
+  void* m_region;
+  size_t m_regionSize;
+  int m_localWakeupFd;
+  int m_peerWakeupFd;
+  unique_ptr<ShmRing> m_sendRing;
+  unique_ptr<ShmRing> m_receiveRing;
+};
+
+} // namespace ndn
+
+#endif // NDN_TRANSPORT_SHM_CHANNEL_HPP
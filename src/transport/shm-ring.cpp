@@ -0,0 +1,183 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2013-2017 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#include "shm-ring.hpp"
+#include "../encoding/tlv.hpp"
+
+#include <cstring>
+
+namespace ndn {
+
+static const size_t RECORD_ALIGNMENT = 8;
+static const size_t LENGTH_SIZE = sizeof(uint32_t);
+
+static size_t
+getRecordSize(size_t blockSize)
+{
+  return (LENGTH_SIZE + blockSize + RECORD_ALIGNMENT - 1) & ~(RECORD_ALIGNMENT - 1);
+}
+
+size_t
+ShmRing::getRegionSize(size_t capacity)
+{
+  return sizeof(Header) + capacity;
+}
+
+ShmRing::ShmRing(void* region, size_t capacity, bool shouldInitialize)
+  : m_header(reinterpret_cast<Header*>(region))
+  , m_data(reinterpret_cast<uint8_t*>(region) + sizeof(Header))
+  , m_capacity(capacity)
+{
+  if ((capacity & (capacity - 1)) != 0 || capacity < 4 * MAX_NDN_PACKET_SIZE) {
+    BOOST_THROW_EXCEPTION(Error("ring capacity must be a power of two not less than " +
+                                to_string(4 * MAX_NDN_PACKET_SIZE)));
+  }
+
+  if (shouldInitialize) {
+    new (m_header) Header;
+    m_header->head.store(0, std::memory_order_relaxed);
+    m_header->tail.store(0, std::memory_order_relaxed);
+    m_header->isProducerBlocked.store(0, std::memory_order_relaxed);
+    m_header->capacity = capacity;
+    std::atomic_thread_fence(std::memory_order_release);
+  }
+  else if (m_header->capacity != capacity) {
+    BOOST_THROW_EXCEPTION(Error("ring capacity mismatch"));
+  }
+}
+
+ShmRing::PushResult
+ShmRing::push(const Block& wire)
+{
+  const Block* parts[] = {&wire};
+  return this->push(parts, 1);
+}
+
+ShmRing::PushResult
+ShmRing::push(const Block& header, const Block& payload)
+{
+  const Block* parts[] = {&header, &payload};
+  return this->push(parts, 2);
+}
+
+ShmRing::PushResult
+ShmRing::push(const Block* const* parts, size_t nParts)
+{
+  size_t blockSize = 0;
+  for (size_t i = 0; i < nParts; ++i) {
+    blockSize += parts[i]->size();
+  }
+  if (blockSize > MAX_NDN_PACKET_SIZE) {
+    BOOST_THROW_EXCEPTION(Error("block size exceeds maximum limit"));
+  }
+
+  uint64_t head = m_header->head.load(std::memory_order_relaxed);
+  size_t offset = head & (m_capacity - 1);
+  size_t recordSize = getRecordSize(blockSize);
+  // the record starts at the beginning of the data area if it does not fit before the end
+  size_t padding = m_capacity - offset < recordSize ? m_capacity - offset : 0;
+
+  uint64_t tail = m_header->tail.load(std::memory_order_acquire);
+  if (head + padding + recordSize - tail > m_capacity) {
+    // the consumer wakes up the producer after making space; check again after setting the
+    // flag, in case the consumer emptied the ring before it could see the flag
+    m_header->isProducerBlocked.store(1, std::memory_order_seq_cst);
+    tail = m_header->tail.load(std::memory_order_seq_cst);
+    if (head + padding + recordSize - tail > m_capacity) {
+      return PushResult::FULL;
+    }
+  }
+
+  if (padding > 0) {
+    std::memset(m_data + offset, 0, LENGTH_SIZE);
+    offset = 0;
+  }
+
+  uint32_t length = static_cast<uint32_t>(blockSize);
+  std::memcpy(m_data + offset, &length, LENGTH_SIZE);
+  uint8_t* dest = m_data + offset + LENGTH_SIZE;
+  for (size_t i = 0; i < nParts; ++i) {
+    std::memcpy(dest, parts[i]->wire(), parts[i]->size());
+    dest += parts[i]->size();
+  }
+
+  uint64_t newHead = head + padding + recordSize;
+  // seq_cst store and load pair with those in pop(): either the consumer sees the new head
+  // before going to sleep, or the producer sees that everything before head was consumed
+  m_header->head.store(newHead, std::memory_order_seq_cst);
+  tail = m_header->tail.load(std::memory_order_seq_cst);
+  return tail == head ? PushResult::PUSHED_TO_EMPTY : PushResult::PUSHED;
+}
+
+bool
+ShmRing::pop(Block& block)
+{
+  uint64_t tail = m_header->tail.load(std::memory_order_relaxed);
+
+  for (;;) {
+    // seq_cst load pairs with the store of head in push(): see the comment there
+    uint64_t head = m_header->head.load(std::memory_order_seq_cst);
+    if (tail == head) {
+      return false;
+    }
+
+    if (head - tail > m_capacity || tail % RECORD_ALIGNMENT != 0) {
+      BOOST_THROW_EXCEPTION(Error("ring positions are corrupted"));
+    }
+
+    size_t offset = tail & (m_capacity - 1);
+    uint32_t length = 0;
+    std::memcpy(&length, m_data + offset, LENGTH_SIZE);
+
+    if (length == 0) {
+      // padding until the end of the data area
+      tail += m_capacity - offset;
+      m_header->tail.store(tail, std::memory_order_seq_cst);
+      continue;
+    }
+
+    size_t recordSize = getRecordSize(length);
+    if (length > MAX_NDN_PACKET_SIZE || recordSize > m_capacity - offset ||
+        recordSize > head - tail) {
+      BOOST_THROW_EXCEPTION(Error("ring record is corrupted"));
+    }
+
+    bool isOk = false;
+    std::tie(isOk, block) = Block::fromBuffer(m_data + offset + LENGTH_SIZE, length);
+    if (!isOk || block.size() != length) {
+      BOOST_THROW_EXCEPTION(Error("ring record does not contain a TLV block"));
+    }
+
+    m_header->tail.store(tail + recordSize, std::memory_order_seq_cst);
+    return true;
+  }
+}
+
+bool
+ShmRing::takeProducerBlocked()
+{
+  if (m_header->isProducerBlocked.load(std::memory_order_seq_cst) == 0) {
+    return false;
+  }
+  return m_header->isProducerBlocked.exchange(0, std::memory_order_seq_cst) != 0;
+}
+
+} // namespace ndn
@@ -0,0 +1,137 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2013-2017 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#ifndef NDN_TRANSPORT_SHM_RING_HPP
+#define NDN_TRANSPORT_SHM_RING_HPP
+
+#include "../common.hpp"
+#include "../encoding/block.hpp"
+
+#include <atomic>
+
+namespace ndn {
+
+/** \brief single-producer single-consumer ring of TLV blocks in shared memory
+ *
+ *  The ring consists of a header and a data area, both placed in a memory region that
+ *  may be mapped by two processes.  Each block is stored as a 32-bit length followed by
+ *  the block, padded to a multiple of 8 octets.  A record never wraps around the end of
+ *  the data area: a zero length marks the unused space at the end.
+ *
+ *  ShmRing does not own the memory region; it merely interprets it.
+ *
+ *  The consumer may sleep when the ring is empty.  push() reports whether the ring was
+ *  empty as seen after publishing the block, in which case the producer must wake up
+ *  the consumer.  Likewise, the producer may sleep when the ring is full, after which
+ *  takeProducerBlocked() on the consumer side reports that the producer must be woken up.
+ */
+class ShmRing : noncopyable
+{
+public:
+  class Error : public std::runtime_error
+  {
+  public:
+    explicit
+    Error(const std::string& what)
+      : std::runtime_error(what)
+    {
+    }
+  };
+
+  enum class PushResult {
+    FULL,            ///< there is not enough space; the producer is marked as blocked
+    PUSHED,          ///< the block has been appended
+    PUSHED_TO_EMPTY  ///< the block has been appended, and the consumer must be woken up
+  };
+
+  /** \return size of the memory region needed for a ring of \p capacity octets
+   */
+  static size_t
+  getRegionSize(size_t capacity);
+
+  /** \brief interpret \p region as a ring
+   *  \param region memory region of getRegionSize(capacity) octets, aligned to 64 octets
+   *  \param capacity size of the data area, a power of two
+   *                  not less than 4 * MAX_NDN_PACKET_SIZE
+   *  \param shouldInitialize if true, the ring is initialized as empty; otherwise,
+   *                          the ring must have been initialized with the same capacity
+   *  \throw Error capacity is invalid, or the region contains a ring of another capacity
+   */
+  ShmRing(void* region, size_t capacity, bool shouldInitialize);
+
+  size_t
+  getCapacity() const
+  {
+    return m_capacity;
+  }
+
+public: // producer
+  /** \brief append a block
+   *  \throw Error the block is larger than MAX_NDN_PACKET_SIZE
+   */
+  PushResult
+  push(const Block& wire);
+
+  /** \brief append a block whose wire encoding is the concatenation of two blocks
+   *  \throw Error the combined size is larger than MAX_NDN_PACKET_SIZE
+   */
+  PushResult
+  push(const Block& header, const Block& payload);
+
+public: // consumer
+  /** \brief remove the oldest block
+   *  \param[out] block copy of the removed block
+   *  \retval false the ring is empty
+   *  \throw Error the ring contains an invalid record, e.g., written by a faulty peer
+   */
+  bool
+  pop(Block& block);
+
+  /** \brief check and clear the flag set by push() on a full ring
+   *  \retval true the producer is blocked and must be woken up
+   */
+  bool
+  takeProducerBlocked();
+
+private:
+  PushResult
+  push(const Block* const* parts, size_t nParts);
+
+private:
+  struct Header
+  {
+    alignas(64) std::atomic<uint64_t> head;            ///< write position, owned by producer
+    alignas(64) std::atomic<uint64_t> tail;            ///< read position, owned by consumer
+    alignas(64) std::atomic<uint32_t> isProducerBlocked;
+    uint64_t capacity;
+  };
+
+  static_assert(ATOMIC_LLONG_LOCK_FREE == 2 && ATOMIC_INT_LOCK_FREE == 2,
+                "ShmRing requires lock-free atomics, which are usable across processes");
+
+  Header* m_header;
+  uint8_t* m_data;
+  size_t m_capacity;
+};
+
+} // namespace ndn
+
+#endif // NDN_TRANSPORT_SHM_RING_HPP
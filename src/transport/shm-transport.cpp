@@ -0,0 +1,426 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2013-2017 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#include "shm-transport.hpp"
+#include "stream-transport-impl.hpp"
+
+#include "../util/face-uri.hpp"
+#include "../util/logger.hpp"
+
+#include <boost/asio/posix/stream_descriptor.hpp>
+
+#include <unistd.h>
+
+namespace ndn {
+
+NDN_LOG_INIT(ndn.ShmTransport);
+
+/** \brief stream transport that switches to a shared memory channel once it is accepted
+ */
+class ShmTransport::Impl : public StreamTransportImpl<ShmTransport, boost::asio::local::stream_protocol>
+{
+public:
+  typedef StreamTransportImpl<ShmTransport, boost::asio::local::stream_protocol> Base;
+
+  Impl(ShmTransport& transport, boost::asio::io_service& ioService)
+    : Base(transport, ioService)
+    , m_wakeup(ioService)
+    , m_isShmActive(false)
+  {
+  }
+
+  void
+  connect(const boost::asio::local::stream_protocol::endpoint& endpoint, size_t ringCapacity)
+  {
+    boost::system::error_code error;
+    m_socket.connect(endpoint, error);
+    if (error) {
+      m_socket.close(error);
+      BOOST_THROW_EXCEPTION(Transport::Error(error, "error while connecting to the forwarder"));
+    }
+    m_transport.m_isConnected = true;
+
+    try {
+      m_channel = ShmChannel::create(ringCapacity);
+    }
+    catch (const ShmChannel::Error& e) {
+      NDN_LOG_DEBUG("shared memory channel unavailable, using the socket: " << e.what());
+      return;
+    }
+
+    try {
+      // the offer must be the first block on the socket
+      m_channel->sendRequest(m_socket.native_handle());
+    }
+    catch (const ShmChannel::Error& e) {
+      this->close();
+      BOOST_THROW_EXCEPTION(Transport::Error(e.what()));
+    }
+  }
+
+  void
+  activateShm()
+  {
+    if (m_channel == nullptr || m_isShmActive) {
+      return;
+    }
+
+    int wakeupFd = ::dup(m_channel->getWakeupFd());
+    if (wakeupFd < 0) {
+      NDN_LOG_WARN("cannot duplicate wakeup descriptor, using the socket");
+      m_channel.reset();
+      return;
+    }
+    m_wakeup.assign(wakeupFd);
+    m_isShmActive = true;
+    NDN_LOG_DEBUG("shared memory channel accepted");
+
+    this->asyncWaitWakeup();
+    // the forwarder may have written to the ring before its acceptance was received
+    m_transport.m_ioService->post(bind(&Impl::processWakeup, this->self()));
+  }
+
+  bool
+  isShmActive() const
+  {
+    return m_isShmActive;
+  }
+
+  void
+  close()
+  {
+    boost::system::error_code error; // to silently ignore all errors
+    m_wakeup.cancel(error);
+    m_wakeup.close(error);
+    m_channel.reset();
+    m_pending.clear();
+    m_isShmActive = false;
+
+    Base::close();
+  }
+
+  void
+  resume()
+  {
+    Base::resume();
+    if (m_isShmActive) {
+      m_transport.m_ioService->post(bind(&Impl::processWakeup, this->self()));
+    }
+  }
+
+  void
+  send(const Block& wire)
+  {
+    if (!m_isShmActive) {
+      Base::send(wire);
+      return;
+    }
+
+    if (!m_pending.empty() || !this->pushToRing(wire)) {
+      BlockSequence sequence;
+      sequence.push_back(wire);
+      this->enqueuePending(std::move(sequence));
+    }
+  }
+
+  void
+  send(const Block& header, const Block& payload)
+  {
+    if (!m_isShmActive) {
+      Base::send(header, payload);
+      return;
+    }
+
+    if (!m_pending.empty() || !this->pushToRing(header, payload)) {
+      BlockSequence sequence;
+      sequence.push_back(header);
+      sequence.push_back(payload);
+      this->enqueuePending(std::move(sequence));
+    }
+  }
+
+  void
+  sendBatch(const std::vector<Block>& wires)
+  {
+    if (!m_isShmActive) {
+      Base::sendBatch(wires);
+      return;
+    }
+
+    for (const Block& wire : wires) {
+      this->send(wire);
+    }
+  }
+
+private:
+  shared_ptr<Impl>
+  self()
+  {
+    return static_pointer_cast<Impl>(this->shared_from_this());
+  }
+
+  /** \retval false the ring is full
+   */
+  template<typename... Blocks>
+  bool
+  pushToRing(const Blocks&... blocks)
+  {
+    ShmRing::PushResult result;
+    try {
+      result = m_channel->getSendRing().push(blocks...);
+    }
+    catch (const ShmRing::Error& e) {
+      BOOST_THROW_EXCEPTION(Transport::Error(e.what()));
+    }
+
+    if (result == ShmRing::PushResult::FULL) {
+      return false;
+    }
+
+    m_transport.m_counters.nOutPackets.fetch_add(1, std::memory_order_relaxed);
+    m_transport.m_counters.nOutBytes.fetch_add(getSize(blocks...), std::memory_order_relaxed);
+
+    if (result == ShmRing::PushResult::PUSHED_TO_EMPTY) {
+      m_channel->notifyPeer();
+    }
+    return true;
+  }
+
+  static size_t
+  getSize(const Block& wire)
+  {
+    return wire.size();
+  }
+
+  static size_t
+  getSize(const Block& header, const Block& payload)
+  {
+    return header.size() + payload.size();
+  }
+
+  using Base::getSize;
+
+  bool
+  pushToRing(const BlockSequence& sequence)
+  {
+    return sequence.size() == 1 ? this->pushToRing(sequence.front()) :
+                                  this->pushToRing(sequence.front(), sequence.back());
+  }
+
+  void
+  enqueuePending(BlockSequence&& sequence)
+  {
+    // sent when the forwarder wakes us up after making space in the ring
+    m_transport.m_counters.nQueuedPackets.fetch_add(1, std::memory_order_relaxed);
+    m_transport.m_counters.nQueuedBytes.fetch_add(getSize(sequence), std::memory_order_relaxed);
+    m_pending.push_back(std::move(sequence));
+  }
+
+  void
+  asyncWaitWakeup()
+  {
+    m_wakeup.async_read_some(boost::asio::buffer(&m_wakeupValue, sizeof(m_wakeupValue)),
+                             bind(&Impl::handleWakeup, this->self(), _1));
+  }
+
+  void
+  handleWakeup(const boost::system::error_code& error)
+  {
+    if (error) {
+      if (error == boost::asio::error::operation_aborted) {
+        // wakeup descriptor has been closed
+        return;
+      }
+
+      m_transport.close();
+      BOOST_THROW_EXCEPTION(Transport::Error(error, "error while waiting on shared memory channel"));
+    }
+
+    this->asyncWaitWakeup();
+    this->processWakeup();
+  }
+
+  void
+  processWakeup()
+  {
+    // the channel must outlive this function even if a receive callback closes the transport
+    shared_ptr<ShmChannel> channel = m_channel;
+    if (!m_isShmActive || channel == nullptr) {
+      return;
+    }
+
+    while (!m_pending.empty() && this->pushToRing(m_pending.front())) {
+      m_transport.m_counters.nQueuedPackets.fetch_sub(1, std::memory_order_relaxed);
+      m_transport.m_counters.nQueuedBytes.fetch_sub(getSize(m_pending.front()),
+                                                    std::memory_order_relaxed);
+      m_pending.pop_front();
+    }
+
+    ShmRing& ring = channel->getReceiveRing();
+    Block block;
+    try {
+      while (m_isShmActive && m_transport.m_isReceiving && ring.pop(block)) {
+        m_transport.receive(block);
+      }
+    }
+    catch (const ShmRing::Error& e) {
+      m_transport.close();
+      BOOST_THROW_EXCEPTION(Transport::Error(e.what()));
+    }
+
+    if (ring.takeProducerBlocked()) {
+      channel->notifyPeer();
+    }
+  }
+
+private:
+  boost::asio::posix::stream_descriptor m_wakeup;
+  uint64_t m_wakeupValue;
+  shared_ptr<ShmChannel> m_channel;
+  bool m_isShmActive;
+  /// blocks waiting for space in the send ring
+  TransmissionQueue m_pending;
+};
+
+ShmTransport::ShmTransport(const std::string& unixSocket, size_t ringCapacity)
+  : m_unixSocket(unixSocket)
+  , m_ringCapacity(ringCapacity)
+{
+}
+
+ShmTransport::~ShmTransport()
+{
+}
+
+std::string
+ShmTransport::getSocketNameFromUri(const std::string& uriString)
+{
+  // Assume the default nfd.sock location.
+  std::string path = "/var/run/nfd.sock";
+
+  if (uriString.empty()) {
+    return path;
+  }
+
+  try {
+    const util::FaceUri uri(uriString);
+
+    if (uri.getScheme() != "shm") {
+      BOOST_THROW_EXCEPTION(Error("Cannot create ShmTransport from \"" +
+                                  uri.getScheme() + "\" URI"));
+    }
+
+    if (!uri.getPath().empty()) {
+      path = uri.getPath();
+    }
+  }
+  catch (const util::FaceUri::Error& error) {
+    BOOST_THROW_EXCEPTION(Error(error.what()));
+  }
+
+  return path;
+}
+
+shared_ptr<ShmTransport>
+ShmTransport::create(const std::string& uri)
+{
+  return make_shared<ShmTransport>(getSocketNameFromUri(uri));
+}
+
+void
+ShmTransport::connect(boost::asio::io_service& ioService,
+                      const ReceiveCallback& receiveCallback)
+{
+  if (m_impl == nullptr) {
+    Transport::connect(ioService, receiveCallback);
+    m_upperReceiveCallback = receiveCallback;
+    m_receiveCallback = bind(&ShmTransport::onReceive, this, _1);
+
+    m_impl = make_shared<Impl>(ref(*this), ref(ioService));
+  }
+
+  m_impl->connect(boost::asio::local::stream_protocol::endpoint(m_unixSocket), m_ringCapacity);
+}
+
+void
+ShmTransport::onReceive(const Block& wire)
+{
+  if (wire.type() == ShmChannel::TLV_ACCEPT) {
+    if (m_impl != nullptr) {
+      m_impl->activateShm();
+    }
+    return;
+  }
+
+  m_upperReceiveCallback(wire);
+}
+
+bool
+ShmTransport::isShmActive() const
+{
+  return m_impl != nullptr && m_impl->isShmActive();
+}
+
+void
+ShmTransport::send(const Block& wire)
+{
+  BOOST_ASSERT(m_impl != nullptr);
+  m_impl->send(wire);
+}
+
+void
+ShmTransport::send(const Block& header, const Block& payload)
+{
+  BOOST_ASSERT(m_impl != nullptr);
+  m_impl->send(header, payload);
+}
+
+void
+ShmTransport::sendBatch(const std::vector<Block>& wires)
+{
+  BOOST_ASSERT(m_impl != nullptr);
+  m_impl->sendBatch(wires);
+}
+
+void
+ShmTransport::close()
+{
+  BOOST_ASSERT(m_impl != nullptr);
+  m_impl->close();
+  m_impl.reset();
+}
+
+void
+ShmTransport::pause()
+{
+  if (m_impl != nullptr) {
+    m_impl->pause();
+  }
+}
+
+void
+ShmTransport::resume()
+{
+  BOOST_ASSERT(m_impl != nullptr);
+  m_impl->resume();
+}
+
+} // namespace ndn
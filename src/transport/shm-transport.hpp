@@ -0,0 +1,128 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2013-2017 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#ifndef NDN_TRANSPORT_SHM_TRANSPORT_HPP
+#define NDN_TRANSPORT_SHM_TRANSPORT_HPP
+
+#include "transport.hpp"
+#include "shm-channel.hpp"
+#include "../util/config-file.hpp"
+
+namespace boost {
+namespace asio {
+namespace local {
+class stream_protocol;
+} // namespace local
+} // namespace asio
+} // namespace boost
+
+namespace ndn {
+
+template<typename BaseTransport, typename Protocol>
+class StreamTransportImpl;
+
+/** \brief a transport using shared memory rings, negotiated over a Unix stream socket
+ *
+ *  The transport connects to a Unix stream socket like UnixTransport, and offers a
+ *  ShmChannel to the forwarder as the first block on the socket.  Once the forwarder
+ *  accepts the offer, packets are exchanged through the shared memory rings, without a
+ *  system call per packet.  Until then, or if the forwarder does not support shared
+ *  memory, packets are exchanged through the socket.
+ *
+ *  Packets sent through the socket before the offer is accepted may be delivered after
+ *  packets sent through the rings.
+ *
+ *  \sa ShmChannel
+ */
+class ShmTransport : public Transport
+{
+public:
+  /** \param unixSocket path of the Unix stream socket
+   *  \param ringCapacity capacity of each ring, see ShmRing
+   */
+  explicit
+  ShmTransport(const std::string& unixSocket,
+               size_t ringCapacity = ShmChannel::DEFAULT_RING_CAPACITY);
+
+  ~ShmTransport() override;
+
+  /** \brief connect to the socket and offer a shared memory channel
+   *
+   *  Unlike UnixTransport, the connection is established synchronously.
+   */
+  void
+  connect(boost::asio::io_service& ioService,
+          const ReceiveCallback& receiveCallback) override;
+
+  void
+  close() override;
+
+  void
+  pause() override;
+
+  void
+  resume() override;
+
+  void
+  send(const Block& wire) override;
+
+  void
+  send(const Block& header, const Block& payload) override;
+
+  void
+  sendBatch(const std::vector<Block>& wires) override;
+
+  /** \retval true packets are exchanged through shared memory rings
+   *  \retval false packets are exchanged through the socket
+   */
+  bool
+  isShmActive() const;
+
+  /** \brief Create transport with parameters defined in URI
+   *
+   *  The URI has the form shm:///path/to/socket.
+   *
+   *  \throw Transport::Error if incorrect URI or unsupported protocol is specified
+   */
+  static shared_ptr<ShmTransport>
+  create(const std::string& uri);
+
+NDN_CXX_PUBLIC_WITH_TESTS_ELSE_PRIVATE:
+  static std::string
+  getSocketNameFromUri(const std::string& uri);
+
+private:
+  void
+  onReceive(const Block& wire);
+
+private:
+  std::string m_unixSocket;
+  size_t m_ringCapacity;
+  ReceiveCallback m_upperReceiveCallback;
+
+  class Impl;
+  friend class StreamTransportImpl<ShmTransport, boost::asio::local::stream_protocol>;
+  shared_ptr<Impl> m_impl;
+};
+
+} // namespace ndn
+
+#endif // NDN_TRANSPORT_SHM_TRANSPORT_HPP
@@ -26,6 +26,7 @@
 
 #include <boost/asio.hpp>
 #include <list>
+#include <vector>
 
 namespace ndn {
 
@@ -46,6 +47,7 @@ public:
     : m_transport(transport)
     , m_socket(ioService)
     , m_inputBufferSize(0)
+    , m_nInFlight(0)
     , m_isConnecting(false)
     , m_connectTimer(ioService)
   {
@@ -80,6 +82,9 @@ public:
     m_transport.m_isConnected = false;
     m_transport.m_isReceiving = false;
     m_transmissionQueue.clear();
+    m_nInFlight = 0;
+    m_transport.m_counters.nQueuedPackets.store(0, std::memory_order_relaxed);
+    m_transport.m_counters.nQueuedBytes.store(0, std::memory_order_relaxed);
   }
 
   void
@@ -124,6 +129,20 @@ public:
     send(std::move(sequence));
   }
 
+  void
+  sendBatch(const std::vector<Block>& wires)
+  {
+    for (const Block& wire : wires) {
+      BlockSequence sequence;
+      sequence.push_back(wire);
+      enqueue(std::move(sequence));
+    }
+
+    if (m_transport.m_isConnected && m_nInFlight == 0 && !m_transmissionQueue.empty()) {
+      asyncWrite();
+    }
+  }
+
 protected:
   void
   connectHandler(const boost::system::error_code& error)
@@ -159,26 +178,47 @@ protected:
   void
   send(BlockSequence&& sequence)
   {
-    m_transmissionQueue.emplace_back(sequence);
+    enqueue(std::move(sequence));
 
-    if (m_transport.m_isConnected && m_transmissionQueue.size() == 1) {
+    if (m_transport.m_isConnected && m_nInFlight == 0) {
       asyncWrite();
     }
 
-    // if not connected or there is transmission in progress (m_transmissionQueue.size() > 1),
+    // if not connected or there is transmission in progress (m_nInFlight > 0),
     // next write will be scheduled either in connectHandler or in asyncWriteHandler
   }
 
+  void
+  enqueue(BlockSequence&& sequence)
+  {
+    size_t nBytes = getSize(sequence);
+    m_transport.m_counters.nQueuedPackets.fetch_add(1, std::memory_order_relaxed);
+    m_transport.m_counters.nQueuedBytes.fetch_add(nBytes, std::memory_order_relaxed);
+
+    m_transmissionQueue.emplace_back(std::move(sequence));
+  }
+
+  /** \brief write all queued packets with one scatter/gather operation
+   */
   void
   asyncWrite()
   {
     BOOST_ASSERT(!m_transmissionQueue.empty());
-    boost::asio::async_write(m_socket, m_transmissionQueue.front(),
-      bind(&Impl::handleAsyncWrite, this->shared_from_this(), _1, m_transmissionQueue.begin()));
+
+    m_outputBuffers.clear();
+    for (const BlockSequence& sequence : m_transmissionQueue) {
+      for (const Block& block : sequence) {
+        m_outputBuffers.push_back(block);
+      }
+    }
+    m_nInFlight = m_transmissionQueue.size();
+
+    boost::asio::async_write(m_socket, m_outputBuffers,
+      bind(&Impl::handleAsyncWrite, this->shared_from_this(), _1));
   }
 
   void
-  handleAsyncWrite(const boost::system::error_code& error, TransmissionQueue::iterator queueItem)
+  handleAsyncWrite(const boost::system::error_code& error)
   {
     if (error) {
       if (error == boost::system::errc::operation_canceled) {
@@ -194,7 +234,15 @@ protected:
       return; // queue has been already cleared
     }
 
-    m_transmissionQueue.erase(queueItem);
+    size_t nBytes = 0;
+    for (; m_nInFlight > 0; --m_nInFlight) {
+      nBytes += getSize(m_transmissionQueue.front());
+      m_transmissionQueue.pop_front();
+      m_transport.m_counters.nOutPackets.fetch_add(1, std::memory_order_relaxed);
+      m_transport.m_counters.nQueuedPackets.fetch_sub(1, std::memory_order_relaxed);
+    }
+    m_transport.m_counters.nOutBytes.fetch_add(nBytes, std::memory_order_relaxed);
+    m_transport.m_counters.nQueuedBytes.fetch_sub(nBytes, std::memory_order_relaxed);
 
     if (!m_transmissionQueue.empty()) {
       asyncWrite();
@@ -247,6 +295,16 @@ protected:
     asyncReceive();
   }
 
+  static size_t
+  getSize(const BlockSequence& sequence)
+  {
+    size_t nBytes = 0;
+    for (const Block& block : sequence) {
+      nBytes += block.size();
+    }
+    return nBytes;
+  }
+
   bool
   processAllReceived(uint8_t* buffer, size_t& offset, size_t nBytesAvailable)
   {
@@ -271,6 +329,9 @@ protected:
   size_t m_inputBufferSize;
 
   TransmissionQueue m_transmissionQueue;
+  /// buffers of the write in progress, which covers the first m_nInFlight queued packets
+  std::vector<boost::asio::const_buffer> m_outputBuffers;
+  size_t m_nInFlight;
   bool m_isConnecting;
 
   boost::asio::deadline_timer m_connectTimer;
@@ -101,6 +101,13 @@ TcpTransport::send(const Block& header, const Block& payload)
   m_impl->send(header, payload);
 }
 
+void
+TcpTransport::sendBatch(const std::vector<Block>& wires)
+{
+  BOOST_ASSERT(m_impl != nullptr);
+  m_impl->sendBatch(wires);
+}
+
 void
 TcpTransport::close()
 {
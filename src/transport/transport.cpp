@@ -50,4 +50,12 @@ Transport::connect(boost::asio::io_service& ioService,
   m_receiveCallback = receiveCallback;
 }
 
+void
+Transport::sendBatch(const std::vector<Block>& wires)
+{
+  for (const Block& wire : wires) {
+    this->send(wire);
+  }
+}
+
 } // namespace ndn
@@ -27,6 +27,8 @@
 
 #include <boost/system/error_code.hpp>
 
+#include <atomic>
+
 namespace boost {
 namespace asio {
 class io_service;
@@ -35,6 +37,29 @@ class io_service;
 
 namespace ndn {
 
+/** \brief counters of a Transport
+ *
+ *  Counters are atomic, so that they can be read on a thread other than the one that
+ *  runs the io_service of the transport.
+ */
+struct TransportCounters
+{
+  std::atomic<uint64_t> nInPackets{0};
+  std::atomic<uint64_t> nInBytes{0};
+  std::atomic<uint64_t> nOutPackets{0};
+  std::atomic<uint64_t> nOutBytes{0};
+
+  /** \brief number of packets waiting in the transmission queue
+   *
+   *  This is always zero for transports without a transmission queue.
+   */
+  std::atomic<uint64_t> nQueuedPackets{0};
+
+  /** \brief number of bytes waiting in the transmission queue
+   */
+  std::atomic<uint64_t> nQueuedBytes{0};
+};
+
 /** \brief provides TLV-block delivery service
  */
 class Transport : noncopyable
@@ -83,6 +108,14 @@ public:
   virtual void
   send(const Block& header, const Block& payload) = 0;
 
+  /** \brief send several TLV blocks through the transport
+   *
+   *  Stream-oriented transports write the blocks with one scatter/gather operation.
+   *  The default implementation sends each block separately.
+   */
+  virtual void
+  sendBatch(const std::vector<Block>& wires);
+
   /** \brief pause the transport
    *  \post receiveCallback will not be invoked
    *  \note This operation has no effect if transport has been paused,
@@ -111,6 +144,17 @@ public:
   bool
   isReceiving() const;
 
+  /** \brief get the counters of this transport
+   *
+   *  Received packets are counted by receive().  Subclasses count sent packets and the
+   *  state of their transmission queue.
+   */
+  const TransportCounters&
+  getCounters() const
+  {
+    return m_counters;
+  }
+
 protected:
   /** \brief invoke the receive callback
    */
@@ -122,6 +166,7 @@ protected:
   bool m_isConnected;
   bool m_isReceiving;
   ReceiveCallback m_receiveCallback;
+  TransportCounters m_counters;
 };
 
 inline bool
@@ -139,6 +184,8 @@ Transport::isReceiving() const
 inline void
 Transport::receive(const Block& wire)
 {
+  m_counters.nInPackets.fetch_add(1, std::memory_order_relaxed);
+  m_counters.nInBytes.fetch_add(wire.size(), std::memory_order_relaxed);
   m_receiveCallback(wire);
 }
 
@@ -98,6 +98,13 @@ UnixTransport::send(const Block& header, const Block& payload)
   m_impl->send(header, payload);
 }
 
+void
+UnixTransport::sendBatch(const std::vector<Block>& wires)
+{
+  BOOST_ASSERT(m_impl != nullptr);
+  m_impl->sendBatch(wires);
+}
+
 void
 UnixTransport::close()
 {
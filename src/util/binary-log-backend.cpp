@@ -0,0 +1,553 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2013-2017 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#include "binary-log-backend.hpp"
+#include "logger.hpp"
+#include "time.hpp"
+
+#include <cinttypes>
+#include <condition_variable>
+#include <cstring>
+#include <mutex>
+#include <stdio.h>
+#include <streambuf>
+#include <thread>
+
+namespace ndn {
+namespace util {
+
+const size_t BinaryLogBackend::DEFAULT_RING_CAPACITY = 64 * 1024;
+
+std::atomic<bool> BinaryLogBackend::s_isInstalled(false);
+
+namespace {
+
+/** \brief header of an entry in a ring buffer
+ */
+struct EntryHeader
+{
+  uint32_t size; ///< size of the entry including this header, a multiple of ALIGNMENT
+  uint32_t moduleNameSize;
+  uint32_t messageSize;
+  const char* levelString; ///< nullptr for padding at the end of the buffer
+  int_least64_t timestamp; ///< microseconds since epoch
+};
+
+const size_t ALIGNMENT = 8;
+
+size_t
+align(size_t size)
+{
+  return (size + ALIGNMENT - 1) & ~(ALIGNMENT - 1);
+}
+
+/** \brief single-producer single-consumer byte ring buffer
+ *
+ *  Entries are written by the thread owning the ring, and read by the background thread.
+ *  An entry never wraps around: if it does not fit before the end of the buffer, the
+ *  remaining space is skipped.
+ */
+class Ring : noncopyable
+{
+public:
+  explicit
+  Ring(size_t capacity)
+    : m_capacity(capacity)
+    , m_buffer(new uint8_t[capacity])
+    , m_head(0)
+    , m_tail(0)
+    , m_nDropped(0)
+  {
+    BOOST_ASSERT((capacity & (capacity - 1)) == 0);
+  }
+
+  size_t
+  getMaxPayloadSize() const
+  {
+    return m_capacity / 2 - sizeof(EntryHeader);
+  }
+
+  /** \pre header.moduleNameSize + header.messageSize <= getMaxPayloadSize()
+   *  \return whether the entry has been stored
+   */
+  bool
+  push(EntryHeader header, const char* moduleName, const char* message)
+  {
+    header.size = align(sizeof(EntryHeader) + header.moduleNameSize + header.messageSize);
+
+    size_t tail = m_tail.load(std::memory_order_relaxed);
+    size_t head = m_head.load(std::memory_order_acquire);
+    size_t offset = tail & (m_capacity - 1);
+    size_t padding = header.size > m_capacity - offset ? m_capacity - offset : 0;
+    if (padding + header.size > m_capacity - (tail - head))
+      return false;
+
+    if (padding > 0) {
+      if (padding >= sizeof(EntryHeader)) {
+        EntryHeader paddingHeader{static_cast<uint32_t>(padding), 0, 0, nullptr, 0};
+        std::memcpy(&m_buffer[offset], &paddingHeader, sizeof(paddingHeader));
+      }
+      offset = 0;
+    }
+
+    uint8_t* entry = &m_buffer[offset];
+    std::memcpy(entry, &header, sizeof(header));
+    std::memcpy(entry + sizeof(header), moduleName, header.moduleNameSize);
+    std::memcpy(entry + sizeof(header) + header.moduleNameSize, message, header.messageSize);
+
+    m_tail.store(tail + padding + header.size, std::memory_order_release);
+    return true;
+  }
+
+  /** \brief invoke \p handle for every stored entry, and release their space
+   *  \return whether any entry was stored
+   */
+  template<typename Handler>
+  bool
+  drain(const Handler& handle)
+  {
+    size_t head = m_head.load(std::memory_order_relaxed);
+    size_t tail = m_tail.load(std::memory_order_acquire);
+    if (head == tail)
+      return false;
+
+    while (head != tail) {
+      size_t offset = head & (m_capacity - 1);
+      if (m_capacity - offset < sizeof(EntryHeader)) {
+        head += m_capacity - offset;
+        continue;
+      }
+
+      EntryHeader header;
+      std::memcpy(&header, &m_buffer[offset], sizeof(header));
+      if (header.levelString != nullptr) {
+        const char* moduleName = reinterpret_cast<const char*>(&m_buffer[offset + sizeof(header)]);
+        handle(header, moduleName, moduleName + header.moduleNameSize);
+      }
+      head += header.size;
+    }
+
+    m_head.store(head, std::memory_order_release);
+    return true;
+  }
+
+private:
+  const size_t m_capacity;
+  unique_ptr<uint8_t[]> m_buffer;
+  std::atomic<size_t> m_head; ///< read position, written by the background thread
+  std::atomic<size_t> m_tail; ///< write position, written by the owner thread
+
+public:
+  std::atomic<uint64_t> m_nDropped; ///< number of records that did not fit
+};
+
+/** \brief stream buffer that appends to a reusable character buffer
+ */
+class MessageBuffer : public std::streambuf
+{
+public:
+  void
+  clear()
+  {
+    m_chars.clear();
+  }
+
+  const char*
+  data() const
+  {
+    return m_chars.data();
+  }
+
+  size_t
+  size() const
+  {
+    return m_chars.size();
+  }
+
+private:
+  int_type
+  overflow(int_type ch) final
+  {
+    if (!traits_type::eq_int_type(ch, traits_type::eof()))
+      m_chars.push_back(traits_type::to_char_type(ch));
+    return traits_type::not_eof(ch);
+  }
+
+  std::streamsize
+  xsputn(const char* s, std::streamsize n) final
+  {
+    m_chars.insert(m_chars.end(), s, s + n);
+    return n;
+  }
+
+private:
+  std::vector<char> m_chars;
+};
+
+void
+writeTimestamp(std::ostream& os, int_least64_t usecs)
+{
+  static const int_least64_t ONE_SECOND = 1000000;
+
+  // 10 (whole seconds) + '.' + 6 (fraction) + '\0'
+  char buffer[10 + 1 + 6 + 1];
+  snprintf(buffer, sizeof(buffer), "%" PRIdLEAST64 ".%06" PRIdLEAST64,
+           usecs / ONE_SECOND, usecs % ONE_SECOND);
+  os << buffer;
+}
+
+} // namespace
+
+class BinaryLogBackend::Impl : noncopyable
+{
+public:
+  Impl(shared_ptr<std::ostream> os, size_t ringCapacity)
+    : m_os(std::move(os))
+    , m_ringCapacity(ringCapacity)
+    , m_nDroppedInRemovedRings(0)
+    , m_nReportedDropped(0)
+    , m_flushRequested(0)
+    , m_flushCompleted(0)
+    , m_shouldStop(false)
+    , m_thread(&Impl::run, this)
+  {
+  }
+
+  ~Impl()
+  {
+    stop();
+  }
+
+  shared_ptr<Ring>
+  addRing()
+  {
+    auto ring = make_shared<Ring>(m_ringCapacity);
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_rings.push_back(ring);
+    return ring;
+  }
+
+  void
+  flush()
+  {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    if (m_shouldStop)
+      return;
+
+    uint64_t request = ++m_flushRequested;
+    m_cv.notify_all();
+    m_flushCv.wait(lock, [this, request] { return m_flushCompleted >= request || m_shouldStop; });
+  }
+
+  void
+  stop()
+  {
+    {
+      std::lock_guard<std::mutex> lock(m_mutex);
+      m_shouldStop = true;
+      m_cv.notify_all();
+      m_flushCv.notify_all();
+    }
+    if (m_thread.joinable())
+      m_thread.join();
+  }
+
+private:
+  void
+  run()
+  {
+    static const time::milliseconds IDLE_INTERVAL(10);
+
+    std::unique_lock<std::mutex> lock(m_mutex);
+    while (!m_shouldStop) {
+      uint64_t flushRequested = m_flushRequested;
+      bool hasDrained = drainAll();
+
+      if (flushRequested != m_flushCompleted) {
+        m_os->flush();
+        m_flushCompleted = flushRequested;
+        m_flushCv.notify_all();
+      }
+
+      if (!hasDrained) {
+        m_cv.wait_for(lock, std::chrono::milliseconds(IDLE_INTERVAL.count()));
+      }
+    }
+
+    drainAll();
+    m_os->flush();
+  }
+
+  /** \pre m_mutex is locked
+   */
+  bool
+  drainAll()
+  {
+    auto writeEntry = [this] (const EntryHeader& header, const char* moduleName, const char* message) {
+      writeTimestamp(*m_os, header.timestamp);
+      *m_os << ' ' << header.levelString << ": [";
+      m_os->write(moduleName, header.moduleNameSize);
+      *m_os << "] ";
+      m_os->write(message, header.messageSize);
+      *m_os << '\n';
+    };
+
+    bool hasDrained = false;
+    for (auto it = m_rings.begin(); it != m_rings.end();) {
+      hasDrained = (*it)->drain(writeEntry) || hasDrained;
+
+      if (it->use_count() == 1) {
+        // The owner thread has exited.  It may have pushed more records between the drain
+        // above and its exit, so the ring is drained again before it is removed.
+        std::atomic_thread_fence(std::memory_order_acquire);
+        hasDrained = (*it)->drain(writeEntry) || hasDrained;
+        m_nDroppedInRemovedRings += (*it)->m_nDropped.load(std::memory_order_relaxed);
+        it = m_rings.erase(it);
+      }
+      else {
+        ++it;
+      }
+    }
+
+    uint64_t nDropped = countDropped();
+    if (nDropped != m_nReportedDropped) {
+      writeTimestamp(*m_os, time::duration_cast<time::microseconds>(
+                              time::system_clock::now().time_since_epoch()).count());
+      *m_os << " WARNING: [BinaryLogBackend] " << (nDropped - m_nReportedDropped)
+            << " records dropped\n";
+      m_nReportedDropped = nDropped;
+    }
+
+    return hasDrained;
+  }
+
+public:
+  /** \pre m_mutex is locked
+   */
+  uint64_t
+  countDropped() const
+  {
+    uint64_t nDropped = m_nDroppedInRemovedRings;
+    for (const auto& ring : m_rings)
+      nDropped += ring->m_nDropped.load(std::memory_order_relaxed);
+    return nDropped;
+  }
+
+  uint64_t
+  getNDropped()
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return countDropped();
+  }
+
+public:
+  /** \brief make \p impl the installed backend
+   *  \pre s_installMutex is locked
+   *  \return the previously installed backend
+   */
+  static shared_ptr<Impl>
+  setInstalled(shared_ptr<Impl> impl)
+  {
+    shared_ptr<Impl> previous = std::move(s_installed);
+    s_installed = std::move(impl);
+    s_generation.fetch_add(1, std::memory_order_release);
+    s_isInstalled.store(s_installed != nullptr, std::memory_order_relaxed);
+    return previous;
+  }
+
+  /// the installed backend, protected by s_installMutex
+  static shared_ptr<Impl> s_installed;
+  static std::mutex s_installMutex;
+  /// incremented whenever a backend is installed or uninstalled
+  static std::atomic<uint64_t> s_generation;
+
+private:
+  const shared_ptr<std::ostream> m_os;
+  const size_t m_ringCapacity;
+  uint64_t m_nDroppedInRemovedRings;
+  uint64_t m_nReportedDropped;
+
+  std::mutex m_mutex;
+  std::condition_variable m_cv;
+  std::condition_variable m_flushCv;
+  std::vector<shared_ptr<Ring>> m_rings;
+  uint64_t m_flushRequested;
+  uint64_t m_flushCompleted;
+  bool m_shouldStop;
+
+  std::thread m_thread;
+};
+
+static size_t
+roundUpToPowerOfTwo(size_t n)
+{
+  size_t capacity = 1;
+  while (capacity < n)
+    capacity <<= 1;
+  return capacity;
+}
+
+BinaryLogBackend::BinaryLogBackend(shared_ptr<std::ostream> os, size_t ringCapacity)
+  : m_impl(make_shared<Impl>(std::move(os),
+                             roundUpToPowerOfTwo(std::max<size_t>(ringCapacity, 1024))))
+{
+}
+
+BinaryLogBackend::~BinaryLogBackend()
+{
+  {
+    std::lock_guard<std::mutex> lock(Impl::s_installMutex);
+    if (Impl::s_installed == m_impl)
+      Impl::setInstalled(nullptr);
+  }
+  m_impl->stop();
+}
+
+void
+BinaryLogBackend::flush()
+{
+  m_impl->flush();
+}
+
+void
+BinaryLogBackend::stop()
+{
+  m_impl->stop();
+}
+
+uint64_t
+BinaryLogBackend::getNDroppedRecords() const
+{
+  return m_impl->getNDropped();
+}
+
+shared_ptr<BinaryLogBackend::Impl> BinaryLogBackend::Impl::s_installed;
+std::mutex BinaryLogBackend::Impl::s_installMutex;
+std::atomic<uint64_t> BinaryLogBackend::Impl::s_generation(0);
+
+void
+BinaryLogBackend::install(shared_ptr<BinaryLogBackend> backend)
+{
+  shared_ptr<Impl> previous;
+  {
+    std::lock_guard<std::mutex> lock(Impl::s_installMutex);
+    previous = Impl::setInstalled(backend == nullptr ? nullptr : backend->m_impl);
+  }
+
+  if (previous != nullptr)
+    previous->stop();
+}
+
+class BinaryLogRecord::Buffer
+{
+public:
+  Buffer()
+    : os(&chars)
+  {
+  }
+
+  MessageBuffer chars;
+  std::ostream os;
+};
+
+namespace {
+
+/** \brief per-thread state of the binary logging backend
+ */
+struct ThreadState
+{
+  ThreadState()
+    : isBufferInUse(false)
+    , generation(0)
+  {
+  }
+
+  BinaryLogRecord::Buffer buffer;
+  bool isBufferInUse; ///< whether buffer holds the message of a record being written
+
+  uint64_t generation; ///< generation of the installed backend when ring was obtained
+  shared_ptr<Ring> ring; ///< ring registered with the installed backend, if any
+};
+
+ThreadState&
+getThreadState()
+{
+  static thread_local ThreadState state;
+  return state;
+}
+
+} // namespace
+
+BinaryLogRecord::BinaryLogRecord(const Logger& logger, const char* levelString)
+  : m_logger(logger)
+  , m_levelString(levelString)
+  , m_timestamp(time::duration_cast<time::microseconds>(
+                  time::system_clock::now().time_since_epoch()).count())
+{
+  ThreadState& state = getThreadState();
+  if (state.isBufferInUse) {
+    m_nestedBuffer = make_unique<Buffer>();
+    m_buffer = m_nestedBuffer.get();
+  }
+  else {
+    state.isBufferInUse = true;
+    m_buffer = &state.buffer;
+    m_buffer->chars.clear();
+  }
+}
+
+std::ostream&
+BinaryLogRecord::getStream()
+{
+  return m_buffer->os;
+}
+
+BinaryLogRecord::~BinaryLogRecord()
+{
+  ThreadState& state = getThreadState();
+  if (m_nestedBuffer == nullptr)
+    state.isBufferInUse = false;
+
+  using Impl = BinaryLogBackend::Impl;
+  if (state.generation != Impl::s_generation.load(std::memory_order_acquire)) {
+    std::lock_guard<std::mutex> lock(Impl::s_installMutex);
+    state.ring = Impl::s_installed == nullptr ? nullptr : Impl::s_installed->addRing();
+    state.generation = Impl::s_generation.load(std::memory_order_relaxed);
+  }
+
+  if (state.ring == nullptr)
+    return;
+
+  const std::string& moduleName = m_logger.getModuleName();
+  size_t maxSize = state.ring->getMaxPayloadSize();
+  EntryHeader header;
+  header.moduleNameSize = std::min(moduleName.size(), maxSize);
+  header.messageSize = std::min(m_buffer->chars.size(), maxSize - header.moduleNameSize);
+  header.levelString = m_levelString;
+  header.timestamp = m_timestamp;
+
+  if (!state.ring->push(header, moduleName.data(), m_buffer->chars.data())) {
+    state.ring->m_nDropped.fetch_add(1, std::memory_order_relaxed);
+  }
+}
+
+} // namespace util
+} // namespace ndn
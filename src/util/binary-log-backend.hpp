@@ -0,0 +1,153 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2013-2017 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#ifndef NDN_UTIL_BINARY_LOG_BACKEND_HPP
+#define NDN_UTIL_BINARY_LOG_BACKEND_HPP
+
+#include "../common.hpp"
+
+#include <atomic>
+
+namespace ndn {
+namespace util {
+
+class Logger;
+class BinaryLogRecord;
+
+/** \brief asynchronous logging backend with per-thread ring buffers
+ *
+ *  A thread that logs a record stores a compact binary entry (timestamp, severity, module
+ *  name, and message text) into a ring buffer owned by that thread, without taking any lock.
+ *  A background thread periodically drains all ring buffers, formats the entries in the
+ *  same way as the Boost.Log backend, and writes them into the destination stream.
+ *
+ *  If a ring buffer is full, new records from that thread are dropped, and the number of
+ *  dropped records is written into the destination stream.  Records from the same thread
+ *  are written in order; records from different threads may be interleaved.
+ *
+ *  \sa Logging::setDestination
+ */
+class BinaryLogBackend : noncopyable
+{
+public:
+  /** \brief start the background thread
+   *  \param os destination stream; it is only accessed by the background thread
+   *  \param ringCapacity size of the ring buffer of each thread in bytes, rounded up to a
+   *                      power of two
+   */
+  explicit
+  BinaryLogBackend(shared_ptr<std::ostream> os, size_t ringCapacity = DEFAULT_RING_CAPACITY);
+
+  /** \brief stop the background thread
+   *
+   *  If this backend is installed, it is uninstalled first, so that subsequent records go
+   *  to the Boost.Log backend.
+   */
+  ~BinaryLogBackend();
+
+  /** \brief write records submitted before this call into the destination stream
+   */
+  void
+  flush();
+
+  /** \brief write all submitted records, and stop the background thread
+   *
+   *  Records submitted after this call are discarded.
+   */
+  void
+  stop();
+
+  /** \return number of records dropped because a ring buffer was full
+   */
+  uint64_t
+  getNDroppedRecords() const;
+
+  /** \brief make \p backend the destination of NDN_LOG_* macros
+   *  \param backend the backend, or nullptr to use the Boost.Log backend
+   *
+   *  The previously installed backend is stopped.
+   */
+  static void
+  install(shared_ptr<BinaryLogBackend> backend);
+
+  /** \return whether a BinaryLogBackend is installed
+   */
+  static bool
+  isInstalled()
+  {
+    return s_isInstalled.load(std::memory_order_relaxed);
+  }
+
+public:
+  static const size_t DEFAULT_RING_CAPACITY;
+
+private:
+  class Impl;
+  shared_ptr<Impl> m_impl;
+
+  static std::atomic<bool> s_isInstalled;
+
+  friend class BinaryLogRecord;
+};
+
+/** \brief a record being captured for the installed BinaryLogBackend
+ *  \note This class is used by NDN_LOG_* macros.
+ */
+class BinaryLogRecord : noncopyable
+{
+public:
+  /** \param logger the logger of the record
+   *  \param levelString severity level name, which must have static storage duration
+   */
+  BinaryLogRecord(const Logger& logger, const char* levelString);
+
+  /** \brief submit the record to the installed backend
+   */
+  ~BinaryLogRecord();
+
+  /** \brief get the stream into which the message is written
+   */
+  std::ostream&
+  getStream();
+
+  /** \brief message buffer and the stream writing into it
+   */
+  class Buffer;
+
+private:
+  const Logger& m_logger;
+  const char* m_levelString;
+  int_least64_t m_timestamp;
+
+  /** \brief the buffer of this record
+   *
+   *  This is the buffer of the thread, unless the record is created while the message of
+   *  another record on the same thread is being written, e.g., when an operator<< invoked
+   *  in the message logs.  In that case, it is m_nestedBuffer.
+   */
+  Buffer* m_buffer;
+  unique_ptr<Buffer> m_nestedBuffer;
+};
+
+} // namespace util
+} // namespace ndn
+
+#endif // NDN_UTIL_BINARY_LOG_BACKEND_HPP
@@ -20,10 +20,7 @@
  */
 
 #include "crypto.hpp"
-#include "../encoding/buffer-stream.hpp"
-#include "../security/transform/buffer-source.hpp"
-#include "../security/transform/digest-filter.hpp"
-#include "../security/transform/stream-sink.hpp"
+#include "../security/transform/fused-pipeline.hpp"
 
 namespace ndn {
 namespace crypto {
@@ -33,10 +30,14 @@ computeSha256Digest(const uint8_t* data, size_t dataLength)
 {
   namespace tr = security::transform;
   try {
-    OBufferStream os;
-    tr::bufferSource(data, dataLength) >> tr::digestFilter(DigestAlgorithm::SHA256)
-                                       >> tr::streamSink(os);
-    return os.buf();
+    auto digest = make_shared<Buffer>(SHA256_DIGEST_SIZE);
+    size_t digestSize = 0;
+    tr::fused::DigestPipeline pipeline(tr::fused::BufferSink(digest->buf(), digest->size(), digestSize),
+                                       DigestAlgorithm::SHA256);
+    pipeline.write(data, dataLength);
+    pipeline.end();
+    BOOST_ASSERT(digestSize == SHA256_DIGEST_SIZE);
+    return digest;
   }
   catch (const tr::Error&) {
     return nullptr;
@@ -199,6 +199,15 @@ public:
     return m_nPackets;
   }
 
+  /** @return{ whether Data are marked stale after mustBeFreshProcessingWindow,
+   *           i.e., whether this in-memory storage was created with an io_service }
+   */
+  bool
+  isMustBeFreshHandled() const
+  {
+    return m_scheduler != nullptr;
+  }
+
   /** @brief Returns begin iterator of the in-memory storage ordering by
    *  name with digest
    *
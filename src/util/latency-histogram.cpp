@@ -0,0 +1,139 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2013-2017 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#include "latency-histogram.hpp"
+
+#include <cmath>
+
+namespace ndn {
+namespace util {
+
+const size_t LatencyHistogram::SUB_BUCKET_BITS;
+const size_t LatencyHistogram::SUB_BUCKETS;
+const size_t LatencyHistogram::MAX_LATENCY_BITS;
+const size_t LatencyHistogram::N_BUCKETS;
+
+LatencyHistogram::LatencyHistogram()
+{
+  this->reset();
+}
+
+void
+LatencyHistogram::reset()
+{
+  for (std::atomic<uint64_t>& bucket : m_buckets) {
+    bucket.store(0, std::memory_order_relaxed);
+  }
+  m_count.store(0, std::memory_order_relaxed);
+  m_sumMicroseconds.store(0, std::memory_order_relaxed);
+}
+
+/** \return position of the most significant bit set in \p v, which must be positive
+ */
+static size_t
+findHighestBit(uint64_t v)
+{
+  size_t bit = 0;
+  for (size_t shift = 32; shift > 0; shift /= 2) {
+    if (v >> shift != 0) {
+      v >>= shift;
+      bit += shift;
+    }
+  }
+  return bit;
+}
+
+size_t
+LatencyHistogram::getBucketIndex(uint64_t us)
+{
+  if (us < SUB_BUCKETS) {
+    return static_cast<size_t>(us);
+  }
+
+  size_t k = findHighestBit(us);
+  if (k >= MAX_LATENCY_BITS) {
+    return N_BUCKETS - 1;
+  }
+
+  // group k-SUB_BUCKET_BITS+1 covers [2^k, 2^(k+1)); the bits after the leading one select
+  // the bucket within the group
+  size_t subBucket = static_cast<size_t>(us >> (k - SUB_BUCKET_BITS)) - SUB_BUCKETS;
+  return (k - SUB_BUCKET_BITS + 1) * SUB_BUCKETS + subBucket;
+}
+
+time::microseconds
+LatencyHistogram::getBucketUpperBound(size_t i)
+{
+  BOOST_ASSERT(i < N_BUCKETS);
+  if (i < SUB_BUCKETS) {
+    return time::microseconds(i + 1);
+  }
+
+  size_t group = i / SUB_BUCKETS;
+  uint64_t subBucket = i % SUB_BUCKETS;
+  uint64_t width = uint64_t(1) << (group - 1);
+  return time::microseconds((SUB_BUCKETS + subBucket) * width + width);
+}
+
+void
+LatencyHistogram::record(time::nanoseconds latency)
+{
+  uint64_t us = latency < time::nanoseconds::zero() ? 0 :
+                static_cast<uint64_t>(time::duration_cast<time::microseconds>(latency).count());
+
+  m_buckets[getBucketIndex(us)].fetch_add(1, std::memory_order_relaxed);
+  m_count.fetch_add(1, std::memory_order_relaxed);
+  m_sumMicroseconds.fetch_add(us, std::memory_order_relaxed);
+}
+
+time::microseconds
+LatencyHistogram::getMean() const
+{
+  uint64_t count = this->getCount();
+  if (count == 0) {
+    return time::microseconds::zero();
+  }
+  return time::microseconds(m_sumMicroseconds.load(std::memory_order_relaxed) / count);
+}
+
+time::microseconds
+LatencyHistogram::getQuantile(double q) const
+{
+  uint64_t count = this->getCount();
+  if (count == 0) {
+    return time::microseconds::zero();
+  }
+
+  // rank of the quantile among the measurements, starting from 1
+  uint64_t rank = std::max<uint64_t>(1, static_cast<uint64_t>(std::ceil(q * count)));
+  uint64_t seen = 0;
+  for (size_t i = 0; i < N_BUCKETS; ++i) {
+    seen += m_buckets[i].load(std::memory_order_relaxed);
+    if (seen >= rank) {
+      return getBucketUpperBound(i);
+    }
+  }
+  // concurrent recordings may have incremented m_count before their bucket
+  return getBucketUpperBound(N_BUCKETS - 1);
+}
+
+} // namespace util
+} // namespace ndn
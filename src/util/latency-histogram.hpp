@@ -0,0 +1,121 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2013-2017 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#ifndef NDN_UTIL_LATENCY_HISTOGRAM_HPP
+#define NDN_UTIL_LATENCY_HISTOGRAM_HPP
+
+#include "../common.hpp"
+#include "time.hpp"
+
+#include <array>
+#include <atomic>
+
+namespace ndn {
+namespace util {
+
+/** \brief a histogram of latencies with log-linear buckets
+ *
+ *  Latencies are measured in microseconds.  Each power-of-two range [2^k, 2^(k+1)) is
+ *  divided into SUB_BUCKETS buckets of equal width, so that the relative error of a
+ *  reported value is at most 1/SUB_BUCKETS, while the whole range from 1us to over one
+ *  hour fits in a few hundred counters.  Latencies beyond the range are counted in the
+ *  last bucket.
+ *
+ *  record() uses relaxed atomic operations, so that a histogram can be updated on one
+ *  thread and read on another without locking.  A reader may observe a recording that
+ *  is partially applied, e.g., the total count incremented but not yet the bucket.
+ */
+class LatencyHistogram : noncopyable
+{
+public:
+  /** \brief number of buckets in each power-of-two range, as a power of two
+   */
+  static const size_t SUB_BUCKET_BITS = 3;
+  static const size_t SUB_BUCKETS = 1 << SUB_BUCKET_BITS;
+
+  /** \brief latencies up to 2^MAX_LATENCY_BITS microseconds are distinguished
+   */
+  static const size_t MAX_LATENCY_BITS = 32;
+
+  static const size_t N_BUCKETS = (MAX_LATENCY_BITS - SUB_BUCKET_BITS + 1) * SUB_BUCKETS;
+
+  LatencyHistogram();
+
+  /** \brief count one measurement
+   *  \note This function is thread-safe.
+   */
+  void
+  record(time::nanoseconds latency);
+
+  /** \brief zero all counters
+   */
+  void
+  reset();
+
+  /** \return number of recorded measurements
+   */
+  uint64_t
+  getCount() const
+  {
+    return m_count.load(std::memory_order_relaxed);
+  }
+
+  /** \return mean of recorded measurements, or zero if there is none
+   */
+  time::microseconds
+  getMean() const;
+
+  /** \brief estimate a quantile of recorded measurements
+   *  \param q a value in [0, 1], e.g., 0.99 for the 99th percentile
+   *  \return upper bound of the bucket that contains the quantile, or zero if there is no
+   *          measurement
+   */
+  time::microseconds
+  getQuantile(double q) const;
+
+  /** \return number of measurements in bucket \p i
+   */
+  uint64_t
+  getBucketCount(size_t i) const
+  {
+    return m_buckets.at(i).load(std::memory_order_relaxed);
+  }
+
+  /** \return exclusive upper bound of bucket \p i
+   */
+  static time::microseconds
+  getBucketUpperBound(size_t i);
+
+  /** \return index of the bucket that counts a latency of \p us microseconds
+   */
+  static size_t
+  getBucketIndex(uint64_t us);
+
+private:
+  std::array<std::atomic<uint64_t>, N_BUCKETS> m_buckets;
+  std::atomic<uint64_t> m_count;
+  std::atomic<uint64_t> m_sumMicroseconds;
+};
+
+} // namespace util
+} // namespace ndn
+
+#endif // NDN_UTIL_LATENCY_HISTOGRAM_HPP
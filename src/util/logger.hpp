@@ -28,6 +28,8 @@
 #include "ndn-cxx-custom-logger.hpp"
 #else
 
+#include "binary-log-backend.hpp"
+
 #include <boost/log/common.hpp>
 #include <boost/log/sources/logger.hpp>
 #include <atomic>
@@ -129,9 +131,15 @@ operator<<(std::ostream& os, const LoggerTimestamp&);
 #define NDN_LOG(lvl, lvlstr, expression) \
   do { \
     if (getNdnCxxLogger().isLevelEnabled(::ndn::util::LogLevel::lvl)) { \
-      NDN_BOOST_LOG(getNdnCxxLogger()) << ::ndn::util::LoggerTimestamp{} \
-        << " " BOOST_STRINGIZE(lvlstr) ": [" << getNdnCxxLogger().getModuleName() << "] " \
-        << expression; \
+      if (::ndn::util::BinaryLogBackend::isInstalled()) { \
+        ::ndn::util::BinaryLogRecord ndnCxxLogRecord(getNdnCxxLogger(), BOOST_STRINGIZE(lvlstr)); \
+        ndnCxxLogRecord.getStream() << expression; \
+      } \
+      else { \
+        NDN_BOOST_LOG(getNdnCxxLogger()) << ::ndn::util::LoggerTimestamp{} \
+          << " " BOOST_STRINGIZE(lvlstr) ": [" << getNdnCxxLogger().getModuleName() << "] " \
+          << expression; \
+      } \
     } \
   } while (false)
 
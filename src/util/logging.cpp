@@ -26,6 +26,7 @@
 #include <boost/range/algorithm/copy.hpp>
 #include <boost/range/adaptor/map.hpp>
 #include <cstdlib>
+#include <cstring>
 #include <fstream>
 
 namespace ndn {
@@ -43,8 +44,12 @@ Logging::get()
 }
 
 Logging::Logging()
+  : m_backend(Backend::BOOST_LOG)
 {
-  this->setDestinationImpl(shared_ptr<std::ostream>(&std::clog, bind([]{})));
+  const char* backendEnviron = std::getenv("NDN_LOG_BACKEND");
+  Backend backend = backendEnviron != nullptr && std::strcmp(backendEnviron, "binary") == 0 ?
+                    Backend::BINARY : Backend::BOOST_LOG;
+  this->setDestinationImpl(shared_ptr<std::ostream>(&std::clog, bind([]{})), backend);
 
   const char* environ = std::getenv("NDN_LOG");
   if (environ != nullptr) {
@@ -183,10 +188,35 @@ Logging::setDestination(std::ostream& os)
 
 void
 Logging::setDestinationImpl(shared_ptr<std::ostream> os)
+{
+  Backend backendType;
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    backendType = m_backend;
+  }
+  this->setDestinationImpl(os, backendType);
+}
+
+void
+Logging::setDestinationImpl(shared_ptr<std::ostream> os, Backend backendType)
 {
   std::lock_guard<std::mutex> lock(m_mutex);
 
   m_destination = os;
+  m_backend = backendType;
+
+  // the previous binary backend is released only after another one (or none) is installed,
+  // so that it is never destroyed while still receiving records
+  shared_ptr<BinaryLogBackend> oldBinaryBackend = std::move(m_binaryBackend);
+  if (backendType == Backend::BINARY) {
+    m_binaryBackend = make_shared<BinaryLogBackend>(os);
+    BinaryLogBackend::install(m_binaryBackend);
+  }
+  else if (oldBinaryBackend != nullptr) {
+    // records submitted before this point are written into the previous destination
+    BinaryLogBackend::install(nullptr);
+  }
+  oldBinaryBackend.reset();
 
   auto backend = boost::make_shared<boost::log::sinks::text_ostream_backend>();
   backend->auto_flush(true);
@@ -214,6 +244,15 @@ Logging::getDestination()
 void
 Logging::flushImpl()
 {
+  shared_ptr<BinaryLogBackend> binaryBackend;
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    binaryBackend = m_binaryBackend;
+  }
+
+  if (binaryBackend != nullptr) {
+    binaryBackend->flush();
+  }
   m_sink->flush();
 }
 
@@ -37,6 +37,7 @@ namespace util {
 
 enum class LogLevel;
 class Logger;
+class BinaryLogBackend;
 
 /** \brief controls the logging facility
  *
@@ -46,6 +47,17 @@ class Logger;
 class Logging : noncopyable
 {
 public:
+  /** \brief indicates how log records are written to the destination
+   */
+  enum class Backend {
+    /** \brief records are passed to Boost.Log, and written by an asynchronous sink
+     */
+    BOOST_LOG,
+    /** \brief records are stored into per-thread ring buffers, and written by BinaryLogBackend
+     */
+    BINARY
+  };
+
   /** \brief register a new logger
    *  \note App should declare a new logger with \p NDN_LOG_INIT macro.
    */
@@ -90,10 +102,21 @@ public:
    *  \param os a stream for log output
    *
    *  Initial destination is \p std::clog .
+   *  The backend is unchanged.
    */
   static void
   setDestination(shared_ptr<std::ostream> os);
 
+  /** \brief set log destination and backend
+   *  \param os a stream for log output
+   *  \param backend the backend that writes log records into \p os
+   *
+   *  Initial backend is \p Backend::BINARY if the environment variable NDN_LOG_BACKEND is
+   *  "binary", and \p Backend::BOOST_LOG otherwise.
+   */
+  static void
+  setDestination(shared_ptr<std::ostream> os, Backend backend);
+
   /** \brief set log destination
    *  \param os a stream for log output; caller must ensure this is valid
    *            until setDestination is invoked again or program exits
@@ -131,6 +154,9 @@ private:
   void
   setDestinationImpl(shared_ptr<std::ostream> os);
 
+  void
+  setDestinationImpl(shared_ptr<std::ostream> os, Backend backend);
+
   void
   flushImpl();
 
@@ -160,6 +186,9 @@ private:
   shared_ptr<std::ostream> m_destination;
   typedef boost::log::sinks::asynchronous_sink<boost::log::sinks::text_ostream_backend> Sink;
   boost::shared_ptr<Sink> m_sink;
+
+  Backend m_backend;
+  shared_ptr<BinaryLogBackend> m_binaryBackend;
 };
 
 inline void
@@ -192,6 +221,12 @@ Logging::setDestination(shared_ptr<std::ostream> os)
   get().setDestinationImpl(os);
 }
 
+inline void
+Logging::setDestination(shared_ptr<std::ostream> os, Backend backend)
+{
+  get().setDestinationImpl(os, backend);
+}
+
 inline void
 Logging::flush()
 {
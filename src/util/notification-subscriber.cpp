@@ -41,12 +41,25 @@ NotificationSubscriberBase::NotificationSubscriberBase(Face& face, const Name& p
   , m_attempts(1)
   , m_scheduler(face.getIoService())
   , m_nackEvent(m_scheduler)
+  , m_lastInterestId(nullptr)
   , m_interestLifetime(interestLifetime)
+  , m_windowSize(1)
+  , m_catchUpLifetime(time::seconds(1))
+  , m_highestSequenceNo(std::numeric_limits<uint64_t>::max())
 {
 }
 
 NotificationSubscriberBase::~NotificationSubscriberBase() = default;
 
+void
+NotificationSubscriberBase::setWindowSize(size_t windowSize)
+{
+  if (windowSize == 0) {
+    BOOST_THROW_EXCEPTION(std::invalid_argument("windowSize must be positive"));
+  }
+  m_windowSize = windowSize;
+}
+
 void
 NotificationSubscriberBase::start()
 {
@@ -67,6 +80,8 @@ NotificationSubscriberBase::stop()
   if (m_lastInterestId != 0)
     m_face.removePendingInterest(m_lastInterestId);
   m_lastInterestId = 0;
+
+  this->clearPipeline();
 }
 
 void
@@ -124,8 +139,9 @@ NotificationSubscriberBase::afterReceiveData(const Data& data)
   if (this->shouldStop())
     return;
 
+  uint64_t sequenceNo = 0;
   try {
-    m_lastSequenceNo = data.getName().get(-1).toSequenceNumber();
+    sequenceNo = data.getName().get(-1).toSequenceNumber();
   }
   catch (const tlv::Error&) {
     this->onDecodeError(data);
@@ -133,6 +149,13 @@ NotificationSubscriberBase::afterReceiveData(const Data& data)
     return;
   }
 
+  if (m_windowSize > 1) {
+    m_lastInterestId = nullptr;
+    this->startPipeline(sequenceNo, data);
+    return;
+  }
+
+  m_lastSequenceNo = sequenceNo;
   if (!this->decodeAndDeliver(data)) {
     this->onDecodeError(data);
     this->sendInitialInterest();
@@ -149,6 +172,7 @@ NotificationSubscriberBase::afterReceiveNack(const lp::Nack& nack)
     return;
 
   this->onNack(nack);
+  this->clearPipeline();
 
   time::milliseconds delay = exponentialBackoff(nack);
   m_nackEvent = m_scheduler.scheduleEvent(delay, [this] {this->sendInitialInterest();});
@@ -165,6 +189,155 @@ NotificationSubscriberBase::afterTimeout()
   this->sendInitialInterest();
 }
 
+void
+NotificationSubscriberBase::startPipeline(uint64_t sequenceNo, const Data& data)
+{
+  this->clearPipeline();
+
+  // After a timeout or Nack, the notifications published since the last delivered one are
+  // retrieved from the publisher's storage.  A sequence number lower than the last delivered
+  // one indicates that the publisher has restarted, so there is nothing to retrieve.
+  if (m_lastSequenceNo == std::numeric_limits<uint64_t>::max() || sequenceNo < m_lastSequenceNo) {
+    m_lastSequenceNo = sequenceNo - 1;
+  }
+  m_highestSequenceNo = sequenceNo;
+  if (sequenceNo != m_lastSequenceNo) {
+    m_pipeline[sequenceNo].data = make_shared<Data>(data);
+  }
+
+  this->deliverPipeline();
+  this->fillPipeline();
+}
+
+void
+NotificationSubscriberBase::fillPipeline()
+{
+  if (this->shouldStop())
+    return;
+
+  for (uint64_t sequenceNo = m_lastSequenceNo + 1;
+       sequenceNo <= m_lastSequenceNo + m_windowSize; ++sequenceNo) {
+    PipelineSlot& slot = m_pipeline[sequenceNo];
+    if (slot.interestId == nullptr && slot.data == nullptr && !slot.isMissing) {
+      this->expressPipelinedInterest(sequenceNo, slot);
+    }
+  }
+}
+
+void
+NotificationSubscriberBase::expressPipelinedInterest(uint64_t sequenceNo, PipelineSlot& slot)
+{
+  Name name = m_prefix;
+  name.appendSequenceNumber(sequenceNo);
+
+  Interest interest(name);
+  slot.isCatchUp = sequenceNo <= m_highestSequenceNo;
+  interest.setInterestLifetime(slot.isCatchUp ? m_catchUpLifetime : getInterestLifetime());
+
+  slot.interestId = m_face.expressInterest(interest,
+                      bind(&NotificationSubscriberBase::afterReceivePipelinedData, this,
+                           sequenceNo, _2),
+                      bind(&NotificationSubscriberBase::afterReceiveNack, this, _2),
+                      bind(&NotificationSubscriberBase::afterPipelinedTimeout, this, sequenceNo));
+}
+
+void
+NotificationSubscriberBase::deliverPipeline()
+{
+  for (auto it = m_pipeline.find(m_lastSequenceNo + 1);
+       it != m_pipeline.end() && (it->second.data != nullptr || it->second.isMissing);
+       it = m_pipeline.find(m_lastSequenceNo + 1)) {
+    if (this->shouldStop())
+      return;
+
+    PipelineSlot slot = it->second;
+    m_pipeline.erase(it);
+    ++m_lastSequenceNo;
+
+    if (slot.isMissing) {
+      this->onGap(m_lastSequenceNo);
+    }
+    else if (!this->decodeAndDeliver(*slot.data)) {
+      this->onDecodeError(*slot.data);
+    }
+  }
+}
+
+void
+NotificationSubscriberBase::clearPipeline()
+{
+  for (const auto& entry : m_pipeline) {
+    if (entry.second.interestId != nullptr) {
+      m_face.removePendingInterest(entry.second.interestId);
+    }
+  }
+  m_pipeline.clear();
+}
+
+void
+NotificationSubscriberBase::afterReceivePipelinedData(uint64_t sequenceNo, const Data& data)
+{
+  if (this->shouldStop())
+    return;
+
+  auto it = m_pipeline.find(sequenceNo);
+  if (it == m_pipeline.end() || it->second.interestId == nullptr) {
+    return;
+  }
+  it->second.interestId = nullptr;
+  it->second.data = make_shared<Data>(data);
+
+  if (sequenceNo > m_highestSequenceNo) {
+    m_highestSequenceNo = sequenceNo;
+
+    // earlier notifications have been published as well, but their Data did not arrive;
+    // ask the publisher again, and give up after the catch-up lifetime
+    for (auto& entry : m_pipeline) {
+      if (entry.first >= sequenceNo) {
+        break;
+      }
+      if (entry.second.interestId != nullptr && !entry.second.isCatchUp) {
+        m_face.removePendingInterest(entry.second.interestId);
+        this->expressPipelinedInterest(entry.first, entry.second);
+      }
+    }
+  }
+
+  this->deliverPipeline();
+  this->fillPipeline();
+}
+
+void
+NotificationSubscriberBase::afterPipelinedTimeout(uint64_t sequenceNo)
+{
+  if (this->shouldStop())
+    return;
+
+  auto it = m_pipeline.find(sequenceNo);
+  if (it == m_pipeline.end()) {
+    return;
+  }
+  it->second.interestId = nullptr;
+
+  if (it->second.isCatchUp) {
+    it->second.isMissing = true;
+    this->deliverPipeline();
+    this->fillPipeline();
+    return;
+  }
+
+  if (sequenceNo == m_lastSequenceNo + 1) {
+    // nothing has been published within InterestLifetime; the publisher may have restarted,
+    // so the latest sequence number is learned again
+    this->onTimeout();
+    this->clearPipeline();
+    this->sendInitialInterest();
+    return;
+  }
+
+  this->expressPipelinedInterest(sequenceNo, it->second);
+}
+
 time::milliseconds
 NotificationSubscriberBase::exponentialBackoff(lp::Nack nack)
 {
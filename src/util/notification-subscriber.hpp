@@ -35,6 +35,8 @@
 #include "scheduler.hpp"
 #include "scheduler-scoped-event-id.hpp"
 
+#include <map>
+
 namespace ndn {
 namespace util {
 
@@ -61,6 +63,51 @@ public:
     return m_isRunning;
   }
 
+  /** \return number of notifications requested ahead of the last delivered one
+   */
+  size_t
+  getWindowSize() const
+  {
+    return m_windowSize;
+  }
+
+  /** \brief set the number of notifications requested ahead of the last delivered one
+   *  \param windowSize number of outstanding Interests; 1 selects the non-pipelined mode
+   *  \throw std::invalid_argument \p windowSize is zero
+   *
+   *  In the non-pipelined mode, one Interest is outstanding at any time, and notifications
+   *  published while the Interest for the next sequence number is not pending may be skipped.
+   *
+   *  In the pipelined mode, once the latest sequence number has been learned, Interests for the
+   *  next \p windowSize sequence numbers are kept outstanding, and notifications are delivered
+   *  in sequence number order.  Sequence numbers that are known to have been published, because
+   *  a later notification has been received, are requested with getCatchUpLifetime() and are
+   *  thus retrieved from the publisher's storage if still available; if such a notification
+   *  cannot be retrieved, onGap is emitted in its place.
+   *
+   *  This should be set before start().
+   */
+  void
+  setWindowSize(size_t windowSize);
+
+  /** \return InterestLifetime of Interests for notifications known to have been published
+   */
+  time::milliseconds
+  getCatchUpLifetime() const
+  {
+    return m_catchUpLifetime;
+  }
+
+  /** \brief set InterestLifetime of Interests for notifications known to have been published
+   *
+   *  This is how long the subscriber waits for a missing notification before declaring a gap.
+   */
+  void
+  setCatchUpLifetime(time::milliseconds lifetime)
+  {
+    m_catchUpLifetime = lifetime;
+  }
+
   /** \brief start or resume receiving notifications
    *  \note onNotification must have at least one listener,
    *        otherwise this operation has no effect.
@@ -115,6 +162,44 @@ private:
   time::milliseconds
   exponentialBackoff(lp::Nack nack);
 
+private: // pipelined mode
+  struct PipelineSlot
+  {
+    const PendingInterestId* interestId = nullptr;
+    bool isCatchUp = false; ///< whether the Interest was sent with catch-up lifetime
+    bool isMissing = false; ///< whether the notification could not be retrieved
+    shared_ptr<const Data> data; ///< received but not yet delivered
+  };
+
+  /** \brief (re)start the pipeline after the latest sequence number has been learned
+   */
+  void
+  startPipeline(uint64_t sequenceNo, const Data& data);
+
+  /** \brief express Interests for sequence numbers in the window that have no slot
+   */
+  void
+  fillPipeline();
+
+  void
+  expressPipelinedInterest(uint64_t sequenceNo, PipelineSlot& slot);
+
+  /** \brief deliver notifications and gaps at the head of the window, in order
+   */
+  void
+  deliverPipeline();
+
+  /** \brief remove pending Interests and undelivered notifications
+   */
+  void
+  clearPipeline();
+
+  void
+  afterReceivePipelinedData(uint64_t sequenceNo, const Data& data);
+
+  void
+  afterPipelinedTimeout(uint64_t sequenceNo);
+
 public:
   /** \brief fires when a NACK is received
    */
@@ -128,6 +213,12 @@ public:
    */
   signal::Signal<NotificationSubscriberBase, Data> onDecodeError;
 
+  /** \brief fires, in pipelined mode, in place of a notification that could not be retrieved
+   *
+   *  The argument is the sequence number of the missing notification.
+   */
+  signal::Signal<NotificationSubscriberBase, uint64_t> onGap;
+
 private:
   Face& m_face;
   Name m_prefix;
@@ -139,6 +230,11 @@ private:
   util::scheduler::ScopedEventId m_nackEvent;
   const PendingInterestId* m_lastInterestId;
   time::milliseconds m_interestLifetime;
+
+  size_t m_windowSize;
+  time::milliseconds m_catchUpLifetime;
+  uint64_t m_highestSequenceNo; ///< highest sequence number known to have been published
+  std::map<uint64_t, PipelineSlot> m_pipeline; ///< slots after m_lastSequenceNo
 };
 
 /** \brief provides a subscriber of Notification Stream
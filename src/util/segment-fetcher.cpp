@@ -68,6 +68,24 @@ SegmentFetcher::fetch(Face& face,
   fetcher->fetchFirstSegment(baseInterest, fetcher);
 }
 
+void
+SegmentFetcher::fetchEach(Face& face,
+                          const Interest& baseInterest,
+                          Validator& validator,
+                          const SegmentCallback& segmentCallback,
+                          const function<void()>& completeCallback,
+                          const ErrorCallback& errorCallback)
+{
+  shared_ptr<Validator> sharedValidator = shared_ptr<Validator>(&validator, [] (Validator*) {});
+
+  shared_ptr<SegmentFetcher> fetcher(new SegmentFetcher(face, sharedValidator,
+                                                        bind(completeCallback),
+                                                        errorCallback));
+  fetcher->m_segmentCallback = segmentCallback;
+
+  fetcher->fetchFirstSegment(baseInterest, fetcher);
+}
+
 void
 SegmentFetcher::fetchFirstSegment(const Interest& baseInterest,
                                   shared_ptr<SegmentFetcher> self)
@@ -123,8 +141,15 @@ SegmentFetcher::afterValidationSuccess(const shared_ptr<const Data> data,
       fetchNextSegment(origInterest, data->getName(), 0, self);
     }
     else {
-      m_buffer->write(reinterpret_cast<const char*>(data->getContent().value()),
-                      data->getContent().value_size());
+      if (m_segmentCallback) {
+        if (!m_segmentCallback(data->getContent())) {
+          return;
+        }
+      }
+      else {
+        m_buffer->write(reinterpret_cast<const char*>(data->getContent().value()),
+                        data->getContent().value_size());
+      }
 
       const name::Component& finalBlockId = data->getMetaInfo().getFinalBlockId();
       if (finalBlockId.empty() || (finalBlockId > currentSegment)) {
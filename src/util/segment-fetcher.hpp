@@ -65,6 +65,9 @@ namespace util {
  * 6. Fire onCompletion callback with memory block that combines content part from all
  *    segmented objects.
  *
+ * With fetchEach, the content of each segment is instead passed to a SegmentCallback as soon
+ * as the segment has been validated, in segment order, and nothing is accumulated.
+ *
  * If an error occurs during the fetching process, an error callback is fired
  * with a proper error code.  The following errors are possible:
  *
@@ -109,6 +112,12 @@ public:
   typedef function<void (const ConstBufferPtr& data)> CompleteCallback;
   typedef function<void (uint32_t code, const std::string& msg)> ErrorCallback;
 
+  /**
+   * @brief Callback invoked with the Content element of each validated segment
+   * @return whether fetching should continue; if false, no other callback will be invoked
+   */
+  typedef function<bool (const Block& content)> SegmentCallback;
+
   /**
    * @brief Error codes that can be passed to ErrorCallback
    */
@@ -167,6 +176,27 @@ public:
         const CompleteCallback& completeCallback,
         const ErrorCallback& errorCallback);
 
+  /**
+   * @brief Initiate segment fetching, delivering segments one by one
+   *
+   * @param face             Reference to the Face that should be used to fetch data
+   * @param baseInterest     An Interest for the initial segment of requested data,
+   *                         see the other overloads
+   * @param validator        Reference to the Validator that should be used to validate data.
+   *                         Caller must ensure validator is valid until fetching ends.
+   * @param segmentCallback  Callback to be fired with the content of each segment, in order
+   * @param completeCallback Callback to be fired after the last segment has been delivered
+   * @param errorCallback    Callback to be fired when an error occurs (@see Errors)
+   */
+  static
+  void
+  fetchEach(Face& face,
+            const Interest& baseInterest,
+            Validator& validator,
+            const SegmentCallback& segmentCallback,
+            const function<void()>& completeCallback,
+            const ErrorCallback& errorCallback);
+
 private:
   SegmentFetcher(Face& face,
                  shared_ptr<Validator> validator,
@@ -207,6 +237,7 @@ private:
   shared_ptr<Validator> m_validator;
   CompleteCallback m_completeCallback;
   ErrorCallback m_errorCallback;
+  SegmentCallback m_segmentCallback; ///< if set, segments are not accumulated in m_buffer
 
   shared_ptr<OBufferStream> m_buffer;
 };
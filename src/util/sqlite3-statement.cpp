@@ -26,16 +26,66 @@
 namespace ndn {
 namespace util {
 
+static sqlite3_stmt*
+prepare(sqlite3* database, const std::string& statement)
+{
+  sqlite3_stmt* stmt = nullptr;
+  int res = sqlite3_prepare_v2(database, statement.c_str(), -1, &stmt, nullptr);
+  if (res != SQLITE_OK)
+    BOOST_THROW_EXCEPTION(std::domain_error("bad SQL statement: " + statement));
+  return stmt;
+}
+
+Sqlite3StatementCache::Sqlite3StatementCache(sqlite3* database)
+  : m_database(database)
+{
+}
+
+Sqlite3StatementCache::~Sqlite3StatementCache()
+{
+  for (const auto& statement : m_statements) {
+    BOOST_ASSERT(!statement.second.isInUse);
+    sqlite3_finalize(statement.second.stmt);
+  }
+}
+
 Sqlite3Statement::~Sqlite3Statement()
 {
-  sqlite3_finalize(m_stmt);
+  if (m_cacheEntry != nullptr) {
+    sqlite3_reset(m_stmt);
+    sqlite3_clear_bindings(m_stmt);
+    m_cacheEntry->isInUse = false;
+  }
+  else {
+    sqlite3_finalize(m_stmt);
+  }
 }
 
 Sqlite3Statement::Sqlite3Statement(sqlite3* database, const std::string& statement)
+  : m_stmt(prepare(database, statement))
+  , m_cacheEntry(nullptr)
 {
-  int res = sqlite3_prepare_v2(database, statement.c_str(), -1, &m_stmt, nullptr);
-  if (res != SQLITE_OK)
-    BOOST_THROW_EXCEPTION(std::domain_error("bad SQL statement: " + statement));
+}
+
+Sqlite3Statement::Sqlite3Statement(Sqlite3StatementCache& cache, const std::string& statement)
+  : m_stmt(nullptr)
+  , m_cacheEntry(nullptr)
+{
+  auto it = cache.m_statements.find(statement);
+  if (it == cache.m_statements.end()) {
+    sqlite3_stmt* stmt = prepare(cache.m_database, statement);
+    it = cache.m_statements.emplace(statement, Sqlite3StatementCache::Entry{stmt, false}).first;
+  }
+
+  if (it->second.isInUse) {
+    // the cached statement is being stepped through by another instance
+    m_stmt = prepare(cache.m_database, statement);
+  }
+  else {
+    m_stmt = it->second.stmt;
+    m_cacheEntry = &it->second;
+    m_cacheEntry->isInUse = true;
+  }
 }
 
 int
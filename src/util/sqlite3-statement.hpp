@@ -23,6 +23,7 @@
 #define NDN_UTIL_SQLITE3_STATEMENT_HPP
 
 #include "../encoding/block.hpp"
+#include <map>
 #include <string>
 
 struct sqlite3;
@@ -31,6 +32,56 @@ struct sqlite3_stmt;
 namespace ndn {
 namespace util {
 
+/**
+ * @brief cache of prepared statements of an SQLite3 database connection
+ *
+ * A Sqlite3Statement constructed from the cache reuses the prepared statement of the same
+ * SQL text, and returns it to the cache when destroyed, instead of preparing and finalizing
+ * the statement every time.
+ *
+ * The cache must be destroyed before the database connection is closed.
+ *
+ * @warning This class is implementation detail of ndn-cxx library.
+ */
+class Sqlite3StatementCache : noncopyable
+{
+public:
+  explicit
+  Sqlite3StatementCache(sqlite3* database);
+
+  /**
+   * @brief finalize all cached statements
+   */
+  ~Sqlite3StatementCache();
+
+  sqlite3*
+  getDatabase() const
+  {
+    return m_database;
+  }
+
+  /**
+   * @brief get the number of prepared statements in the cache
+   */
+  size_t
+  size() const
+  {
+    return m_statements.size();
+  }
+
+private:
+  struct Entry
+  {
+    sqlite3_stmt* stmt;
+    bool isInUse;
+  };
+
+  sqlite3* m_database;
+  std::map<std::string, Entry> m_statements;
+
+  friend class Sqlite3Statement;
+};
+
 /**
  * @brief wrap an SQLite3 prepared statement
  * @warning This class is implementation detail of ndn-cxx library.
@@ -47,7 +98,20 @@ public:
   Sqlite3Statement(sqlite3* database, const std::string& statement);
 
   /**
-   * @brief finalize the statement
+   * @brief initialize Sqlite3 statement from the prepared statement cache
+   *
+   * If the statement is not in @p cache, it is prepared and added to @p cache.
+   * If the cached statement is being used by another Sqlite3Statement instance,
+   * a separate statement is prepared and finalized upon destruction.
+   *
+   * @param cache prepared statement cache of the database connection
+   * @param statement SQL statement
+   * @throw std::domain_error SQL statement is bad
+   */
+  Sqlite3Statement(Sqlite3StatementCache& cache, const std::string& statement);
+
+  /**
+   * @brief finalize the statement, or reset it and return it to the cache
    */
   ~Sqlite3Statement();
 
@@ -150,6 +214,7 @@ public:
 
 private:
   sqlite3_stmt* m_stmt;
+  Sqlite3StatementCache::Entry* m_cacheEntry; ///< nullptr if the statement is not cached
 };
 
 } // namespace util
@@ -0,0 +1,114 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2013-2017 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#define BOOST_TEST_MAIN 1
+#define BOOST_TEST_DYN_LINK 1
+#define BOOST_TEST_MODULE ndn-cxx Face Multi-Producer Benchmark
+
+#include "face.hpp"
+#include "util/dummy-client-face.hpp"
+#include "security/signature-sha256-with-rsa.hpp"
+#include "encoding/block-helpers.hpp"
+
+#include "boost-test.hpp"
+
+#include <thread>
+
+namespace ndn {
+namespace tests {
+
+using util::DummyClientFace;
+
+const size_t N_THREADS = 4;
+const size_t N_PACKETS_PER_THREAD = 50000;
+
+static shared_ptr<Data>
+makeSignedData(const Name& name)
+{
+  auto data = make_shared<Data>(name);
+  data->setContent(std::vector<uint8_t>(100).data(), 100);
+  SignatureSha256WithRsa fakeSignature;
+  fakeSignature.setValue(encoding::makeEmptyBlock(tlv::SignatureValue));
+  data->setSignature(fakeSignature);
+  return data;
+}
+
+/** \brief publish Data from producer threads while another thread runs the io_service
+ *  \param useMultiProducer whether to use multi-producer mode, or post a closure per packet
+ *  \return elapsed time until all packets are sent
+ */
+static time::nanoseconds
+publish(bool useMultiProducer)
+{
+  boost::asio::io_service io;
+  DummyClientFace face(io, {false, false});
+  if (useMultiProducer) {
+    face.enableMultiProducer();
+  }
+
+  size_t nSent = 0; // only accessed on the io_service thread
+  face.onSendData.connect([&nSent] (const Data&) { ++nSent; });
+
+  unique_ptr<boost::asio::io_service::work> work(new boost::asio::io_service::work(io));
+  std::thread ioThread([&io] { io.run(); });
+
+  time::steady_clock::TimePoint t1 = time::steady_clock::now();
+  std::vector<std::thread> producers;
+  for (size_t t = 0; t < N_THREADS; ++t) {
+    producers.emplace_back([&face, &io, t, useMultiProducer] {
+      for (size_t i = 0; i < N_PACKETS_PER_THREAD; ++i) {
+        auto data = makeSignedData(Name("/producer").appendNumber(t).appendSegment(i));
+        if (useMultiProducer) {
+          face.put(*data);
+        }
+        else {
+          io.post([&face, data] { face.put(*data); });
+        }
+      }
+    });
+  }
+  for (std::thread& producer : producers) {
+    producer.join();
+  }
+  work.reset();
+  ioThread.join();
+  time::steady_clock::TimePoint t2 = time::steady_clock::now();
+
+  BOOST_CHECK_EQUAL(nSent, N_THREADS * N_PACKETS_PER_THREAD);
+  return t2 - t1;
+}
+
+BOOST_AUTO_TEST_CASE(PutData)
+{
+  time::nanoseconds postTime = publish(false);
+  time::nanoseconds queueTime = publish(true);
+
+  size_t nPackets = N_THREADS * N_PACKETS_PER_THREAD;
+  BOOST_TEST_MESSAGE("put " << nPackets << " Data from " << N_THREADS << " threads, "
+                     "io_service::post: " << postTime << ", " <<
+                     (nPackets * 1000000000 / postTime.count()) << " packets/s");
+  BOOST_TEST_MESSAGE("put " << nPackets << " Data from " << N_THREADS << " threads, "
+                     "multi-producer: " << queueTime << ", " <<
+                     (nPackets * 1000000000 / queueTime.count()) << " packets/s");
+}
+
+} // namespace tests
+} // namespace ndn
@@ -0,0 +1,112 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2013-2017 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+
+#define BOOST_TEST_MAIN 1
+#define BOOST_TEST_DYN_LINK 1
+#define BOOST_TEST_MODULE ndn-cxx Interest Re-expression Benchmark
+
+#include "interest.hpp"
+#include "util/time.hpp"
+
+#include "boost-test.hpp"
+
+namespace ndn {
+namespace tests {
+
+const int N_ITERATIONS = 200000;
+
+static Interest
+makeTestInterest()
+{
+  Name name("/localhost/nfd/rib/register");
+  name.appendVersion(1468108800311239LL)
+      .appendSegment(42);
+
+  Interest interest(name, time::milliseconds(1000));
+  interest.setMustBeFresh(true);
+  interest.setChildSelector(1);
+  interest.setNonce(1);
+  return interest;
+}
+
+BOOST_AUTO_TEST_CASE(RefreshNonce)
+{
+  Interest interest = makeTestInterest();
+  interest.wireEncode();
+  size_t totalSize = 0;
+
+  time::steady_clock::TimePoint t1 = time::steady_clock::now();
+  for (int i = 0; i < N_ITERATIONS; ++i) {
+    // full encoding, as done when the Nonce update reset the wire
+    Interest retx(interest.getName(), interest.getInterestLifetime());
+    retx.setSelectors(interest.getSelectors());
+    retx.setNonce(static_cast<uint32_t>(i));
+    totalSize += retx.wireEncode().size();
+  }
+  time::steady_clock::TimePoint t2 = time::steady_clock::now();
+  for (int i = 0; i < N_ITERATIONS; ++i) {
+    // copy of the original Interest, as in SegmentFetcher::reExpressInterest
+    Interest retx(interest);
+    retx.refreshNonce();
+    totalSize += retx.wireEncode().size();
+  }
+  time::steady_clock::TimePoint t3 = time::steady_clock::now();
+  for (int i = 0; i < N_ITERATIONS; ++i) {
+    interest.refreshNonce();
+    totalSize += interest.wireEncode().size();
+  }
+  time::steady_clock::TimePoint t4 = time::steady_clock::now();
+
+  BOOST_CHECK_GT(totalSize, 0);
+  BOOST_TEST_MESSAGE("re-express " << N_ITERATIONS << " Interests, full encoding: " << (t2 - t1));
+  BOOST_TEST_MESSAGE("re-express " << N_ITERATIONS << " Interests, refreshNonce on copy: " <<
+                     (t3 - t2));
+  BOOST_TEST_MESSAGE("re-express " << N_ITERATIONS << " Interests, refreshNonce in place: " <<
+                     (t4 - t3));
+}
+
+BOOST_AUTO_TEST_CASE(SetInterestLifetime)
+{
+  Interest interest = makeTestInterest();
+  interest.wireEncode();
+  size_t totalSize = 0;
+
+  time::steady_clock::TimePoint t1 = time::steady_clock::now();
+  for (int i = 0; i < N_ITERATIONS; ++i) {
+    // the lifetime changes the encoded length, so the wire has to be encoded again
+    interest.setInterestLifetime(time::milliseconds(i % 2 == 0 ? 100 : 1000));
+    totalSize += interest.wireEncode().size();
+  }
+  time::steady_clock::TimePoint t2 = time::steady_clock::now();
+  for (int i = 0; i < N_ITERATIONS; ++i) {
+    interest.setInterestLifetime(time::milliseconds(1000 + i % 1000));
+    totalSize += interest.wireEncode().size();
+  }
+  time::steady_clock::TimePoint t3 = time::steady_clock::now();
+
+  BOOST_CHECK_GT(totalSize, 0);
+  BOOST_TEST_MESSAGE("set " << N_ITERATIONS << " InterestLifetimes, full encoding: " << (t2 - t1));
+  BOOST_TEST_MESSAGE("set " << N_ITERATIONS << " InterestLifetimes, in place: " << (t3 - t2));
+}
+
+} // namespace tests
+} // namespace ndn
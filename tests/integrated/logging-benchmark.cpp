@@ -0,0 +1,115 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2013-2017 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#define BOOST_TEST_MAIN 1
+#define BOOST_TEST_DYN_LINK 1
+#define BOOST_TEST_MODULE ndn-cxx Logging Benchmark
+
+#include "util/logging.hpp"
+#include "util/logger.hpp"
+#include "util/time.hpp"
+
+#include "boost-test.hpp"
+
+#include <thread>
+
+namespace ndn {
+namespace util {
+namespace tests {
+
+NDN_LOG_INIT(ndn.util.tests.LoggingBenchmark);
+
+/** \brief stream buffer that discards its input
+ */
+class NullStreamBuf : public std::streambuf
+{
+protected:
+  int_type
+  overflow(int_type ch) final
+  {
+    return traits_type::not_eof(ch);
+  }
+
+  std::streamsize
+  xsputn(const char*, std::streamsize n) final
+  {
+    return n;
+  }
+};
+
+const int N_RECORDS = 200000;
+const int N_THREADS = 4;
+
+static time::nanoseconds
+logRecords(Logging::Backend backend, int nThreads)
+{
+  NullStreamBuf buf;
+  auto os = make_shared<std::ostream>(&buf);
+  Logging::setDestination(os, backend);
+  Logging::setLevel("ndn.util.tests.LoggingBenchmark", LogLevel::INFO);
+
+  auto logLoop = [] {
+    for (int i = 0; i < N_RECORDS; ++i) {
+      NDN_LOG_INFO("record " << i << " of " << N_RECORDS);
+    }
+  };
+
+  time::steady_clock::TimePoint t1 = time::steady_clock::now();
+  std::vector<std::thread> threads;
+  for (int i = 0; i < nThreads; ++i) {
+    threads.emplace_back(logLoop);
+  }
+  for (std::thread& thread : threads) {
+    thread.join();
+  }
+  time::steady_clock::TimePoint t2 = time::steady_clock::now();
+
+  Logging::flush();
+  Logging::setDestination(shared_ptr<std::ostream>(&std::clog, bind([]{})),
+                          Logging::Backend::BOOST_LOG);
+  return t2 - t1;
+}
+
+BOOST_AUTO_TEST_CASE(SingleThread)
+{
+  time::nanoseconds boostLog = logRecords(Logging::Backend::BOOST_LOG, 1);
+  time::nanoseconds binary = logRecords(Logging::Backend::BINARY, 1);
+
+  BOOST_TEST_MESSAGE("log " << N_RECORDS << " records, Boost.Log backend: " << boostLog <<
+                     ", " << (boostLog.count() / N_RECORDS) << " ns/record");
+  BOOST_TEST_MESSAGE("log " << N_RECORDS << " records, binary backend: " << binary <<
+                     ", " << (binary.count() / N_RECORDS) << " ns/record");
+}
+
+BOOST_AUTO_TEST_CASE(MultiThread)
+{
+  time::nanoseconds boostLog = logRecords(Logging::Backend::BOOST_LOG, N_THREADS);
+  time::nanoseconds binary = logRecords(Logging::Backend::BINARY, N_THREADS);
+
+  BOOST_TEST_MESSAGE("log " << N_RECORDS << " records from each of " << N_THREADS <<
+                     " threads, Boost.Log backend: " << boostLog);
+  BOOST_TEST_MESSAGE("log " << N_RECORDS << " records from each of " << N_THREADS <<
+                     " threads, binary backend: " << binary);
+}
+
+} // namespace tests
+} // namespace util
+} // namespace ndn
@@ -0,0 +1,111 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2013-2017 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#define BOOST_TEST_MAIN 1
+#define BOOST_TEST_DYN_LINK 1
+#define BOOST_TEST_MODULE ndn-cxx Name URI Benchmark
+
+#include "name.hpp"
+#include "util/time.hpp"
+
+#include "boost-test.hpp"
+
+namespace ndn {
+namespace tests {
+
+const int N_ITERATIONS = 200000;
+
+static Name
+makeTestName()
+{
+  Name name("/localhost/nfd/rib/register");
+  name.append("ndn-cxx%20name with escaping")
+      .appendVersion(1468108800311239LL)
+      .appendSegment(42);
+  return name;
+}
+
+BOOST_AUTO_TEST_CASE(Format)
+{
+  Name name = makeTestName();
+  size_t totalSize = 0;
+
+  time::steady_clock::TimePoint t1 = time::steady_clock::now();
+  for (int i = 0; i < N_ITERATIONS; ++i) {
+    std::ostringstream os;
+    for (const name::Component& component : name) {
+      os << '/';
+      component.toUri(os);
+    }
+    totalSize += os.str().size();
+  }
+  time::steady_clock::TimePoint t2 = time::steady_clock::now();
+  for (int i = 0; i < N_ITERATIONS; ++i) {
+    totalSize += name.toUri().size();
+  }
+  time::steady_clock::TimePoint t3 = time::steady_clock::now();
+  std::string uri;
+  for (int i = 0; i < N_ITERATIONS; ++i) {
+    uri.clear();
+    name.toUri(uri);
+    totalSize += uri.size();
+  }
+  time::steady_clock::TimePoint t4 = time::steady_clock::now();
+
+  BOOST_CHECK_GT(totalSize, 0);
+  BOOST_TEST_MESSAGE("format " << N_ITERATIONS << " names, ostringstream: " << (t2 - t1));
+  BOOST_TEST_MESSAGE("format " << N_ITERATIONS << " names, toUri(): " << (t3 - t2));
+  BOOST_TEST_MESSAGE("format " << N_ITERATIONS << " names, toUri(string&) reused: " << (t4 - t3));
+}
+
+BOOST_AUTO_TEST_CASE(Parse)
+{
+  std::string uri = makeTestName().toUri();
+  size_t totalSize = 0;
+
+  time::steady_clock::TimePoint t1 = time::steady_clock::now();
+  for (int i = 0; i < N_ITERATIONS; ++i) {
+    // per-component parsing, as done by Name(std::string) previously
+    Name name;
+    size_t start = 1;
+    while (start < uri.size()) {
+      size_t end = uri.find('/', start);
+      if (end == std::string::npos)
+        end = uri.size();
+      name.append(name::Component::fromEscapedString(uri.c_str(), start, end));
+      start = end + 1;
+    }
+    totalSize += name.wireEncode().size();
+  }
+  time::steady_clock::TimePoint t2 = time::steady_clock::now();
+  for (int i = 0; i < N_ITERATIONS; ++i) {
+    Name name(uri);
+    totalSize += name.wireEncode().size();
+  }
+  time::steady_clock::TimePoint t3 = time::steady_clock::now();
+
+  BOOST_CHECK_GT(totalSize, 0);
+  BOOST_TEST_MESSAGE("parse " << N_ITERATIONS << " names, per-component append: " << (t2 - t1));
+  BOOST_TEST_MESSAGE("parse " << N_ITERATIONS << " names, Name(std::string): " << (t3 - t2));
+}
+
+} // namespace tests
+} // namespace ndn
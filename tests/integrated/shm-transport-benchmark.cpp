@@ -0,0 +1,225 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2013-2017 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#define BOOST_TEST_MAIN 1
+#define BOOST_TEST_DYN_LINK 1
+#define BOOST_TEST_MODULE ndn-cxx ShmTransport Benchmark
+
+#include "transport/shm-transport.hpp"
+#include "transport/unix-transport.hpp"
+#include "interest.hpp"
+#include "util/time.hpp"
+
+#include "boost-test.hpp"
+
+#include <boost/asio.hpp>
+#include <boost/filesystem.hpp>
+
+#include <atomic>
+#include <thread>
+
+#include <poll.h>
+#include <unistd.h>
+
+namespace ndn {
+namespace tests {
+
+using boost::asio::local::stream_protocol;
+
+const size_t N_ROUND_TRIPS = 200000;
+const size_t WINDOW = 64;
+
+/** \brief forwarder stand-in that echoes every block, on its own thread
+ */
+class EchoForwarder
+{
+public:
+  EchoForwarder(const std::string& path, bool supportsShm)
+    : m_acceptor(m_io, stream_protocol::endpoint(path))
+    , m_shouldStop(false)
+  {
+    m_thread = std::thread([this, supportsShm] {
+      stream_protocol::socket socket(m_io);
+      m_acceptor.accept(socket);
+      if (supportsShm) {
+        this->runShm(socket);
+      }
+      else {
+        this->runStream(socket);
+      }
+    });
+  }
+
+  ~EchoForwarder()
+  {
+    m_shouldStop = true;
+    m_thread.join();
+  }
+
+private:
+  void
+  runShm(stream_protocol::socket& socket)
+  {
+    unique_ptr<ShmChannel> channel = ShmChannel::receiveRequest(socket.native_handle());
+    Block accept = makeEmptyBlock(ShmChannel::TLV_ACCEPT);
+    boost::asio::write(socket, boost::asio::buffer(accept.wire(), accept.size()));
+
+    pollfd pfd;
+    pfd.fd = channel->getWakeupFd();
+    pfd.events = POLLIN;
+    while (!m_shouldStop) {
+      if (::poll(&pfd, 1, 10) > 0) {
+        uint64_t value = 0;
+        BOOST_VERIFY(::read(pfd.fd, &value, sizeof(value)) == sizeof(value));
+      }
+
+      Block block;
+      while (channel->getReceiveRing().pop(block)) {
+        ShmRing::PushResult result;
+        while ((result = channel->getSendRing().push(block)) == ShmRing::PushResult::FULL) {
+          std::this_thread::yield();
+        }
+        if (result == ShmRing::PushResult::PUSHED_TO_EMPTY) {
+          channel->notifyPeer();
+        }
+      }
+      if (channel->getReceiveRing().takeProducerBlocked()) {
+        channel->notifyPeer();
+      }
+    }
+  }
+
+  void
+  runStream(stream_protocol::socket& socket)
+  {
+    uint8_t buffer[MAX_NDN_PACKET_SIZE];
+    boost::system::error_code error;
+    for (;;) {
+      size_t nRead = socket.read_some(boost::asio::buffer(buffer), error);
+      if (error) {
+        return;
+      }
+      boost::asio::write(socket, boost::asio::buffer(buffer, nRead));
+    }
+  }
+
+private:
+  boost::asio::io_service m_io;
+  stream_protocol::acceptor m_acceptor;
+  std::atomic<bool> m_shouldStop;
+  std::thread m_thread;
+};
+
+/** \brief send Interests through \p transport with a fixed window, until N_ROUND_TRIPS
+ *         of them have been echoed by the forwarder
+ *  \return elapsed time
+ */
+template<typename TransportType>
+static time::nanoseconds
+runRoundTrips(TransportType& transport, boost::asio::io_service& io)
+{
+  Block wire = Interest(Name("/benchmark/shm-transport/interest"), time::seconds(4)).wireEncode();
+
+  size_t nSent = 0;
+  size_t nReceived = 0;
+  transport.connect(io, [&] (const Block&) {
+    if (++nReceived == N_ROUND_TRIPS) {
+      io.stop();
+    }
+    else if (nSent < N_ROUND_TRIPS) {
+      transport.send(wire);
+      ++nSent;
+    }
+  });
+  transport.resume();
+
+  // wait until the forwarder has decided between shared memory and the socket
+  for (int i = 0; i < 100; ++i) {
+    io.poll();
+    io.reset();
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+  // resume() is ignored while the connection is being established
+  transport.resume();
+
+  time::steady_clock::TimePoint t1 = time::steady_clock::now();
+  for (; nSent < WINDOW; ++nSent) {
+    transport.send(wire);
+  }
+  io.run();
+  time::steady_clock::TimePoint t2 = time::steady_clock::now();
+
+  transport.close();
+  BOOST_CHECK_EQUAL(nReceived, N_ROUND_TRIPS);
+  return t2 - t1;
+}
+
+class ShmTransportBenchmarkFixture
+{
+protected:
+  ShmTransportBenchmarkFixture()
+    : socketPath((boost::filesystem::temp_directory_path() /
+                  boost::filesystem::unique_path("ndn-cxx-benchmark-%%%%-%%%%.sock")).string())
+  {
+  }
+
+  ~ShmTransportBenchmarkFixture()
+  {
+    boost::filesystem::remove(socketPath);
+  }
+
+  void
+  report(const std::string& name, time::nanoseconds elapsed)
+  {
+    BOOST_TEST_MESSAGE(name << ": " << N_ROUND_TRIPS << " round trips with window " << WINDOW <<
+                       " in " << elapsed << ", " <<
+                       (N_ROUND_TRIPS * 1000000000 / elapsed.count()) << " packets/s");
+  }
+
+protected:
+  std::string socketPath;
+};
+
+BOOST_FIXTURE_TEST_CASE(Loopback, ShmTransportBenchmarkFixture)
+{
+  time::nanoseconds unixTime;
+  {
+    EchoForwarder forwarder(socketPath, false);
+    boost::asio::io_service io;
+    UnixTransport transport(socketPath);
+    unixTime = runRoundTrips(transport, io);
+  }
+  boost::filesystem::remove(socketPath);
+
+  time::nanoseconds shmTime;
+  {
+    EchoForwarder forwarder(socketPath, true);
+    boost::asio::io_service io;
+    ShmTransport transport(socketPath);
+    shmTime = runRoundTrips(transport, io);
+  }
+
+  report("UnixTransport", unixTime);
+  report("ShmTransport", shmTime);
+}
+
+} // namespace tests
+} // namespace ndn
@@ -0,0 +1,118 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2013-2017 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#define BOOST_TEST_MAIN 1
+#define BOOST_TEST_DYN_LINK 1
+#define BOOST_TEST_MODULE ndn-cxx Transform Benchmark
+
+#include "security/transform.hpp"
+#include "security/transform/private-key.hpp"
+#include "security/transform/public-key.hpp"
+#include "security/key-params.hpp"
+#include "encoding/buffer-stream.hpp"
+
+#include "boost-test.hpp"
+
+namespace ndn {
+namespace security {
+namespace transform {
+namespace tests {
+
+const int N_ITERATIONS = 100000;
+const uint8_t INPUT[512] = {};
+
+BOOST_AUTO_TEST_CASE(Digest)
+{
+  time::steady_clock::TimePoint t1 = time::steady_clock::now();
+  for (int i = 0; i < N_ITERATIONS; ++i) {
+    OBufferStream os;
+    bufferSource(INPUT, sizeof(INPUT)) >> digestFilter(DigestAlgorithm::SHA256) >> streamSink(os);
+  }
+  time::steady_clock::TimePoint t2 = time::steady_clock::now();
+  for (int i = 0; i < N_ITERATIONS; ++i) {
+    uint8_t digest[32];
+    size_t digestLen = 0;
+    fused::DigestPipeline pipeline(fused::BufferSink(digest, sizeof(digest), digestLen),
+                                   DigestAlgorithm::SHA256);
+    pipeline.write(INPUT, sizeof(INPUT));
+    pipeline.end();
+  }
+  time::steady_clock::TimePoint t3 = time::steady_clock::now();
+
+  BOOST_TEST_MESSAGE("digest " << N_ITERATIONS << " buffers, dynamic chain: " << (t2 - t1));
+  BOOST_TEST_MESSAGE("digest " << N_ITERATIONS << " buffers, fused pipeline: " << (t3 - t2));
+}
+
+BOOST_AUTO_TEST_CASE(SignVerify)
+{
+  const int nIterations = N_ITERATIONS / 10;
+  unique_ptr<PrivateKey> sKey = generatePrivateKey(EcKeyParams());
+  ConstBufferPtr pKeyBits = sKey->derivePublicKey();
+  PublicKey pKey;
+  pKey.loadPkcs8(pKeyBits->buf(), pKeyBits->size());
+
+  time::steady_clock::TimePoint t1 = time::steady_clock::now();
+  ConstBufferPtr sig;
+  for (int i = 0; i < nIterations; ++i) {
+    OBufferStream os;
+    bufferSource(INPUT, sizeof(INPUT)) >> signerFilter(DigestAlgorithm::SHA256, *sKey) >> streamSink(os);
+    sig = os.buf();
+  }
+  time::steady_clock::TimePoint t2 = time::steady_clock::now();
+  for (int i = 0; i < nIterations; ++i) {
+    fused::Signer signer(DigestAlgorithm::SHA256, *sKey);
+    uint8_t buf[256];
+    signer.update(INPUT, sizeof(INPUT));
+    signer.finalize(buf, sizeof(buf));
+  }
+  time::steady_clock::TimePoint t3 = time::steady_clock::now();
+
+  BOOST_TEST_MESSAGE("ECDSA sign " << nIterations << " buffers, dynamic chain: " << (t2 - t1));
+  BOOST_TEST_MESSAGE("ECDSA sign " << nIterations << " buffers, fused pipeline: " << (t3 - t2));
+
+  int nValid = 0;
+  t1 = time::steady_clock::now();
+  for (int i = 0; i < nIterations; ++i) {
+    bool result = false;
+    bufferSource(INPUT, sizeof(INPUT)) >> verifierFilter(DigestAlgorithm::SHA256, pKey, sig->buf(), sig->size())
+                                       >> boolSink(result);
+    nValid += result;
+  }
+  t2 = time::steady_clock::now();
+  for (int i = 0; i < nIterations; ++i) {
+    bool result = false;
+    fused::VerifierPipeline pipeline(fused::BoolSink(result), DigestAlgorithm::SHA256,
+                                     pKey, sig->buf(), sig->size());
+    pipeline.write(INPUT, sizeof(INPUT));
+    pipeline.end();
+    nValid += result;
+  }
+  t3 = time::steady_clock::now();
+
+  BOOST_CHECK_EQUAL(nValid, 2 * nIterations);
+  BOOST_TEST_MESSAGE("ECDSA verify " << nIterations << " buffers, dynamic chain: " << (t2 - t1));
+  BOOST_TEST_MESSAGE("ECDSA verify " << nIterations << " buffers, fused pipeline: " << (t3 - t2));
+}
+
+} // namespace tests
+} // namespace transform
+} // namespace security
+} // namespace ndn
@@ -0,0 +1,118 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2013-2017 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#define BOOST_TEST_MAIN 1
+#define BOOST_TEST_DYN_LINK 1
+#define BOOST_TEST_MODULE ndn-cxx Verification Benchmark
+
+#include "security/verification-helpers.hpp"
+#include "security/signing-helpers.hpp"
+#include "security/v2/key-chain.hpp"
+
+#include "boost-test.hpp"
+
+#include <boost/mpl/list.hpp>
+
+#include <thread>
+
+namespace ndn {
+namespace security {
+namespace tests {
+
+struct EcdsaKey
+{
+  static const char*
+  getName()
+  {
+    return "ECDSA";
+  }
+
+  static KeyParams
+  getParams()
+  {
+    return EcKeyParams();
+  }
+};
+
+struct RsaKey
+{
+  static const char*
+  getName()
+  {
+    return "RSA";
+  }
+
+  static KeyParams
+  getParams()
+  {
+    return RsaKeyParams();
+  }
+};
+
+typedef boost::mpl::list<EcdsaKey, RsaKey> KeyTypes;
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(SingleVsBatch, KeyType, KeyTypes)
+{
+  v2::KeyChain keyChain("pib-memory:", "tpm-memory:");
+  const size_t nKeys = 4;
+  const size_t nPackets = 20000;
+
+  std::vector<v2::Certificate> certs;
+  for (size_t i = 0; i < nKeys; ++i) {
+    Identity identity = keyChain.createIdentity(Name("/benchmark/verify").appendNumber(i),
+                                                KeyType::getParams());
+    certs.push_back(identity.getDefaultKey().getDefaultCertificate());
+  }
+
+  std::vector<Data> packets(nPackets);
+  std::vector<std::pair<const Data*, const v2::Certificate*>> batch;
+  for (size_t i = 0; i < nPackets; ++i) {
+    packets[i].setName(Name("/benchmark/data").appendSequenceNumber(i));
+    packets[i].setContent(reinterpret_cast<const uint8_t*>("payload"), 7);
+    keyChain.sign(packets[i], signingByIdentity(certs[i % nKeys].getIdentity()));
+    batch.emplace_back(&packets[i], &certs[i % nKeys]);
+  }
+
+  time::steady_clock::TimePoint t1 = time::steady_clock::now();
+  size_t nValid = 0;
+  for (const auto& item : batch) {
+    nValid += verifySignature(*item.first, *item.second);
+  }
+  time::steady_clock::TimePoint t2 = time::steady_clock::now();
+  BOOST_CHECK_EQUAL(nValid, nPackets);
+  BOOST_TEST_MESSAGE(KeyType::getName() << " verifySignature " << nPackets << " packets: " <<
+                     time::duration_cast<time::microseconds>(t2 - t1));
+
+  size_t maxThreads = std::max(1U, std::thread::hardware_concurrency());
+  for (size_t nThreads = 1; nThreads <= maxThreads; nThreads *= 2) {
+    t1 = time::steady_clock::now();
+    std::vector<bool> results = verifySignatures(batch, nThreads);
+    t2 = time::steady_clock::now();
+    BOOST_CHECK_EQUAL(std::count(results.begin(), results.end(), true), nPackets);
+    BOOST_TEST_MESSAGE(KeyType::getName() << " verifySignatures " << nPackets << " packets, " <<
+                       nThreads << " threads: " <<
+                       time::duration_cast<time::microseconds>(t2 - t1));
+  }
+}
+
+} // namespace tests
+} // namespace security
+} // namespace ndn
@@ -0,0 +1,108 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2013-2017 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#include "detail/mpsc-queue.hpp"
+
+#include "boost-test.hpp"
+
+#include <thread>
+
+namespace ndn {
+namespace tests {
+
+BOOST_AUTO_TEST_SUITE(Detail)
+BOOST_AUTO_TEST_SUITE(TestMpscQueue)
+
+BOOST_AUTO_TEST_CASE(SingleThread)
+{
+  MpscQueue<int> queue;
+  int item = 0;
+  BOOST_CHECK(!queue.pop(item));
+
+  queue.push(1);
+  BOOST_CHECK(queue.pop(item));
+  BOOST_CHECK_EQUAL(item, 1);
+  BOOST_CHECK(!queue.pop(item));
+
+  for (int i = 2; i <= 5; ++i) {
+    queue.push(i);
+  }
+  for (int i = 2; i <= 5; ++i) {
+    BOOST_CHECK(queue.pop(item));
+    BOOST_CHECK_EQUAL(item, i);
+  }
+  BOOST_CHECK(!queue.pop(item));
+
+  // items left in the queue are destroyed with the queue
+  auto ptr = make_shared<int>(6);
+  weak_ptr<int> weak(ptr);
+  {
+    MpscQueue<shared_ptr<int>> queue2;
+    queue2.push(std::move(ptr));
+    BOOST_CHECK(!weak.expired());
+  }
+  BOOST_CHECK(weak.expired());
+}
+
+BOOST_AUTO_TEST_CASE(MultipleProducers)
+{
+  const int nThreads = 4;
+  const int nItemsPerThread = 10000;
+
+  MpscQueue<std::pair<int, int>> queue;
+  std::atomic<int> nPushed(0);
+  std::vector<std::thread> threads;
+  for (int t = 0; t < nThreads; ++t) {
+    threads.emplace_back([&queue, &nPushed, t] {
+      for (int i = 0; i < nItemsPerThread; ++i) {
+        queue.push({t, i});
+        ++nPushed;
+      }
+    });
+  }
+
+  // items from each producer are popped in order
+  std::vector<int> nextItem(nThreads, 0);
+  int nPopped = 0;
+  std::pair<int, int> item;
+  while (nPopped < nThreads * nItemsPerThread) {
+    if (queue.pop(item)) {
+      BOOST_REQUIRE_EQUAL(item.second, nextItem.at(item.first)++);
+      ++nPopped;
+    }
+    else {
+      BOOST_REQUIRE_GE(nPushed.load(), nPopped);
+      std::this_thread::yield();
+    }
+  }
+
+  for (std::thread& thread : threads) {
+    thread.join();
+  }
+  BOOST_CHECK(!queue.pop(item));
+  BOOST_CHECK_EQUAL(nPopped, nThreads * nItemsPerThread);
+}
+
+BOOST_AUTO_TEST_SUITE_END() // TestMpscQueue
+BOOST_AUTO_TEST_SUITE_END() // Detail
+
+} // namespace tests
+} // namespace ndn
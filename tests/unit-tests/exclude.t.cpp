@@ -233,6 +233,41 @@ BOOST_AUTO_TEST_CASE(Ranges)
                       Exclude::Error);
 }
 
+BOOST_AUTO_TEST_CASE(IsExcludedBatch)
+{
+  // in canonical order
+  std::vector<name::Component> components;
+  for (const char* value : {"", "a", "b", "c", "d", "e", "f", "g", "aa", "ba", "zz"}) {
+    components.push_back(name::Component(value));
+  }
+  std::vector<name::Component> reversed(components.rbegin(), components.rend());
+
+  Exclude e;
+  BOOST_CHECK(e.isExcluded(components) == std::vector<bool>(components.size(), false));
+
+  // example: ANY "b" "d" ANY "f"
+  e.excludeBefore(name::Component("b"));
+  e.excludeRange(name::Component("d"), name::Component("f"));
+  BOOST_REQUIRE_EQUAL(e.toUri(), "*,b,d,*,f");
+
+  std::vector<bool> expected{true, true, true, false, true, true, true, false, false, false, false};
+  BOOST_CHECK(e.isExcluded(components) == expected);
+  BOOST_CHECK(e.isExcluded(reversed) == std::vector<bool>(expected.rbegin(), expected.rend()));
+  for (size_t i = 0; i < components.size(); ++i) {
+    BOOST_CHECK_EQUAL(e.isExcluded(components[i]), expected[i]);
+  }
+
+  Exclude decoded(e.wireEncode());
+  BOOST_CHECK(decoded.isExcluded(components) == expected);
+
+  // the flat representation is rebuilt after modification
+  e.excludeAfter(name::Component("g"));
+  expected = {true, true, true, false, true, true, true, true, true, true, true};
+  BOOST_CHECK(e.isExcluded(components) == expected);
+  e.excludeOne(name::Component("c"));
+  BOOST_CHECK_EQUAL(e.isExcluded(name::Component("c")), true);
+}
+
 BOOST_AUTO_TEST_SUITE_END() // GenericComponent
 
 BOOST_AUTO_TEST_SUITE(ImplicitDigest) // exclude ImplicitSha256DigestComponent
@@ -0,0 +1,276 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2013-2017 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#include "face-group.hpp"
+#include "lp/packet.hpp"
+#include "transport/transport.hpp"
+
+#include "boost-test.hpp"
+#include "identity-management-fixture.hpp"
+#include "make-interest-data.hpp"
+
+#include <future>
+#include <mutex>
+#include <thread>
+
+namespace ndn {
+namespace tests {
+
+/** \brief Transport that records the packets sent by a shard
+ */
+class RecordingTransport : public Transport
+{
+public:
+  void
+  close() override
+  {
+  }
+
+  void
+  pause() override
+  {
+  }
+
+  void
+  resume() override
+  {
+  }
+
+  void
+  send(const Block& wire) override
+  {
+    Block packet(wire);
+    packet.encode();
+    lp::Packet lpPacket(packet);
+    Buffer::const_iterator begin, end;
+    std::tie(begin, end) = lpPacket.get<lp::FragmentField>();
+    Block block(&*begin, std::distance(begin, end));
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_sent.push_back(block);
+  }
+
+  void
+  send(const Block& header, const Block& payload) override
+  {
+    EncodingBuffer encoder(header.size() + payload.size(), header.size() + payload.size());
+    encoder.appendByteArray(header.wire(), header.size());
+    encoder.appendByteArray(payload.wire(), payload.size());
+
+    this->send(encoder.block());
+  }
+
+  std::vector<Block>
+  getSent(uint32_t type)
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    std::vector<Block> sent;
+    std::copy_if(m_sent.begin(), m_sent.end(), std::back_inserter(sent),
+                 [type] (const Block& block) { return block.type() == type; });
+    return sent;
+  }
+
+private:
+  std::mutex m_mutex;
+  std::vector<Block> m_sent;
+};
+
+/** \brief Transport that cannot be connected
+ */
+class UnconnectableTransport : public RecordingTransport
+{
+public:
+  void
+  connect(boost::asio::io_service& ioService, const ReceiveCallback& receiveCallback) override
+  {
+    BOOST_THROW_EXCEPTION(Error("connection refused"));
+  }
+};
+
+/** \brief wait up to 5 seconds until \p condition holds
+ *  \return whether \p condition holds
+ */
+static bool
+waitUntil(const std::function<bool()>& condition)
+{
+  for (int i = 0; i < 500; ++i) {
+    if (condition()) {
+      return true;
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  }
+  return condition();
+}
+
+class FaceGroupFixture : public IdentityManagementFixture
+{
+protected:
+  explicit
+  FaceGroupFixture(size_t nShards = 4)
+    : group(nShards, [this] {
+                       transports.push_back(make_shared<RecordingTransport>());
+                       return transports.back();
+                     },
+            m_keyChain)
+  {
+  }
+
+  /** \brief wait until shard \p shard has sent \p n packets of TLV-TYPE \p type
+   */
+  bool
+  waitForSent(size_t shard, uint32_t type, size_t n)
+  {
+    return waitUntil([=] { return transports.at(shard)->getSent(type).size() >= n; });
+  }
+
+protected:
+  std::vector<shared_ptr<RecordingTransport>> transports;
+  FaceGroup group;
+};
+
+BOOST_AUTO_TEST_SUITE(TestFaceGroup)
+
+BOOST_AUTO_TEST_CASE(ZeroShards)
+{
+  BOOST_CHECK_THROW(FaceGroup(0), FaceGroup::Error);
+}
+
+BOOST_FIXTURE_TEST_CASE(ExpressInterestSharding, FaceGroupFixture)
+{
+  BOOST_REQUIRE_EQUAL(group.size(), 4);
+  BOOST_REQUIRE_EQUAL(transports.size(), 4);
+
+  std::vector<size_t> nExpected(group.size(), 0);
+  for (int i = 0; i < 32; ++i) {
+    Name name("/A");
+    name.appendNumber(i);
+    BOOST_CHECK_EQUAL(group.getShardIndex(name), group.getShardIndex(name));
+    ++nExpected[group.getShardIndex(name)];
+    group.expressInterest(Interest(name), nullptr, nullptr, nullptr);
+  }
+
+  for (size_t shard = 0; shard < group.size(); ++shard) {
+    BOOST_REQUIRE(waitForSent(shard, tlv::Interest, nExpected[shard]));
+    std::vector<Block> sent = transports[shard]->getSent(tlv::Interest);
+    BOOST_CHECK_EQUAL(sent.size(), nExpected[shard]);
+    for (const Block& block : sent) {
+      BOOST_CHECK_EQUAL(group.getShardIndex(Interest(block).getName()), shard);
+    }
+  }
+
+  // counters are updated after the transport has sent the packet
+  BOOST_CHECK(waitUntil([this] { return group.getStatistics().nOutInterests == 32; }));
+  FaceGroup::Statistics statistics = group.getStatistics();
+  BOOST_CHECK_EQUAL(statistics.nOutInterests, 32);
+  BOOST_CHECK_EQUAL(statistics.nPendingInterests, 32);
+  BOOST_CHECK_EQUAL(statistics.nInData, 0);
+  BOOST_CHECK_EQUAL(statistics.nOutData, 0);
+}
+
+BOOST_FIXTURE_TEST_CASE(RemovePendingInterest, FaceGroupFixture)
+{
+  Name name("/A");
+  size_t shard = group.getShardIndex(name);
+  const PendingInterestId* id = group.expressInterest(Interest(name), nullptr, nullptr, nullptr);
+  BOOST_REQUIRE(waitForSent(shard, tlv::Interest, 1));
+  BOOST_CHECK_EQUAL(group.getFace(shard).getCounters().nPendingInterests, 1);
+
+  group.removePendingInterest(id);
+  BOOST_CHECK(waitUntil([&] { return group.getFace(shard).getCounters().nPendingInterests == 0; }));
+}
+
+BOOST_AUTO_TEST_CASE(ConnectFailure)
+{
+  FaceGroup group(2, [] { return make_shared<UnconnectableTransport>(); });
+
+  std::promise<void> hasTimedOut;
+  Interest interest("/A");
+  interest.setInterestLifetime(time::milliseconds(50));
+  group.expressInterest(interest, nullptr, nullptr,
+                        [&hasTimedOut] (const Interest&) { hasTimedOut.set_value(); });
+
+  // the Interest is not lost when the transport throws
+  BOOST_CHECK(hasTimedOut.get_future().wait_for(std::chrono::seconds(5)) ==
+              std::future_status::ready);
+  BOOST_CHECK(waitUntil([&group] { return group.getStatistics().nTimeouts == 1; }));
+}
+
+BOOST_FIXTURE_TEST_CASE(SetInterestFilterFromCallback, FaceGroupFixture)
+{
+  std::promise<bool> hasThrown;
+  group.getFace(0).getIoService().post([&] {
+    try {
+      group.setInterestFilter(Name("/A"), nullptr, nullptr, nullptr);
+      hasThrown.set_value(false);
+    }
+    catch (const FaceGroup::Error&) {
+      hasThrown.set_value(true);
+    }
+  });
+  BOOST_CHECK(hasThrown.get_future().get());
+}
+
+BOOST_FIXTURE_TEST_CASE(PutRouting, FaceGroupFixture)
+{
+  Name prefix("/producer");
+  size_t filterShard = group.getShardIndex(prefix);
+  group.setInterestFilter(prefix, nullptr, nullptr, nullptr);
+
+  // Data under the registered prefix uses the shard of the filter
+  for (int i = 0; i < 8; ++i) {
+    group.put(*makeData(Name(prefix).appendNumber(i)));
+  }
+  BOOST_REQUIRE(waitForSent(filterShard, tlv::Data, 8));
+  for (const Block& block : transports[filterShard]->getSent(tlv::Data)) {
+    BOOST_CHECK(prefix.isPrefixOf(Data(block).getName()));
+  }
+
+  // other Data is sent on the shard selected by its name
+  Name other("/other/data");
+  size_t otherShard = group.getShardIndex(other);
+  group.put(*makeData(other));
+  BOOST_REQUIRE(waitForSent(otherShard, tlv::Data, otherShard == filterShard ? 9 : 1));
+
+  BOOST_CHECK_EQUAL(group.getStatistics().nOutData, 9);
+
+  // the longest matching prefix wins
+  Name longer("/producer/long/prefix");
+  size_t longerShard = group.getShardIndex(longer);
+  const RegisteredPrefixId* longerId = group.setInterestFilter(longer, nullptr, nullptr, nullptr);
+  size_t nBefore = transports[longerShard]->getSent(tlv::Data).size();
+  group.put(*makeData(Name(longer).append("data")));
+  BOOST_REQUIRE(waitForSent(longerShard, tlv::Data, nBefore + 1));
+  BOOST_CHECK_EQUAL(Data(transports[longerShard]->getSent(tlv::Data).back()).getName(),
+                    Name(longer).append("data"));
+
+  // after unsetInterestFilter, the shorter prefix is used again
+  group.unsetInterestFilter(longerId);
+  nBefore = transports[filterShard]->getSent(tlv::Data).size();
+  group.put(*makeData(Name(longer).append("data2")));
+  BOOST_REQUIRE(waitForSent(filterShard, tlv::Data, nBefore + 1));
+  BOOST_CHECK_EQUAL(Data(transports[filterShard]->getSent(tlv::Data).back()).getName(),
+                    Name(longer).append("data2"));
+}
+
+BOOST_AUTO_TEST_SUITE_END() // TestFaceGroup
+
+} // namespace tests
+} // namespace ndn
@@ -24,6 +24,7 @@
 #include "transport/tcp-transport.hpp"
 #include "transport/unix-transport.hpp"
 #include "util/dummy-client-face.hpp"
+#include "util/in-memory-storage-lru.hpp"
 #include "util/scheduler.hpp"
 
 #include "boost-test.hpp"
@@ -31,6 +32,8 @@
 #include "test-home-fixture.hpp"
 #include "make-interest-data.hpp"
 
+#include <thread>
+
 namespace ndn {
 namespace tests {
 
@@ -299,6 +302,178 @@ BOOST_AUTO_TEST_CASE(DestructionWithoutCancellingPendingInterests) // Bug #2518
   BOOST_CHECK(true);
 }
 
+BOOST_AUTO_TEST_CASE(Aggregation)
+{
+  BOOST_CHECK_EQUAL(face.isInterestAggregationEnabled(), false);
+  face.setInterestAggregation(true);
+  BOOST_CHECK_EQUAL(face.isInterestAggregationEnabled(), true);
+
+  size_t nData = 0;
+  size_t nTimeouts = 0;
+  auto onData = [&] (const Interest&, const Data&) { ++nData; };
+  auto onTimeout = [&] (const Interest&) { ++nTimeouts; };
+
+  face.expressInterest(Interest("/A", time::milliseconds(100)), onData, nullptr, onTimeout);
+  advanceClocks(time::milliseconds(10));
+  // covered by the first Interest
+  face.expressInterest(Interest("/A", time::milliseconds(50)), onData, nullptr, onTimeout);
+  // different selectors
+  face.expressInterest(Interest("/A", time::milliseconds(50)).setMustBeFresh(true),
+                       onData, nullptr, onTimeout);
+  // expires after the first Interest, but is aggregated too
+  face.expressInterest(Interest("/A", time::milliseconds(200)), onData, nullptr, onTimeout);
+  advanceClocks(time::milliseconds(10));
+
+  BOOST_CHECK_EQUAL(face.sentInterests.size(), 2);
+  BOOST_CHECK_EQUAL(face.getCounters().nAggregatedInterests, 2);
+  BOOST_CHECK_EQUAL(face.getNPendingInterests(), 4);
+
+  // the aggregated Interest times out after its own lifetime
+  advanceClocks(time::milliseconds(60));
+  BOOST_CHECK_EQUAL(nTimeouts, 2);
+  BOOST_CHECK_EQUAL(face.sentInterests.size(), 2);
+
+  face.receive(*makeData("/A/1"));
+  advanceClocks(time::milliseconds(10));
+  BOOST_CHECK_EQUAL(nData, 2);
+  BOOST_CHECK_EQUAL(face.getNPendingInterests(), 0);
+}
+
+BOOST_AUTO_TEST_CASE(AggregationEqualLifetime)
+{
+  face.setInterestAggregation(true);
+
+  std::vector<std::string> events;
+  auto express = [&] (const std::string& tag) {
+    face.expressInterest(Interest("/A", time::milliseconds(100)),
+                         [&events, tag] (const Interest&, const Data&) {
+                           events.push_back(tag + " data");
+                         },
+                         nullptr,
+                         [&events, tag] (const Interest&) {
+                           events.push_back(tag + " timeout");
+                         });
+  };
+
+  express("1");
+  advanceClocks(time::milliseconds(10));
+  express("2");
+  advanceClocks(time::milliseconds(10));
+  express("3");
+  advanceClocks(time::milliseconds(10));
+  BOOST_CHECK_EQUAL(face.sentInterests.size(), 1);
+  BOOST_CHECK_EQUAL(face.getCounters().nAggregatedInterests, 2);
+
+  // when the transmitted Interest times out, the oldest waiting Interest is sent
+  advanceClocks(time::milliseconds(1), 80);
+  BOOST_REQUIRE_EQUAL(events.size(), 1);
+  BOOST_CHECK_EQUAL(events.back(), "1 timeout");
+  BOOST_CHECK_EQUAL(face.sentInterests.size(), 2);
+
+  // the third Interest still waits on the second one
+  advanceClocks(time::milliseconds(1), 10);
+  BOOST_REQUIRE_EQUAL(events.size(), 2);
+  BOOST_CHECK_EQUAL(events.back(), "2 timeout");
+  BOOST_CHECK_EQUAL(face.sentInterests.size(), 3);
+
+  face.receive(*makeData("/A/1"));
+  advanceClocks(time::milliseconds(1));
+  BOOST_REQUIRE_EQUAL(events.size(), 3);
+  BOOST_CHECK_EQUAL(events.back(), "3 data");
+  BOOST_CHECK_EQUAL(face.getNPendingInterests(), 0);
+}
+
+BOOST_AUTO_TEST_CASE(AggregationRemoveTransmitted)
+{
+  face.setInterestAggregation(true);
+
+  size_t nData = 0;
+  const PendingInterestId* firstId =
+    face.expressInterest(Interest("/A", time::milliseconds(100)), nullptr, nullptr, nullptr);
+  face.expressInterest(Interest("/A", time::milliseconds(50)),
+                       [&] (const Interest&, const Data&) { ++nData; }, nullptr, nullptr);
+  advanceClocks(time::milliseconds(10));
+  BOOST_CHECK_EQUAL(face.sentInterests.size(), 1);
+
+  // the Interest waiting on the cancelled one is sent
+  face.removePendingInterest(firstId);
+  advanceClocks(time::milliseconds(10));
+  BOOST_CHECK_EQUAL(face.sentInterests.size(), 2);
+  BOOST_CHECK_EQUAL(face.getNPendingInterests(), 1);
+
+  face.receive(*makeData("/A/1"));
+  advanceClocks(time::milliseconds(10));
+  BOOST_CHECK_EQUAL(nData, 1);
+}
+
+BOOST_AUTO_TEST_CASE(ContentCache)
+{
+  auto cache = make_shared<util::InMemoryStorageLru>(io);
+  face.setContentCache(cache);
+  BOOST_CHECK(face.getContentCache() == cache);
+
+  size_t nData = 0;
+  auto onData = [&] (const Interest&, const Data&) { ++nData; };
+
+  face.expressInterest(Interest("/A"), onData, nullptr, nullptr);
+  face.expressInterest(Interest("/B"), onData, nullptr, nullptr);
+  advanceClocks(time::milliseconds(10));
+  BOOST_CHECK_EQUAL(face.sentInterests.size(), 2);
+
+  shared_ptr<Data> dataA = makeData("/A/1");
+  dataA->setFreshnessPeriod(time::milliseconds(100));
+  signData(dataA);
+  face.receive(*dataA);
+  face.receive(*makeData("/B/1"));
+  // unsolicited Data is not cached
+  face.receive(*makeData("/C/1"));
+  advanceClocks(time::milliseconds(10));
+  BOOST_CHECK_EQUAL(nData, 2);
+  BOOST_CHECK_EQUAL(cache->size(), 2);
+
+  face.expressInterest(Interest("/A"), onData, nullptr, nullptr);
+  face.expressInterest(Interest("/A").setMustBeFresh(true), onData, nullptr, nullptr);
+  face.expressInterest(Interest("/B"), onData, nullptr, nullptr);
+  advanceClocks(time::milliseconds(10));
+  BOOST_CHECK_EQUAL(face.sentInterests.size(), 2);
+  BOOST_CHECK_EQUAL(nData, 5);
+
+  // Data without FreshnessPeriod cannot satisfy MustBeFresh
+  face.expressInterest(Interest("/B").setMustBeFresh(true), onData, nullptr, nullptr);
+  advanceClocks(time::milliseconds(10));
+  BOOST_CHECK_EQUAL(face.sentInterests.size(), 3);
+
+  // Data becomes stale after FreshnessPeriod
+  advanceClocks(time::milliseconds(100));
+  face.expressInterest(Interest("/A").setMustBeFresh(true), onData, nullptr, nullptr);
+  advanceClocks(time::milliseconds(10));
+  BOOST_CHECK_EQUAL(face.sentInterests.size(), 4);
+  BOOST_CHECK_EQUAL(nData, 5);
+
+  BOOST_CHECK_EQUAL(face.getCounters().nCacheHits, 3);
+  BOOST_CHECK_EQUAL(face.getCounters().nCacheMisses, 4);
+
+  // a cache hit does not invoke the callback from within expressInterest
+  io.post([&] {
+    face.expressInterest(Interest("/B"), onData, nullptr, nullptr);
+    BOOST_CHECK_EQUAL(nData, 5);
+  });
+  advanceClocks(time::milliseconds(10));
+  BOOST_CHECK_EQUAL(nData, 6);
+  BOOST_CHECK_EQUAL(face.getCounters().nCacheHits, 4);
+
+  face.setContentCache(nullptr);
+  face.expressInterest(Interest("/B"), onData, nullptr, nullptr);
+  advanceClocks(time::milliseconds(10));
+  BOOST_CHECK_EQUAL(face.sentInterests.size(), 5);
+  BOOST_CHECK_EQUAL(face.getCounters().nCacheMisses, 4);
+
+  // without an io_service, the cache cannot tell when Data become stale
+  BOOST_CHECK_THROW(face.setContentCache(make_shared<util::InMemoryStorageLru>()),
+                    std::invalid_argument);
+  BOOST_CHECK(face.getContentCache() == nullptr);
+}
+
 BOOST_AUTO_TEST_SUITE_END() // Consumer
 
 BOOST_AUTO_TEST_SUITE(Producer)
@@ -325,6 +500,32 @@ BOOST_AUTO_TEST_CASE(PutData)
   BOOST_CHECK(face.sentData[1].getTag<lp::CongestionMarkTag>() != nullptr);
 }
 
+BOOST_AUTO_TEST_CASE(PutBatch)
+{
+  face.put(*makeData(Name("/A").appendNumber(0)));
+  face.putBatch({makeData(Name("/A").appendNumber(1)), makeData(Name("/A").appendNumber(2)),
+                 makeData(Name("/A").appendNumber(3))});
+  face.put(makeNack(Interest("/B"), lp::NackReason::NO_ROUTE));
+
+  advanceClocks(time::milliseconds(10));
+  BOOST_REQUIRE_EQUAL(face.sentData.size(), 4);
+  for (size_t i = 0; i < face.sentData.size(); ++i) {
+    BOOST_CHECK_EQUAL(face.sentData[i].getName(), Name("/A").appendNumber(i));
+  }
+  BOOST_CHECK_EQUAL(face.sentNacks.size(), 1);
+  BOOST_CHECK_EQUAL(face.getCounters().nOutData, 4);
+
+  // no Data is published if one of them is too large
+  auto largeData = make_shared<Data>("/A/large");
+  largeData->setContent(make_shared<Buffer>(MAX_NDN_PACKET_SIZE));
+  signData(largeData);
+  BOOST_CHECK_THROW(face.putBatch({makeData(Name("/A").appendNumber(4)), largeData}), Face::Error);
+
+  advanceClocks(time::milliseconds(10));
+  BOOST_CHECK_EQUAL(face.sentData.size(), 4);
+  BOOST_CHECK_EQUAL(face.getCounters().nOutData, 4);
+}
+
 BOOST_AUTO_TEST_CASE(PutNack)
 {
   BOOST_CHECK_EQUAL(face.sentNacks.size(), 0);
@@ -605,6 +806,86 @@ BOOST_FIXTURE_TEST_CASE(SetInterestFilterNoReg, FacesNoRegistrationReplyFixture)
   BOOST_CHECK_EQUAL(hit, 1);
 }
 
+BOOST_AUTO_TEST_CASE(MultiProducer)
+{
+  BOOST_CHECK(!face.isMultiProducerEnabled());
+  face.enableMultiProducer();
+  BOOST_CHECK(face.isMultiProducerEnabled());
+
+  const size_t nThreads = 4;
+  const size_t nPacketsPerThread = 100;
+  std::vector<std::thread> threads;
+  for (size_t t = 0; t < nThreads; ++t) {
+    threads.emplace_back([this, t, nPacketsPerThread] {
+      for (size_t i = 0; i < nPacketsPerThread; ++i) {
+        face.put(*makeData(Name("/producer").appendNumber(t).appendSegment(i)));
+      }
+      face.expressInterest(Interest(Name("/consumer").appendNumber(t)),
+                           bind([] {}), bind([] {}), bind([] {}));
+    });
+  }
+  for (std::thread& thread : threads) {
+    thread.join();
+  }
+
+  BOOST_CHECK_EQUAL(face.sentData.size(), 0);
+  advanceClocks(time::milliseconds(10));
+  BOOST_REQUIRE_EQUAL(face.sentData.size(), nThreads * nPacketsPerThread);
+  BOOST_CHECK_EQUAL(face.sentInterests.size(), nThreads);
+  BOOST_CHECK_EQUAL(face.getNPendingInterests(), nThreads);
+
+  // packets from each thread are sent in order
+  std::vector<uint64_t> nextSegment(nThreads, 0);
+  for (const Data& data : face.sentData) {
+    size_t t = static_cast<size_t>(data.getName().at(1).toNumber());
+    BOOST_CHECK_EQUAL(data.getName().at(2).toSegment(), nextSegment.at(t)++);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(SendOrder)
+{
+  std::vector<Name> sent;
+  face.onSendInterest.connect([&] (const Interest& interest) {
+    sent.push_back(interest.getName());
+  });
+  face.onSendData.connect([&] (const Data& data) { sent.push_back(data.getName()); });
+
+  // Data are queued until the end of the io_service turn, while Interests are sent at once
+  io.post([this] {
+    face.put(*makeData("/D/1"));
+    face.expressInterest(Interest("/I/1"), nullptr, nullptr, nullptr);
+    face.put(*makeData("/D/2"));
+    face.put(*makeData("/D/3"));
+    face.expressInterest(Interest("/I/2"), nullptr, nullptr, nullptr);
+  });
+  advanceClocks(time::milliseconds(10));
+
+  std::vector<Name> expected{"/D/1", "/I/1", "/D/2", "/D/3", "/I/2"};
+  BOOST_CHECK_EQUAL_COLLECTIONS(sent.begin(), sent.end(), expected.begin(), expected.end());
+}
+
+BOOST_AUTO_TEST_CASE(MultiProducerRemovePendingInterest)
+{
+  face.enableMultiProducer();
+
+  // fill more than one drain batch, so that the Interest below is expressed by a later drain
+  for (size_t i = 0; i < 300; ++i) {
+    face.put(*makeData(Name("/producer").appendSegment(i)));
+  }
+  const PendingInterestId* interestId =
+    face.expressInterest(Interest("/A"), bind([] {}), bind([] {}), bind([] {}));
+  face.removePendingInterest(interestId);
+  face.expressInterest(Interest("/B"), bind([] {}), bind([] {}), bind([] {}));
+  face.expressInterest(Interest("/C"), bind([] {}), bind([] {}), bind([] {}));
+  face.removeAllPendingInterests();
+
+  advanceClocks(time::milliseconds(10));
+  BOOST_CHECK_EQUAL(face.sentData.size(), 300);
+  BOOST_CHECK_EQUAL(face.sentInterests.size(), 3);
+  // removals did not overtake the Interests they refer to
+  BOOST_CHECK_EQUAL(face.getNPendingInterests(), 0);
+}
+
 BOOST_AUTO_TEST_SUITE_END() // Producer
 
 BOOST_AUTO_TEST_SUITE(IoRoutines)
@@ -639,6 +920,45 @@ BOOST_AUTO_TEST_CASE(DestroyWithoutProcessEvents) // Bug 3248
 
 BOOST_AUTO_TEST_SUITE_END() // IoRoutines
 
+BOOST_AUTO_TEST_CASE(Counters)
+{
+  const FaceCounters& counters = face.getCounters();
+  BOOST_CHECK_EQUAL(counters.nOutInterests, 0);
+  BOOST_CHECK_EQUAL(counters.nPendingInterests, 0);
+
+  face.expressInterest(Interest("/A", time::milliseconds(100)), nullptr, nullptr, nullptr);
+  face.expressInterest(Interest("/B", time::milliseconds(100)), nullptr, nullptr, nullptr);
+  face.expressInterest(Interest("/C", time::milliseconds(100)), nullptr, nullptr, nullptr);
+  advanceClocks(time::milliseconds(10));
+  BOOST_CHECK_EQUAL(counters.nOutInterests, 3);
+  BOOST_CHECK_EQUAL(counters.nPendingInterests, 3);
+  BOOST_CHECK_EQUAL(face.getNPendingInterests(), 3);
+
+  face.receive(*makeData("/A/1"));
+  face.receive(makeNack(face.sentInterests.at(1), lp::NackReason::DUPLICATE));
+  advanceClocks(time::milliseconds(10));
+  BOOST_CHECK_EQUAL(counters.nInData, 1);
+  BOOST_CHECK_EQUAL(counters.nInNacks, 1);
+  BOOST_CHECK_EQUAL(counters.nPendingInterests, 1);
+
+  // Data arrived 10ms after the Interest was sent
+  BOOST_CHECK_EQUAL(counters.rtt.getCount(), 1);
+  BOOST_CHECK_GE(counters.rtt.getQuantile(1.0), time::milliseconds(10));
+  BOOST_CHECK_LE(counters.rtt.getQuantile(1.0), time::milliseconds(12));
+
+  advanceClocks(time::milliseconds(100));
+  BOOST_CHECK_EQUAL(counters.nTimeouts, 1);
+  BOOST_CHECK_EQUAL(counters.nPendingInterests, 0);
+
+  face.receive(Interest("/Hello/World"));
+  face.put(*makeData("/Hello/World"));
+  face.put(makeNack(Interest("/Hello/World/2"), lp::NackReason::NO_ROUTE));
+  advanceClocks(time::milliseconds(10));
+  BOOST_CHECK_EQUAL(counters.nInInterests, 1);
+  BOOST_CHECK_EQUAL(counters.nOutData, 1);
+  BOOST_CHECK_EQUAL(counters.nOutNacks, 1);
+}
+
 BOOST_AUTO_TEST_SUITE(Transport)
 
 using ndn::Transport;
@@ -662,6 +982,72 @@ BOOST_FIXTURE_TEST_CASE(FaceTransport, IdentityManagementTimeFixture)
   BOOST_CHECK(Face(transport, io, m_keyChain).getTransport() == transport);
 }
 
+/** \brief Transport that cannot send after it has been closed
+ */
+class ClosableTransport : public Transport
+{
+public:
+  void
+  connect(boost::asio::io_service& ioService, const ReceiveCallback& receiveCallback) override
+  {
+    Transport::connect(ioService, receiveCallback);
+    m_isConnected = true;
+  }
+
+  void
+  close() override
+  {
+    m_isConnected = false;
+  }
+
+  void
+  pause() override
+  {
+  }
+
+  void
+  resume() override
+  {
+  }
+
+  void
+  send(const Block& wire) override
+  {
+    BOOST_REQUIRE(m_isConnected);
+    sent.push_back(wire);
+  }
+
+  void
+  send(const Block& header, const Block& payload) override
+  {
+    BOOST_FAIL("unexpected send(header, payload)");
+  }
+
+public:
+  std::vector<Block> sent;
+};
+
+BOOST_FIXTURE_TEST_CASE(PutBeforeShutdown, IdentityManagementTimeFixture)
+{
+  auto transport = make_shared<ClosableTransport>();
+  Face face(transport, io, m_keyChain);
+  advanceClocks(time::milliseconds(10));
+
+  face.put(*makeData("/A"));
+  face.shutdown();
+  advanceClocks(time::milliseconds(10));
+  BOOST_CHECK_EQUAL(transport->sent.size(), 1);
+  BOOST_CHECK(!transport->isConnected());
+
+  // shutdown followed by put within one handler
+  io.post([&] {
+    face.shutdown();
+    face.put(*makeData("/B"));
+  });
+  advanceClocks(time::milliseconds(10));
+  BOOST_CHECK_EQUAL(transport->sent.size(), 2);
+}
+
 class WithEnv : private IdentityManagementTimeFixture
 {
 public:
@@ -651,6 +651,45 @@ BOOST_AUTO_TEST_CASE(EncodeInterestLifetime)
                                 expected1000ms, expected1000ms + sizeof(expected1000ms));
 }
 
+BOOST_AUTO_TEST_CASE(ModifyWireInPlace)
+{
+  Interest i("/local/ndn/prefix", time::milliseconds(1000));
+  i.setNonce(1);
+  const uint8_t* wire = i.wireEncode().wire();
+
+  i.setNonce(2);
+  i.setInterestLifetime(time::milliseconds(2000));
+  BOOST_CHECK(i.hasWire());
+  BOOST_CHECK(i.wireEncode().wire() == wire);
+  BOOST_CHECK_EQUAL(Interest(i.wireEncode()).getNonce(), 2);
+  BOOST_CHECK_EQUAL(Interest(i.wireEncode()).getInterestLifetime(), time::milliseconds(2000));
+
+  // a copy shares the wire buffer, which must be copied before it is modified
+  Interest copy(i);
+  copy.refreshNonce();
+  copy.setInterestLifetime(time::milliseconds(3000));
+  BOOST_CHECK(copy.hasWire());
+  BOOST_CHECK(copy.wireEncode().wire() != wire);
+  BOOST_CHECK_NE(Interest(copy.wireEncode()).getNonce(), 2);
+  BOOST_CHECK_EQUAL(Interest(copy.wireEncode()).getInterestLifetime(), time::milliseconds(3000));
+  BOOST_CHECK_EQUAL(Interest(i.wireEncode()).getNonce(), 2);
+  BOOST_CHECK_EQUAL(Interest(i.wireEncode()).getInterestLifetime(), time::milliseconds(2000));
+
+  // so does a wire decoded from elsewhere
+  Block block = i.wireEncode();
+  Interest decoded(block);
+  decoded.setNonce(3);
+  BOOST_CHECK_EQUAL(Interest(block).getNonce(), 2);
+  BOOST_CHECK_EQUAL(decoded.getNonce(), 3);
+
+  // a lifetime of a different encoded length cannot be modified in place
+  i.setInterestLifetime(time::milliseconds(100000));
+  BOOST_CHECK(!i.hasWire());
+  Interest expected("/local/ndn/prefix", time::milliseconds(100000));
+  expected.setNonce(2);
+  BOOST_CHECK(i.wireEncode() == expected.wireEncode());
+}
+
 BOOST_AUTO_TEST_CASE(InterestEqualityChecks)
 {
   // Interest ::= INTEREST-TYPE TLV-LENGTH
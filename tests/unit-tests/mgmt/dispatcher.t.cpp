@@ -435,6 +435,78 @@ BOOST_AUTO_TEST_CASE(StatusDataset)
   BOOST_CHECK_EQUAL(storage.size(), 0); // the nack packet will not be inserted into the in-memory storage
 }
 
+BOOST_AUTO_TEST_CASE(StatusDatasetGeneration)
+{
+  static Block largeBlock = [] () -> Block {
+    EncodingBuffer encoder;
+    for (size_t i = 0; i < 2500; ++i) {
+      encoder.prependByte(1);
+    }
+    encoder.prependVarNumber(2500);
+    encoder.prependVarNumber(129);
+    return encoder.block();
+  }();
+
+  uint64_t generation = 1;
+  size_t nHandlerCalls = 0;
+  dispatcher.addStatusDataset("test/large",
+                              makeTestAuthorization(),
+                              [&nHandlerCalls] (const Name& prefix, const Interest& interest,
+                                                StatusDatasetContext& context) {
+                                ++nHandlerCalls;
+                                context.append(largeBlock);
+                                context.append(largeBlock);
+                                context.end();
+                              },
+                              [&generation] { return generation; });
+
+  auto makeFreshInterest = [] (const Name& name) {
+    auto interest = makeInterest(name);
+    interest->setMustBeFresh(true);
+    return interest;
+  };
+
+  dispatcher.addTopPrefix("/root");
+  advanceClocks(time::milliseconds(1));
+  face.sentData.clear();
+
+  face.receive(*makeFreshInterest("/root/test/large/valid"));
+  advanceClocks(time::milliseconds(1), 10);
+  BOOST_CHECK_EQUAL(nHandlerCalls, 1);
+  BOOST_REQUIRE_EQUAL(face.sentData.size(), 1);
+  BOOST_CHECK_EQUAL(storage.size(), 2);
+  Data first = face.sentData[0];
+
+  // same generation: the signed segments are reused after they become stale in the storage
+  advanceClocks(time::milliseconds(500), 4);
+  BOOST_CHECK(storage.find(*makeFreshInterest("/root/test/large/valid")) == nullptr);
+  face.sentData.clear();
+  face.receive(*makeFreshInterest("/root/test/large/valid"));
+  advanceClocks(time::milliseconds(1), 10);
+  BOOST_CHECK_EQUAL(nHandlerCalls, 1);
+  BOOST_REQUIRE_EQUAL(face.sentData.size(), 1);
+  BOOST_CHECK_EQUAL(storage.size(), 2);
+  BOOST_CHECK(face.sentData[0].wireEncode() == first.wireEncode());
+  Name segment1 = first.getName().getPrefix(-1).appendSegment(1);
+  BOOST_CHECK(storage.find(*makeFreshInterest(segment1)) != nullptr);
+
+  // a request with another Name has its own response
+  face.sentData.clear();
+  face.receive(*makeFreshInterest("/root/test/large/query/valid"));
+  advanceClocks(time::milliseconds(1), 10);
+  BOOST_CHECK_EQUAL(nHandlerCalls, 2);
+
+  // new generation: a new version is produced
+  advanceClocks(time::milliseconds(500), 4);
+  ++generation;
+  face.sentData.clear();
+  face.receive(*makeFreshInterest("/root/test/large/valid"));
+  advanceClocks(time::milliseconds(1), 10);
+  BOOST_CHECK_EQUAL(nHandlerCalls, 3);
+  BOOST_REQUIRE_EQUAL(face.sentData.size(), 1);
+  BOOST_CHECK_NE(face.sentData[0].getName(), first.getName());
+}
+
 BOOST_AUTO_TEST_CASE(NotificationStream)
 {
   static Block block("\x82\x01\x02", 3);
@@ -0,0 +1,114 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2013-2017 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#include "mgmt/face-counters-dataset.hpp"
+#include "encoding/block-helpers.hpp"
+#include "encoding/tlv-nfd.hpp"
+#include "util/dummy-client-face.hpp"
+
+#include "boost-test.hpp"
+#include "unit-tests/identity-management-time-fixture.hpp"
+#include "unit-tests/make-interest-data.hpp"
+
+namespace ndn {
+namespace mgmt {
+namespace tests {
+
+using namespace ndn::tests;
+using util::DummyClientFace;
+
+class FaceCountersDatasetFixture : public IdentityManagementTimeFixture
+{
+protected:
+  FaceCountersDatasetFixture()
+    : face(io, m_keyChain)
+  {
+  }
+
+  static uint64_t
+  readField(const Block& block, uint32_t type)
+  {
+    return readNonNegativeInteger(block.get(type));
+  }
+
+protected:
+  DummyClientFace face;
+};
+
+BOOST_AUTO_TEST_SUITE(Mgmt)
+BOOST_FIXTURE_TEST_SUITE(TestFaceCountersDataset, FaceCountersDatasetFixture)
+
+BOOST_AUTO_TEST_CASE(Encode)
+{
+  face.expressInterest(Interest("/A", time::milliseconds(100)), nullptr, nullptr, nullptr);
+  face.expressInterest(Interest("/B", time::milliseconds(100)), nullptr, nullptr, nullptr);
+  advanceClocks(time::milliseconds(5));
+  face.receive(*makeData("/A"));
+  advanceClocks(time::milliseconds(5));
+
+  Block block = encodeFaceCounters(face);
+  block.parse();
+  BOOST_CHECK_EQUAL(block.type(), tlv::face_counters::FaceCounters);
+  BOOST_CHECK_EQUAL(readField(block, tlv::nfd::NOutInterests), 2);
+  BOOST_CHECK_EQUAL(readField(block, tlv::nfd::NInData), 1);
+  BOOST_CHECK_EQUAL(readField(block, tlv::nfd::NInInterests), 0);
+  BOOST_CHECK_EQUAL(readField(block, tlv::face_counters::NPendingInterests), 1);
+  BOOST_CHECK_EQUAL(readField(block, tlv::face_counters::NTimeouts), 0);
+
+  Block histogram = block.get(tlv::face_counters::RttHistogram);
+  histogram.parse();
+  BOOST_REQUIRE_EQUAL(histogram.elements_size(), 1);
+  Block bucket = histogram.elements().front();
+  bucket.parse();
+  BOOST_CHECK_EQUAL(readField(bucket, tlv::face_counters::RttCount), 1);
+  BOOST_CHECK_GE(readField(bucket, tlv::face_counters::RttUpperBound), 5000);
+}
+
+BOOST_AUTO_TEST_CASE(DatasetHandler)
+{
+  StatusDatasetHandler handler = makeFaceCountersDatasetHandler(face);
+
+  std::vector<Block> contents;
+  bool isFinalBlock = false;
+  auto interest = makeInterest("/localhost/app/face-counters");
+  StatusDatasetContext context(*interest,
+    [&] (const Name&, const Block& content, time::milliseconds, bool isFinal) {
+      contents.push_back(content);
+      isFinalBlock = isFinal;
+    },
+    [] (const ControlResponse&) { BOOST_FAIL("unexpected Nack"); });
+
+  handler("/localhost/app", *interest, context);
+  BOOST_REQUIRE_EQUAL(contents.size(), 1);
+  BOOST_CHECK(isFinalBlock);
+
+  Block content = contents.front();
+  content.parse();
+  BOOST_REQUIRE_EQUAL(content.elements_size(), 1);
+  BOOST_CHECK_EQUAL(content.elements().front().type(), tlv::face_counters::FaceCounters);
+}
+
+BOOST_AUTO_TEST_SUITE_END() // TestFaceCountersDataset
+BOOST_AUTO_TEST_SUITE_END() // Mgmt
+
+} // namespace tests
+} // namespace mgmt
+} // namespace ndn
@@ -232,6 +232,129 @@ BOOST_AUTO_TEST_CASE(Failure)
 
 BOOST_AUTO_TEST_SUITE_END() // NoCallback
 
+BOOST_AUTO_TEST_SUITE(Each)
+
+BOOST_AUTO_TEST_CASE(SplitAcrossSegments)
+{
+  std::vector<FibEntry> received;
+  bool hasCompleted = false;
+  controller.fetchEach<FibDataset>(
+    [&received] (const FibEntry& entry) { received.push_back(entry); },
+    [&hasCompleted] { hasCompleted = true; },
+    datasetFailCallback);
+  this->advanceClocks(time::milliseconds(500));
+
+  FibEntry payload1;
+  payload1.setPrefix("/wYs7fzYcfG");
+  FibEntry payload2;
+  payload2.setPrefix("/LKvmnzY5S");
+  FibEntry payload3;
+  payload3.setPrefix("/j0Fz4aRFYD");
+  ndn::encoding::EncodingBuffer buffer;
+  payload3.wireEncode(buffer);
+  payload2.wireEncode(buffer);
+  payload1.wireEncode(buffer);
+
+  // the first segment ends within the TLV header of payload1,
+  // the second segment ends within the value of payload2
+  size_t size1 = payload1.wireEncode().size();
+  std::vector<size_t> boundaries{0, 1, size1 + 3, buffer.size()};
+  std::vector<size_t> nExpected{0, 1, 3};
+
+  Name versionName = Name("/localhost/nfd/fib/list").appendVersion();
+  for (size_t i = 0; i < nExpected.size(); ++i) {
+    auto data = make_shared<Data>(Name(versionName).appendSegment(i));
+    data->setContent(buffer.buf() + boundaries[i], boundaries[i + 1] - boundaries[i]);
+    if (i == nExpected.size() - 1) {
+      data->setFinalBlockId(data->getName()[-1]);
+    }
+    face.receive(*signData(data));
+    this->advanceClocks(time::milliseconds(500));
+
+    BOOST_CHECK_EQUAL(received.size(), nExpected[i]);
+    BOOST_CHECK_EQUAL(hasCompleted, i == nExpected.size() - 1);
+  }
+
+  BOOST_REQUIRE_EQUAL(received.size(), 3);
+  BOOST_CHECK_EQUAL(received[0].getPrefix(), "/wYs7fzYcfG");
+  BOOST_CHECK_EQUAL(received[1].getPrefix(), "/LKvmnzY5S");
+  BOOST_CHECK_EQUAL(received[2].getPrefix(), "/j0Fz4aRFYD");
+  BOOST_CHECK_EQUAL(failCodes.size(), 0);
+}
+
+BOOST_AUTO_TEST_CASE(Truncated)
+{
+  std::vector<FibEntry> received;
+  controller.fetchEach<FibDataset>(
+    [&received] (const FibEntry& entry) { received.push_back(entry); },
+    [] { BOOST_FAIL("fetchEach should not succeed"); },
+    datasetFailCallback);
+  this->advanceClocks(time::milliseconds(500));
+
+  FibEntry payload1;
+  payload1.setPrefix("/wYs7fzYcfG");
+  FibEntry payload2;
+  payload2.setPrefix("/LKvmnzY5S");
+  ndn::encoding::EncodingBuffer buffer;
+  payload2.wireEncode(buffer);
+  payload1.wireEncode(buffer);
+
+  auto data = make_shared<Data>(Name("/localhost/nfd/fib/list").appendVersion().appendSegment(0));
+  data->setContent(buffer.buf(), buffer.size() - 1);
+  data->setFinalBlockId(data->getName()[-1]);
+  face.receive(*signData(data));
+  this->advanceClocks(time::milliseconds(500));
+
+  BOOST_CHECK_EQUAL(received.size(), 1);
+  BOOST_REQUIRE_EQUAL(failCodes.size(), 1);
+  BOOST_CHECK_EQUAL(failCodes.back(), Controller::ERROR_SERVER);
+}
+
+BOOST_AUTO_TEST_CASE(ParseError)
+{
+  controller.fetchEach<FaceDataset>(
+    [] (const FaceStatus& element) {},
+    [] { BOOST_FAIL("fetchEach should not succeed"); },
+    datasetFailCallback);
+  this->advanceClocks(time::milliseconds(500));
+
+  FaceStatus payload1;
+  payload1.setFaceId(10930);
+  Name payload2; // Name is not valid FaceStatus
+  this->sendDataset("/localhost/nfd/faces/list", payload1, payload2);
+  this->advanceClocks(time::milliseconds(500));
+
+  BOOST_REQUIRE_EQUAL(failCodes.size(), 1);
+  BOOST_CHECK_EQUAL(failCodes.back(), Controller::ERROR_SERVER);
+}
+
+BOOST_AUTO_TEST_CASE(WithParam)
+{
+  size_t nReceived = 0;
+  bool hasCompleted = false;
+  FaceQueryFilter filter;
+  filter.setUriScheme("udp4");
+  controller.fetchEach<FaceQueryDataset>(
+    filter,
+    [&nReceived] (const FaceStatus& element) { ++nReceived; },
+    [&hasCompleted] { hasCompleted = true; },
+    datasetFailCallback);
+  this->advanceClocks(time::milliseconds(500));
+
+  Name prefix("/localhost/nfd/faces/query");
+  prefix.append(filter.wireEncode());
+  FaceStatus payload;
+  payload.setFaceId(8795);
+  this->sendDataset(prefix, payload);
+  this->advanceClocks(time::milliseconds(500));
+
+  BOOST_CHECK_EQUAL(nReceived, 1);
+  BOOST_CHECK(hasCompleted);
+  BOOST_CHECK_EQUAL(failCodes.size(), 0);
+}
+
+BOOST_AUTO_TEST_SUITE_END() // Each
+
 BOOST_AUTO_TEST_SUITE(Datasets)
 
 BOOST_AUTO_TEST_CASE(StatusGeneral)
@@ -0,0 +1,120 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2013-2017 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#include "name-builder.hpp"
+
+#include "boost-test.hpp"
+
+namespace ndn {
+namespace tests {
+
+BOOST_AUTO_TEST_SUITE(TestNameBuilder)
+
+BOOST_AUTO_TEST_CASE(Append)
+{
+  NameBuilder builder("/local/ndn");
+  BOOST_CHECK_EQUAL(builder.size(), 2);
+
+  const uint8_t value[] = {0x01, 0x02};
+  builder.append(name::Component("prefix"))
+         .append(value, sizeof(value))
+         .append(PartialName("/a/b"))
+         .appendNumber(300)
+         .appendVersion(1)
+         .appendSegment(0x10000)
+         .appendSequenceNumber(0xFFFFFFFFFFULL);
+  BOOST_CHECK_EQUAL(builder.size(), 10);
+
+  Name expected("/local/ndn");
+  expected.append("prefix")
+          .append(value, sizeof(value))
+          .append(PartialName("/a/b"))
+          .appendNumber(300)
+          .appendVersion(1)
+          .appendSegment(0x10000)
+          .appendSequenceNumber(0xFFFFFFFFFFULL);
+
+  Name name = builder.getName();
+  BOOST_CHECK_EQUAL(name, expected);
+  BOOST_CHECK_EQUAL_COLLECTIONS(name.wireEncode().begin(), name.wireEncode().end(),
+                                expected.wireEncode().begin(), expected.wireEncode().end());
+
+  BOOST_CHECK_EQUAL(NameBuilder().getName(), Name());
+  BOOST_CHECK(NameBuilder().empty());
+}
+
+BOOST_AUTO_TEST_CASE(LongComponent)
+{
+  std::vector<uint8_t> value(300, 0xAA);
+  NameBuilder builder;
+  builder.append(value.data(), value.size());
+
+  Name expected;
+  expected.append(value.data(), value.size());
+  BOOST_CHECK_EQUAL(builder.getName(), expected);
+  BOOST_CHECK_EQUAL(builder.wireEncode().size(), expected.wireEncode().size());
+}
+
+BOOST_AUTO_TEST_CASE(ReplaceLast)
+{
+  NameBuilder builder("/prefix");
+  builder.appendSegment(0);
+  BOOST_CHECK_EQUAL(builder.getName(), Name("/prefix").appendSegment(0));
+
+  Name previous = builder.getName();
+  for (uint64_t segmentNo : {1, 255, 256, 65536, 1}) {
+    builder.replaceLastWithSegment(segmentNo);
+    BOOST_CHECK_EQUAL(builder.size(), 2);
+    BOOST_CHECK_EQUAL(builder.getName(), Name("/prefix").appendSegment(segmentNo));
+  }
+  // Names previously obtained are not affected
+  BOOST_CHECK_EQUAL(previous, Name("/prefix").appendSegment(0));
+
+  builder.replaceLastWithVersion(7);
+  BOOST_CHECK_EQUAL(builder.getName(), Name("/prefix").appendVersion(7));
+
+  builder.replaceLast(name::Component("x"));
+  BOOST_CHECK_EQUAL(builder.getName(), Name("/prefix/x"));
+
+  builder.removeLast();
+  BOOST_CHECK_EQUAL(builder.getName(), Name("/prefix"));
+  builder.replaceLastWithSegment(3);
+  BOOST_CHECK_EQUAL(builder.getName(), Name().appendSegment(3));
+
+  builder.removeLast();
+  BOOST_CHECK(builder.empty());
+  BOOST_CHECK_THROW(builder.removeLast(), Name::Error);
+  BOOST_CHECK_THROW(builder.replaceLastWithSegment(0), Name::Error);
+}
+
+BOOST_AUTO_TEST_CASE(RemoveLast)
+{
+  NameBuilder builder("/a/b/c");
+  builder.removeLast().removeLast();
+  BOOST_CHECK_EQUAL(builder.getName(), Name("/a"));
+  builder.append(name::Component("d")).removeLast().replaceLast(name::Component("e"));
+  BOOST_CHECK_EQUAL(builder.getName(), Name("/e"));
+}
+
+BOOST_AUTO_TEST_SUITE_END() // TestNameBuilder
+
+} // namespace tests
+} // namespace ndn
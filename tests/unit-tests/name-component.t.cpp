@@ -86,6 +86,53 @@ BOOST_AUTO_TEST_CASE(Invalid)
 
 BOOST_AUTO_TEST_SUITE_END() // Decode
 
+BOOST_AUTO_TEST_CASE(Uri)
+{
+  // every octet value round-trips, and is escaped the same way in string and stream output
+  std::vector<uint8_t> value(256);
+  for (size_t i = 0; i < value.size(); ++i) {
+    value[i] = static_cast<uint8_t>(i);
+  }
+  name::Component comp(value.data(), value.size());
+
+  std::string uri = comp.toUri();
+  std::ostringstream os;
+  comp.toUri(os);
+  BOOST_CHECK_EQUAL(os.str(), uri);
+  BOOST_CHECK_EQUAL(uri.substr(0, 9), "%00%01%02");
+  BOOST_CHECK_EQUAL(uri.find("+%2C-.%2F0123456789%3A"), 0x2B * 3);
+  BOOST_CHECK_EQUAL(name::Component::fromEscapedString(uri), comp);
+
+  std::string appended("prefix/");
+  comp.toUri(appended);
+  BOOST_CHECK_EQUAL(appended, "prefix/" + uri);
+
+  BOOST_CHECK_EQUAL(name::Component("A-z_0.9+").toUri(), "A-z_0.9+");
+  BOOST_CHECK_EQUAL(name::Component("").toUri(), "...");
+  BOOST_CHECK_EQUAL(name::Component("..").toUri(), ".....");
+  BOOST_CHECK_EQUAL(name::Component::fromEscapedString(" .... "), name::Component("."));
+  BOOST_CHECK_EQUAL(name::Component::fromEscapedString("%41%4g%"), name::Component("A%4g%"));
+  BOOST_CHECK_EQUAL(name::Component::fromEscapedString("%2E%2E%2E"), name::Component(""));
+  BOOST_CHECK_THROW(name::Component::fromEscapedString(".."), name::Component::Error);
+
+  std::vector<uint8_t> decoded;
+  BOOST_CHECK_EQUAL(name::Component::decodeEscapedString(uri.data(), uri.data() + uri.size(),
+                                                         decoded),
+                    tlv::NameComponent);
+  BOOST_CHECK(decoded == value);
+
+  std::string digestUri = "sha256digest=28bad4b5275bd392dbb670c75cf0b66f"
+                          "13f7942b21e80f55c0e86b374753a548";
+  name::Component digest = name::Component::fromEscapedString(digestUri);
+  BOOST_CHECK(digest.isImplicitSha256Digest());
+  BOOST_CHECK_EQUAL(digest.toUri(), digestUri);
+  BOOST_CHECK_THROW(name::Component::fromEscapedString("sha256digest=28ba"),
+                    name::Component::Error);
+  BOOST_CHECK_THROW(name::Component::fromEscapedString("sha256digest=zzbad4b5275bd392dbb670c75cf0b66f"
+                                                       "13f7942b21e80f55c0e86b374753a548"),
+                    name::Component::Error);
+}
+
 BOOST_AUTO_TEST_SUITE(Compare)
 
 BOOST_AUTO_TEST_CASE(Generic)
@@ -417,6 +417,36 @@ BOOST_AUTO_TEST_CASE(NameWithSpaces)
   BOOST_CHECK_THROW(Name("/hello//world"), name::Component::Error);
 }
 
+BOOST_AUTO_TEST_CASE(UriParsing)
+{
+  BOOST_CHECK_EQUAL(Name("ndn:/a/b").toUri(), "/a/b");
+  BOOST_CHECK_EQUAL(Name(" ndn: /a/b/ ").toUri(), "/a/b");
+  BOOST_CHECK_EQUAL(Name("//authority/a/b").toUri(), "/a/b");
+  BOOST_CHECK_EQUAL(Name("//authority").toUri(), "/");
+  BOOST_CHECK_EQUAL(Name("a/b").toUri(), "/a/b");
+  BOOST_CHECK_EQUAL(Name("/").toUri(), "/");
+  BOOST_CHECK_EQUAL(Name("ndn:").toUri(), "/");
+  BOOST_CHECK_EQUAL(Name("").toUri(), "/");
+  BOOST_CHECK_EQUAL(Name("/a:b/c").toUri(), "/a%3Ab/c");
+  BOOST_CHECK_EQUAL(Name("/.../%2E%2E%2E%2E/%00%FF").toUri(), "/.../..../%00%FF");
+
+  Name name("/A/.../%00%01/sha256digest=28bad4b5275bd392dbb670c75cf0b66f"
+            "13f7942b21e80f55c0e86b374753a548");
+  BOOST_REQUIRE_EQUAL(name.size(), 4);
+  BOOST_CHECK_EQUAL(name[1].value_size(), 0);
+  BOOST_CHECK(name[3].isImplicitSha256Digest());
+  BOOST_CHECK(name.wireEncode() == Name(name.wireEncode()).wireEncode());
+
+  std::ostringstream os;
+  os << name;
+  BOOST_CHECK_EQUAL(os.str(), name.toUri());
+
+  std::string appended("uri=");
+  name.toUri(appended);
+  BOOST_CHECK_EQUAL(appended, "uri=" + name.toUri());
+  BOOST_CHECK_EQUAL(Name(name.toUri()), name);
+}
+
 BOOST_AUTO_TEST_CASE(Append)
 {
   PartialName toAppend("/and");
@@ -402,6 +402,32 @@ BOOST_AUTO_TEST_CASE(TtlZero)
   assertAccept(*i1); // accepted despite timestamp is reordered, because record has been expired
 }
 
+BOOST_AUTO_TEST_CASE(Sharded)
+{
+  CommandInterestValidator::Options options;
+  options.gracePeriod = time::seconds(15);
+  options.maxTimestamps = 16; // 4 records per shard
+  options.nShards = 4;
+  initialize(options);
+
+  std::vector<shared_ptr<Interest>> first, second;
+  for (uint64_t identity = 0; identity < 4; ++identity) {
+    first.push_back(makeCommandInterest(identity));
+  }
+  advanceClocks(time::seconds(1));
+  for (uint64_t identity = 0; identity < 4; ++identity) {
+    second.push_back(makeCommandInterest(identity));
+  }
+
+  for (uint64_t identity = 0; identity < 4; ++identity) {
+    assertAccept(*second[identity]);
+  }
+  for (uint64_t identity = 0; identity < 4; ++identity) {
+    // every record is kept, even if all identities are assigned to the same shard
+    assertReject(*first[identity], CommandInterestValidator::ErrorCode::TIMESTAMP_REORDER);
+  }
+}
+
 BOOST_AUTO_TEST_SUITE_END() // Options
 
 BOOST_AUTO_TEST_SUITE_END() // TestCommandInterestValidator
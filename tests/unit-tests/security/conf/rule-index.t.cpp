@@ -0,0 +1,116 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2013-2017 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#include "security/conf/rule-index.hpp"
+
+#include "boost-test.hpp"
+#include "../../make-interest-data.hpp"
+
+namespace ndn {
+namespace security {
+namespace conf {
+namespace tests {
+
+using namespace ndn::tests;
+
+BOOST_AUTO_TEST_SUITE(Security)
+BOOST_AUTO_TEST_SUITE(Conf)
+BOOST_AUTO_TEST_SUITE(TestRuleIndex)
+
+static shared_ptr<Rule<Data>>
+makeRelationRule(const std::string& id, const Name& name, RelationNameFilter::Relation relation)
+{
+  auto rule = make_shared<Rule<Data>>(id);
+  rule->addFilter(make_shared<RelationNameFilter>(name, relation));
+  return rule;
+}
+
+static shared_ptr<Rule<Data>>
+makeRegexRule(const std::string& id, const std::string& regex)
+{
+  auto rule = make_shared<Rule<Data>>(id);
+  rule->addFilter(make_shared<RegexNameFilter>(Regex(regex)));
+  return rule;
+}
+
+BOOST_AUTO_TEST_CASE(RequiredPrefix)
+{
+  BOOST_CHECK_EQUAL(makeRegexRule("r", "^<a><b><>*$")->getRequiredPrefix(), "/a/b");
+  BOOST_CHECK_EQUAL(makeRegexRule("r", "^<a><b>*<c>")->getRequiredPrefix(), "/a");
+  BOOST_CHECK_EQUAL(makeRegexRule("r", "^<a><b.*><c>")->getRequiredPrefix(), "/a");
+  BOOST_CHECK_EQUAL(makeRegexRule("r", "^<a>(<b>)<c>")->getRequiredPrefix(), "/a");
+  BOOST_CHECK_EQUAL(makeRegexRule("r", "^<a>[<b><c>]")->getRequiredPrefix(), "/a");
+  BOOST_CHECK_EQUAL(makeRegexRule("r", "<a><b>")->getRequiredPrefix(), "/");
+  BOOST_CHECK_EQUAL(makeRegexRule("r", "^<>*<a>")->getRequiredPrefix(), "/");
+  BOOST_CHECK_EQUAL(makeRelationRule("r", "/x/y", RelationNameFilter::RELATION_EQUAL)
+                      ->getRequiredPrefix(), "/x/y");
+
+  auto rule = makeRelationRule("r", "/x", RelationNameFilter::RELATION_IS_PREFIX_OF);
+  rule->addFilter(make_shared<RegexNameFilter>(Regex("^<x><y><z>")));
+  BOOST_CHECK_EQUAL(rule->getRequiredPrefix(), "/x/y/z");
+
+  BOOST_CHECK_EQUAL(Rule<Data>("r").getRequiredPrefix(), "/");
+}
+
+BOOST_AUTO_TEST_CASE(FirstMatchOrder)
+{
+  RuleIndex<Data> index;
+  BOOST_CHECK(index.empty());
+
+  index.insert(makeRelationRule("ab-strict", "/a/b", RelationNameFilter::RELATION_IS_STRICT_PREFIX_OF));
+  index.insert(makeRegexRule("any-c", "^<>*<c>$"));
+  index.insert(makeRelationRule("a", "/a", RelationNameFilter::RELATION_IS_PREFIX_OF));
+  index.insert(makeRegexRule("ab-regex", "^<a><b>"));
+  index.insert(make_shared<Rule<Data>>("catch-all"));
+  BOOST_CHECK_EQUAL(index.size(), 5);
+
+  BOOST_CHECK_EQUAL(index.findMatch(*makeData("/a/b/c"))->getId(), "ab-strict");
+  BOOST_CHECK_EQUAL(index.findMatch(*makeData("/a/c"))->getId(), "any-c");
+  BOOST_CHECK_EQUAL(index.findMatch(*makeData("/a/b"))->getId(), "a");
+  BOOST_CHECK_EQUAL(index.findMatch(*makeData("/x/c"))->getId(), "any-c");
+  BOOST_CHECK_EQUAL(index.findMatch(*makeData("/x/y"))->getId(), "catch-all");
+
+  index.clear();
+  BOOST_CHECK(index.empty());
+  BOOST_CHECK(index.findMatch(*makeData("/a/b/c")) == nullptr);
+}
+
+BOOST_AUTO_TEST_CASE(InterestUnsignedName)
+{
+  RuleIndex<Interest> index;
+  auto rule = make_shared<Rule<Interest>>("cmd");
+  rule->addFilter(make_shared<RelationNameFilter>("/cmd", RelationNameFilter::RELATION_EQUAL));
+  index.insert(rule);
+
+  // the last four components of a command Interest are excluded from matching
+  BOOST_CHECK(index.findMatch(*makeInterest("/cmd/1/2/3/4")) == rule);
+  BOOST_CHECK(index.findMatch(*makeInterest("/cmd/1/2/3")) == nullptr);
+  BOOST_CHECK(index.findMatch(*makeInterest("/other/1/2/3/4")) == nullptr);
+}
+
+BOOST_AUTO_TEST_SUITE_END() // TestRuleIndex
+BOOST_AUTO_TEST_SUITE_END() // Conf
+BOOST_AUTO_TEST_SUITE_END() // Security
+
+} // namespace tests
+} // namespace conf
+} // namespace security
+} // namespace ndn
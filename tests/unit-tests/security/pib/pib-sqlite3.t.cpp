@@ -20,20 +20,108 @@
  */
 
 #include "security/pib/pib-sqlite3.hpp"
+#include "security/pib/pib.hpp"
 
 #include "boost-test.hpp"
+#include "pib-data-fixture.hpp"
+#include "../../unit-test-time-fixture.hpp"
+
+#include <boost/filesystem.hpp>
 
 namespace ndn {
 namespace security {
 namespace pib {
 namespace tests {
 
+using security::tests::PibDataFixture;
+using ndn::tests::UnitTestTimeFixture;
+
+class PibSqlite3Fixture : public PibDataFixture, public UnitTestTimeFixture
+{
+public:
+  PibSqlite3Fixture()
+    : tmpPath(boost::filesystem::path(UNIT_TEST_CONFIG_PATH) / "DbTest")
+  {
+  }
+
+  ~PibSqlite3Fixture()
+  {
+    boost::filesystem::remove_all(tmpPath);
+  }
+
+public:
+  boost::filesystem::path tmpPath;
+};
+
 BOOST_AUTO_TEST_SUITE(Security)
 BOOST_AUTO_TEST_SUITE(Pib)
-BOOST_AUTO_TEST_SUITE(TestPibSqlite3)
+BOOST_FIXTURE_TEST_SUITE(TestPibSqlite3, PibSqlite3Fixture)
 
 // Functionality is tested as part of pib-impl.t.cpp
 
+BOOST_AUTO_TEST_CASE(CacheCoherence)
+{
+  PibSqlite3 pib1(tmpPath.string());
+  PibSqlite3 pib2(tmpPath.string());
+  pib1.setCacheValidationInterval(time::nanoseconds::zero());
+  pib2.setCacheValidationInterval(time::nanoseconds::zero());
+
+  pib1.addCertificate(id1Key1Cert1);
+  BOOST_CHECK_EQUAL(pib2.getDefaultIdentity(), id1);
+  BOOST_CHECK_EQUAL(pib2.getDefaultKeyOfIdentity(id1), id1Key1Name);
+  BOOST_CHECK_EQUAL(pib2.getDefaultCertificateOfKey(id1Key1Name), id1Key1Cert1);
+  BOOST_CHECK_EQUAL(pib2.getKeysOfIdentity(id1).size(), 1);
+
+  // modifications made through pib1 are seen by pib2 after its lookups have been cached
+  pib1.addCertificate(id1Key2Cert1);
+  pib1.setDefaultKeyOfIdentity(id1, id1Key2Name);
+  BOOST_CHECK_EQUAL(pib2.getDefaultKeyOfIdentity(id1), id1Key2Name);
+  BOOST_CHECK_EQUAL(pib2.getKeysOfIdentity(id1).size(), 2);
+
+  pib1.removeIdentity(id1);
+  BOOST_CHECK_EQUAL(pib2.hasIdentity(id1), false);
+  BOOST_CHECK_EQUAL(pib2.hasKey(id1Key1Name), false);
+  BOOST_CHECK_EQUAL(pib2.hasCertificate(id1Key1Cert1.getName()), false);
+  BOOST_CHECK_THROW(pib2.getDefaultIdentity(), pib::Pib::Error);
+
+  // modifications made through pib2 are seen by pib2 itself
+  pib2.addCertificate(id2Key1Cert1);
+  BOOST_CHECK_EQUAL(pib2.hasIdentity(id2), true);
+  pib2.addCertificate(id2Key1Cert2);
+  pib2.setDefaultCertificateOfKey(id2Key1Name, id2Key1Cert2.getName());
+  BOOST_CHECK_EQUAL(pib2.getDefaultCertificateOfKey(id2Key1Name), id2Key1Cert2);
+  BOOST_CHECK_EQUAL(pib1.getDefaultCertificateOfKey(id2Key1Name), id2Key1Cert2);
+  pib2.removeCertificate(id2Key1Cert2.getName());
+  BOOST_CHECK_EQUAL(pib2.getCertificatesOfKey(id2Key1Name).size(), 1);
+  BOOST_CHECK_THROW(pib2.getDefaultCertificateOfKey(id2Key1Name), pib::Pib::Error);
+}
+
+BOOST_AUTO_TEST_CASE(CacheValidationInterval)
+{
+  PibSqlite3 pib1(tmpPath.string());
+  PibSqlite3 pib2(tmpPath.string());
+
+  // absent entries are cached as well
+  BOOST_CHECK_EQUAL(pib2.hasIdentity(id1), false);
+  BOOST_CHECK_EQUAL(pib2.hasKey(id1Key1Name), false);
+  BOOST_CHECK_EQUAL(pib2.hasCertificate(id1Key1Cert1.getName()), false);
+
+  // modifications made through pib1 are seen by pib2 once the interval has elapsed
+  pib1.addCertificate(id1Key1Cert1);
+  advanceClocks(PibSqlite3::DEFAULT_CACHE_VALIDATION_INTERVAL / 2);
+  BOOST_CHECK_EQUAL(pib2.hasIdentity(id1), false);
+  BOOST_CHECK_EQUAL(pib2.hasKey(id1Key1Name), false);
+
+  advanceClocks(PibSqlite3::DEFAULT_CACHE_VALIDATION_INTERVAL / 2);
+  BOOST_CHECK_EQUAL(pib2.hasIdentity(id1), true);
+  BOOST_CHECK_EQUAL(pib2.hasKey(id1Key1Name), true);
+  BOOST_CHECK_EQUAL(pib2.hasCertificate(id1Key1Cert1.getName()), true);
+
+  // modifications made through pib2 are seen by pib2 immediately
+  pib2.removeCertificate(id1Key1Cert1.getName());
+  BOOST_CHECK_EQUAL(pib2.hasCertificate(id1Key1Cert1.getName()), false);
+}
+
 BOOST_AUTO_TEST_SUITE_END() // TestPibSqlite3
 BOOST_AUTO_TEST_SUITE_END() // Pib
 BOOST_AUTO_TEST_SUITE_END() // Security
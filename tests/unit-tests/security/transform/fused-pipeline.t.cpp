@@ -0,0 +1,158 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2013-2017 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#include "security/transform/fused-pipeline.hpp"
+#include "security/transform.hpp"
+#include "security/transform/private-key.hpp"
+#include "security/transform/public-key.hpp"
+#include "security/key-params.hpp"
+#include "encoding/buffer-stream.hpp"
+
+#include "boost-test.hpp"
+
+#include <boost/mpl/list.hpp>
+
+namespace ndn {
+namespace security {
+namespace transform {
+namespace tests {
+
+BOOST_AUTO_TEST_SUITE(Security)
+BOOST_AUTO_TEST_SUITE(Transform)
+BOOST_AUTO_TEST_SUITE(TestFusedPipeline)
+
+BOOST_AUTO_TEST_CASE(Digest)
+{
+  const uint8_t in[] = {0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07};
+
+  OBufferStream os;
+  bufferSource(in, sizeof(in)) >> digestFilter(DigestAlgorithm::SHA256) >> streamSink(os);
+  ConstBufferPtr expected = os.buf();
+
+  uint8_t out[64];
+  size_t outLen = 0;
+  fused::DigestPipeline pipeline(fused::BufferSink(out, sizeof(out), outLen), DigestAlgorithm::SHA256);
+  pipeline.write(in, 3).write(in + 3, sizeof(in) - 3);
+  pipeline.end();
+  BOOST_CHECK_EQUAL_COLLECTIONS(out, out + outLen, expected->begin(), expected->end());
+
+  // ending twice has no effect, writing after end is an error
+  pipeline.end();
+  BOOST_CHECK_EQUAL(outLen, expected->size());
+  BOOST_CHECK_THROW(pipeline.write(in, sizeof(in)), Error);
+
+  fused::DigestPipeline small(fused::BufferSink(out, 16, outLen), DigestAlgorithm::SHA256);
+  small.write(in, sizeof(in));
+  BOOST_CHECK_THROW(small.end(), Error);
+
+  BOOST_CHECK_THROW(fused::Digest(DigestAlgorithm::NONE), Error);
+}
+
+struct RsaKeyParamsInfo
+{
+  static RsaKeyParams
+  getParams()
+  {
+    return RsaKeyParams();
+  }
+};
+
+struct EcKeyParamsInfo
+{
+  static EcKeyParams
+  getParams()
+  {
+    return EcKeyParams();
+  }
+};
+
+typedef boost::mpl::list<RsaKeyParamsInfo, EcKeyParamsInfo> KeyParamsInfos;
+
+BOOST_AUTO_TEST_CASE_TEMPLATE(SignVerify, KeyParamsInfo, KeyParamsInfos)
+{
+  const uint8_t data[] = {0x01, 0x02, 0x03, 0x04};
+
+  unique_ptr<PrivateKey> sKey = generatePrivateKey(KeyParamsInfo::getParams());
+  ConstBufferPtr pKeyBits = sKey->derivePublicKey();
+  PublicKey pKey;
+  pKey.loadPkcs8(pKeyBits->buf(), pKeyBits->size());
+
+  fused::Signer signer(DigestAlgorithm::SHA256, *sKey);
+  Buffer sig(signer.getMaxSignatureSize());
+  signer.update(data, sizeof(data));
+  sig.resize(signer.finalize(sig.buf(), sig.size()));
+
+  // signature produced by the fused signer is accepted by the dynamic chain
+  bool result = false;
+  bufferSource(data, sizeof(data)) >> verifierFilter(DigestAlgorithm::SHA256, pKey, sig.buf(), sig.size())
+                                   >> boolSink(result);
+  BOOST_CHECK_EQUAL(result, true);
+
+  // and by the fused verifier
+  result = false;
+  fused::VerifierPipeline verifier(fused::BoolSink(result), DigestAlgorithm::SHA256,
+                                   pKey, sig.buf(), sig.size());
+  verifier.write(data, sizeof(data));
+  verifier.end();
+  BOOST_CHECK_EQUAL(result, true);
+
+  // signature produced by the dynamic chain is accepted by the fused verifier
+  OBufferStream os;
+  bufferSource(data, sizeof(data)) >> signerFilter(DigestAlgorithm::SHA256, *sKey) >> streamSink(os);
+  ConstBufferPtr sig2 = os.buf();
+  result = false;
+  fused::VerifierPipeline verifier2(fused::BoolSink(result), DigestAlgorithm::SHA256,
+                                    pKey, sig2->buf(), sig2->size());
+  verifier2.write(data, sizeof(data));
+  verifier2.end();
+  BOOST_CHECK_EQUAL(result, true);
+
+  // modified input does not verify
+  result = true;
+  fused::VerifierPipeline verifier3(fused::BoolSink(result), DigestAlgorithm::SHA256,
+                                    pKey, sig.buf(), sig.size());
+  verifier3.write(data, sizeof(data) - 1);
+  try {
+    verifier3.end();
+  }
+  catch (const Error&) {
+    result = false;
+  }
+  BOOST_CHECK_EQUAL(result, false);
+
+  // output buffer smaller than the maximum signature size
+  fused::Signer signer2(DigestAlgorithm::SHA256, *sKey);
+  signer2.update(data, sizeof(data));
+  BOOST_CHECK_THROW(signer2.finalize(sig.buf(), 1), Error);
+
+  // public key that was never loaded
+  PublicKey emptyKey;
+  BOOST_CHECK_THROW(fused::Verifier(DigestAlgorithm::SHA256, emptyKey, sig.buf(), sig.size()), Error);
+}
+
+BOOST_AUTO_TEST_SUITE_END() // TestFusedPipeline
+BOOST_AUTO_TEST_SUITE_END() // Transform
+BOOST_AUTO_TEST_SUITE_END() // Security
+
+} // namespace tests
+} // namespace transform
+} // namespace security
+} // namespace ndn
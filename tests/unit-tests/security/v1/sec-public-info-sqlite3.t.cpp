@@ -146,6 +146,58 @@ BOOST_AUTO_TEST_CASE(KeyTypeNonExistent)
   BOOST_CHECK_EQUAL(KeyType::NONE, pib.getPublicKeyType(nullKeyName));
 }
 
+BOOST_FIXTURE_TEST_CASE(ListEntries, PibTmpPathFixture)
+{
+  using namespace CryptoPP;
+
+  OBufferStream os;
+  StringSource ss(reinterpret_cast<const uint8_t*>(RSA_DER.c_str()), RSA_DER.size(),
+                  true, new Base64Decoder(new FileSink(os)));
+  v1::PublicKey key(os.buf()->buf(), os.buf()->size());
+
+  SecPublicInfoSqlite3 pib(tmpPath.generic_string());
+  pib.addIdentity("/ab");
+  pib.addKey("/a/ksk-1", key);
+  pib.addKey("/a/ksk-2", key);
+  pib.addIdentity("/a/b");
+  pib.addIdentity("/c");
+  pib.setDefaultIdentity("/a/b");
+  pib.setDefaultKeyNameForIdentity("/a/ksk-2");
+
+  auto list = [&pib] (const Name& prefix, SecPublicInfo::ListDepth depth) {
+    std::vector<std::string> entries;
+    pib.listEntries(prefix, depth, [&entries] (const SecPublicInfo::ListEntry& entry) {
+      std::string line = entry.identity.toUri() + (entry.isDefaultIdentity ? "*" : "");
+      if (!entry.keyName.empty())
+        line += " " + entry.keyName.toUri() + (entry.isDefaultKey ? "*" : "");
+      if (!entry.certName.empty())
+        line += " " + entry.certName.toUri();
+      entries.push_back(line);
+    });
+    return entries;
+  };
+
+  std::vector<std::string> expected{"/a/b*", "/a", "/ab", "/c"};
+  std::vector<std::string> actual = list("/", SecPublicInfo::LIST_IDENTITIES);
+  BOOST_CHECK_EQUAL_COLLECTIONS(actual.begin(), actual.end(), expected.begin(), expected.end());
+
+  expected = {"/a/b*", "/a /a/ksk-2*", "/a /a/ksk-1"};
+  actual = list("/a", SecPublicInfo::LIST_KEYS);
+  BOOST_CHECK_EQUAL_COLLECTIONS(actual.begin(), actual.end(), expected.begin(), expected.end());
+
+  expected = {"/a/b*"};
+  actual = list("/a/b", SecPublicInfo::LIST_CERTIFICATE_NAMES);
+  BOOST_CHECK_EQUAL_COLLECTIONS(actual.begin(), actual.end(), expected.begin(), expected.end());
+
+  // the default implementation visits the same entries
+  std::vector<std::string> fromBase;
+  pib.SecPublicInfo::listEntries("/a", SecPublicInfo::LIST_KEYS,
+    [&fromBase] (const SecPublicInfo::ListEntry& entry) {
+      fromBase.push_back(entry.keyName.toUri());
+    });
+  BOOST_CHECK_EQUAL(fromBase.size(), 3);
+}
+
 BOOST_AUTO_TEST_SUITE_END() // TestSecPublicInfoSqlite3
 BOOST_AUTO_TEST_SUITE_END() // V1
 BOOST_AUTO_TEST_SUITE_END() // Security
@@ -181,6 +181,22 @@ BOOST_FIXTURE_TEST_CASE_TEMPLATE(ValidateSuccessWithoutBundle, T, SuccessWithout
   }
 }
 
+BOOST_FIXTURE_TEST_CASE(Prefetch, CertificateBundleFetcherFixture<Bundle>)
+{
+  CertificateStorage storage;
+  CertificateBundleFetcherWrapper fetcher(this->face);
+  fetcher.setCertificateStorage(storage);
+
+  fetcher.prefetchBundle(this->data.getName());
+  this->mockNetworkOperations();
+  BOOST_CHECK_EQUAL(this->face.sentInterests.size(), 2); // produced bundle has 2 segments
+
+  const CertificateCache& unverified = storage.getUnverifiedCertCache();
+  BOOST_CHECK(unverified.find(this->subSubIdentity.getDefaultKey().getDefaultCertificate().getName()) != nullptr);
+  BOOST_CHECK(unverified.find(this->subIdentity.getDefaultKey().getDefaultCertificate().getName()) != nullptr);
+  BOOST_CHECK(unverified.find(this->identity.getDefaultKey().getDefaultCertificate().getName()) != nullptr);
+}
+
 BOOST_AUTO_TEST_SUITE_END() // TestCertificateBundleFetcher
 BOOST_AUTO_TEST_SUITE_END() // V2
 BOOST_AUTO_TEST_SUITE_END() // Security
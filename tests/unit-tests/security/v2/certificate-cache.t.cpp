@@ -98,6 +98,42 @@ BOOST_AUTO_TEST_CASE(FindByInterest)
   // TODO cover more cases with different interests
 }
 
+BOOST_AUTO_TEST_CASE(SaveLoad)
+{
+  certCache.insert(cert);
+  advanceClocks(time::seconds(4));
+
+  std::ostringstream os;
+  certCache.save(os);
+  std::string snapshot = os.str();
+
+  CertificateCache restored(time::seconds(10));
+  std::istringstream is(snapshot);
+  BOOST_CHECK_EQUAL(restored.load(is), 1);
+  BOOST_CHECK(restored.find(cert.getName()) != nullptr);
+
+  // already in the cache
+  is.clear();
+  is.str(snapshot);
+  BOOST_CHECK_EQUAL(restored.load(is), 0);
+
+  // removal time is preserved: 10 seconds after the original insertion
+  advanceClocks(time::seconds(7));
+  BOOST_CHECK(restored.find(cert.getName()) == nullptr);
+
+  // expired entries are not loaded
+  is.clear();
+  is.str(snapshot);
+  BOOST_CHECK_EQUAL(restored.load(is), 0);
+  BOOST_CHECK_EQUAL(restored.size(), 0);
+
+  // truncated entries are ignored
+  CertificateCache truncated(time::seconds(10));
+  is.clear();
+  is.str(snapshot.substr(0, snapshot.size() - 1));
+  BOOST_CHECK_EQUAL(truncated.load(is), 0);
+}
+
 BOOST_AUTO_TEST_SUITE_END() // TestCertificateCache
 BOOST_AUTO_TEST_SUITE_END() // V2
 BOOST_AUTO_TEST_SUITE_END() // Security
@@ -21,10 +21,13 @@
 
 #include "security/v2/validator.hpp"
 #include "security/v2/validation-policy-simple-hierarchy.hpp"
+#include "security/v2/verification-pool.hpp"
 
 #include "boost-test.hpp"
 #include "validator-fixture.hpp"
 
+#include <boost/filesystem.hpp>
+
 namespace ndn {
 namespace security {
 namespace v2 {
@@ -158,6 +161,92 @@ BOOST_AUTO_TEST_CASE(UntrustedCertCaching)
   face.sentInterests.clear();
 }
 
+BOOST_AUTO_TEST_CASE(VerifiedCertSnapshot)
+{
+  std::string snapshotFile = (boost::filesystem::path(UNIT_TEST_CONFIG_PATH) /
+                              "TestValidatorSnapshot").string();
+  boost::filesystem::create_directories(UNIT_TEST_CONFIG_PATH);
+  boost::filesystem::remove(snapshotFile);
+
+  Data data("/Security/V2/ValidatorFixture/Sub1/Sub2/Data");
+  m_keyChain.sign(data, signingByIdentity(subIdentity));
+
+  BOOST_CHECK_EQUAL(validator.setVerifiedCertSnapshot(snapshotFile), 0);
+  VALIDATE_SUCCESS(data, "Should get accepted, as signed by the policy-compliant cert");
+  BOOST_CHECK(validator.saveVerifiedCertSnapshot());
+  face.sentInterests.clear();
+
+  processInterest = nullptr; // disable data responses from mocked network
+
+  {
+    Validator restarted(make_unique<ValidationPolicySimpleHierarchy>(),
+                        make_unique<CertificateFetcherFromNetwork>(face));
+    BOOST_CHECK_EQUAL(restarted.setVerifiedCertSnapshot(snapshotFile), 1);
+    BOOST_CHECK_EQUAL(restarted.getVerifiedCertCache().size(), 0);
+    BOOST_CHECK_EQUAL(restarted.getUnverifiedCertCache().size(), 1);
+
+    auto validateRestarted = [&] {
+      bool isValid = false;
+      restarted.validate(data,
+                         [&] (const Data&) { isValid = true; },
+                         [&] (const Data&, const ValidationError&) { isValid = false; });
+      advanceClocks(time::milliseconds(250), 200);
+      return isValid;
+    };
+
+    // snapshot certificates are not trusted without the trust anchor that verified them
+    BOOST_CHECK(!validateRestarted());
+    BOOST_CHECK_EQUAL(restarted.getVerifiedCertCache().size(), 0);
+    face.sentInterests.clear();
+
+    restarted.loadAnchor("", Certificate(identity.getDefaultKey().getDefaultCertificate()));
+    BOOST_CHECK(validateRestarted());
+    BOOST_CHECK_EQUAL(face.sentInterests.size(), 0);
+    BOOST_CHECK_EQUAL(restarted.getVerifiedCertCache().size(), 1);
+  }
+
+  boost::filesystem::remove(snapshotFile);
+}
+
+BOOST_AUTO_TEST_CASE(VerificationPoolThreads)
+{
+  validator.setVerificationPool(make_unique<VerificationPool>(io, 2));
+
+  Data data("/Security/V2/ValidatorFixture/Sub1/Sub2/Data");
+  m_keyChain.sign(data, signingByIdentity(subIdentity));
+  Data badData = data;
+  badData.setContent(reinterpret_cast<const uint8_t*>("bad"), 3);
+  badData.wireEncode();
+
+  size_t nSuccesses = 0;
+  size_t nFailures = 0;
+  auto validateAsync = [&] (const Data& packet) {
+    validator.validate(packet,
+                       [&] (const Data&) { ++nSuccesses; },
+                       [&] (const Data&, const ValidationError&) { ++nFailures; });
+  };
+
+  auto waitForCallbacks = [&] (size_t nExpected) {
+    for (int i = 0; i < 1000 && nSuccesses + nFailures < nExpected; ++i) {
+      advanceClocks(time::milliseconds(1));
+      std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+  };
+
+  validateAsync(data);
+  mockNetworkOperations();
+  waitForCallbacks(1);
+  BOOST_CHECK_EQUAL(nSuccesses, 1);
+
+  validateAsync(data);
+  validateAsync(badData);
+  waitForCallbacks(3);
+  BOOST_CHECK_EQUAL(nSuccesses, 2);
+  BOOST_CHECK_EQUAL(nFailures, 1);
+  // the certificate chain is cached after asynchronous verification
+  BOOST_CHECK_EQUAL(face.sentInterests.size(), 1);
+}
+
 class ValidationPolicySimpleHierarchyForInterestOnly : public ValidationPolicySimpleHierarchy
 {
 public:
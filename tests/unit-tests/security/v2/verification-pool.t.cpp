@@ -0,0 +1,153 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2013-2017 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#include "security/v2/verification-pool.hpp"
+
+#include "boost-test.hpp"
+
+#include <atomic>
+
+namespace ndn {
+namespace security {
+namespace v2 {
+namespace tests {
+
+BOOST_AUTO_TEST_SUITE(Security)
+BOOST_AUTO_TEST_SUITE(V2)
+BOOST_AUTO_TEST_SUITE(TestVerificationPool)
+
+BOOST_AUTO_TEST_CASE(Constructor)
+{
+  boost::asio::io_service io;
+  BOOST_CHECK_THROW(VerificationPool(io, 0), VerificationPool::Error);
+  BOOST_CHECK_THROW(VerificationPool(io, 1, 0), VerificationPool::Error);
+
+  VerificationPool pool(io, 3, 10);
+  BOOST_CHECK_EQUAL(pool.getNThreads(), 3);
+  BOOST_CHECK_EQUAL(pool.getMaxQueueSize(), 10);
+}
+
+BOOST_AUTO_TEST_CASE(CompletionOnIoService)
+{
+  boost::asio::io_service io;
+  VerificationPool pool(io, 2);
+
+  std::atomic<int> nJobs(0);
+  int nCompletions = 0;
+  std::thread::id ioThread = std::this_thread::get_id();
+  for (int i = 0; i < 20; ++i) {
+    BOOST_CHECK(pool.post([&] { ++nJobs; },
+                          [&] {
+                            BOOST_CHECK(std::this_thread::get_id() == ioThread);
+                            ++nCompletions;
+                          },
+                          [] { BOOST_ERROR("unexpected cancellation"); }));
+  }
+
+  // pending jobs keep the io_service busy until every completion handler has run
+  io.run();
+  BOOST_CHECK_EQUAL(nJobs, 20);
+  BOOST_CHECK_EQUAL(nCompletions, 20);
+}
+
+BOOST_AUTO_TEST_CASE(QueueFull)
+{
+  boost::asio::io_service io;
+  VerificationPool pool(io, 1, 1);
+
+  std::mutex mutex;
+  std::unique_lock<std::mutex> lock(mutex);
+  std::atomic<bool> isStarted(false);
+  int nCompletions = 0;
+
+  // the worker is blocked in the first job, the second one fills the queue
+  BOOST_CHECK(pool.post([&] { isStarted = true; std::lock_guard<std::mutex> l(mutex); },
+                        [&] { ++nCompletions; }, [] {}));
+  while (!isStarted) {
+    std::this_thread::yield();
+  }
+  BOOST_CHECK(pool.post([] {}, [&] { ++nCompletions; }, [] {}));
+  BOOST_CHECK(!pool.post([] {}, [&] { ++nCompletions; }, [] {}));
+
+  lock.unlock();
+  io.run();
+  BOOST_CHECK_EQUAL(nCompletions, 2);
+}
+
+BOOST_AUTO_TEST_CASE(DestroyBeforeCompletion)
+{
+  boost::asio::io_service io;
+  int nCompletions = 0;
+  int nCancellations = 0;
+  auto captured = make_shared<int>();
+  {
+    VerificationPool pool(io, 1);
+    std::atomic<bool> isDone(false);
+    BOOST_CHECK(pool.post([&isDone, captured] { isDone = true; },
+                          [&nCompletions, captured] { ++nCompletions; },
+                          [&nCancellations, captured] { ++nCancellations; }));
+    while (!isDone) {
+      std::this_thread::yield();
+    }
+  }
+
+  io.run();
+  BOOST_CHECK_EQUAL(nCompletions, 0);
+  BOOST_CHECK_EQUAL(nCancellations, 1);
+  // the job and both handlers have been released
+  BOOST_CHECK_EQUAL(captured.use_count(), 1);
+}
+
+BOOST_AUTO_TEST_CASE(DestroyBeforeStart)
+{
+  boost::asio::io_service io;
+  std::mutex mutex;
+  int nCompletions = 0;
+  int nCancellations = 0;
+  {
+    VerificationPool pool(io, 1);
+
+    std::unique_lock<std::mutex> lock(mutex);
+    std::atomic<bool> isStarted(false);
+    BOOST_CHECK(pool.post([&] { isStarted = true; std::lock_guard<std::mutex> l(mutex); },
+                          [&] { ++nCompletions; }, [&] { ++nCancellations; }));
+    while (!isStarted) {
+      std::this_thread::yield();
+    }
+
+    // queued behind the blocked job
+    BOOST_CHECK(pool.post([] {}, [&] { ++nCompletions; }, [&] { ++nCancellations; }));
+    lock.unlock();
+  }
+
+  io.run();
+  BOOST_CHECK_EQUAL(nCompletions, 0);
+  BOOST_CHECK_EQUAL(nCancellations, 2);
+}
+
+BOOST_AUTO_TEST_SUITE_END() // TestVerificationPool
+BOOST_AUTO_TEST_SUITE_END() // V2
+BOOST_AUTO_TEST_SUITE_END() // Security
+
+} // namespace tests
+} // namespace v2
+} // namespace security
+} // namespace ndn
@@ -655,6 +655,60 @@ BOOST_AUTO_TEST_CASE(Reset)
   BOOST_CHECK(validator.isEmpty());
 }
 
+BOOST_AUTO_TEST_CASE(Reload)
+{
+  Name certName = addIdentity("/TestValidatorConfig/ReloadAnchors");
+  BOOST_REQUIRE(saveIdentityCertificate(certName, "trust-anchor-reload.cert"));
+
+  std::string CONFIG =
+    "rule\n"
+    "{\n"
+    "  id \"Simple Rule\"\n"
+    "  for data\n"
+    "  checker\n"
+    "  {\n"
+    "    type hierarchical\n"
+    "    sig-type rsa-sha256\n"
+    "  }\n"
+    "}\n"
+    "trust-anchor\n"
+    "{\n"
+    "  type file\n"
+    "  file-name \"trust-anchor-reload.cert\"\n"
+    "}\n";
+
+  const boost::filesystem::path CONFIG_PATH =
+    (boost::filesystem::current_path() / std::string("unit-test-nfd.conf"));
+
+  validator.load(CONFIG, CONFIG_PATH.c_str());
+  BOOST_REQUIRE_EQUAL(validator.m_anchors.size(), 1);
+  auto anchor = validator.m_anchors.begin()->second;
+
+  // unchanged anchor files are not decoded again
+  validator.load(CONFIG, CONFIG_PATH.c_str());
+  BOOST_REQUIRE_EQUAL(validator.m_anchors.size(), 1);
+  BOOST_CHECK_EQUAL(validator.m_anchors.begin()->second, anchor);
+  BOOST_CHECK_EQUAL(validator.m_anchorFileCache.size(), 1);
+
+  // a rewritten anchor file is decoded again, regardless of its modification time
+  Name otherCertName = addIdentity("/TestValidatorConfig/ReloadAnchors2");
+  BOOST_REQUIRE(saveIdentityCertificate(otherCertName, "trust-anchor-reload.cert"));
+  validator.load(CONFIG, CONFIG_PATH.c_str());
+  BOOST_REQUIRE_EQUAL(validator.m_anchors.size(), 1);
+  BOOST_CHECK_EQUAL(validator.m_anchors.begin()->second->getName(), otherCertName);
+  BOOST_CHECK_EQUAL(validator.m_anchorFileCache.size(), 1);
+
+  // a configuration that fails to load leaves the previous one in effect
+  std::string BAD_CONFIG = CONFIG + "unknown-section\n{\n}\n";
+  BOOST_CHECK_THROW(validator.load(BAD_CONFIG, CONFIG_PATH.c_str()), security::conf::Error);
+  BOOST_CHECK_EQUAL(validator.m_dataRules.size(), 1);
+  BOOST_CHECK_EQUAL(validator.m_dataRuleIndex.size(), 1);
+  BOOST_CHECK_EQUAL(validator.m_anchors.size(), 1);
+
+  BOOST_CHECK_THROW(validator.load("", CONFIG_PATH.c_str()), security::conf::Error);
+  BOOST_CHECK_EQUAL(validator.m_dataRules.size(), 1);
+}
+
 BOOST_AUTO_TEST_CASE(TrustAnchorWildcard)
 {
   Name identity("/TestValidatorConfig/Wildcard");
@@ -469,6 +469,59 @@ BOOST_AUTO_TEST_CASE_TEMPLATE(VerifySignature, Dataset, SignatureDatasets)
   // - pib::Key version is tested as part of v2/key-chain.t.cpp (Security/V2/TestKeyChain)
 }
 
+BOOST_AUTO_TEST_CASE(VerifySignatures)
+{
+  EcdsaDataset ecdsa;
+  RsaDataset rsa;
+  v2::Certificate ecdsaCert(Block(ecdsa.cert.data(), ecdsa.cert.size()));
+  v2::Certificate rsaCert(Block(rsa.cert.data(), rsa.cert.size()));
+  Data ecdsaData(Block(ecdsa.goodData.data(), ecdsa.goodData.size()));
+  Data ecdsaBadSigData(Block(ecdsa.badSigData.data(), ecdsa.badSigData.size()));
+  Data rsaData(Block(rsa.goodData.data(), rsa.goodData.size()));
+  Interest ecdsaInterest(Block(ecdsa.goodInterest.data(), ecdsa.goodInterest.size()));
+  Interest rsaInterest(Block(rsa.goodInterest.data(), rsa.goodInterest.size()));
+  Interest rsaBadSigInterest(Block(rsa.badSigInterest.data(), rsa.badSigInterest.size()));
+  Data unsignedData("/some/data");
+
+  // the invalid key must not affect other items
+  v2::Certificate invalidCert(ecdsaCert);
+  uint8_t invalidKey[] = {0x00, 0x00};
+  invalidCert.setContent(invalidKey, sizeof(invalidKey));
+
+  std::vector<std::pair<const Data*, const v2::Certificate*>> data = {
+    {&ecdsaData, &ecdsaCert},
+    {&rsaData, &rsaCert},
+    {&ecdsaBadSigData, &ecdsaCert},
+    {&rsaData, &ecdsaCert},
+    {&ecdsaData, &ecdsaCert},
+    {&unsignedData, &rsaCert},
+    {&ecdsaData, &invalidCert},
+    {&rsaData, &rsaCert}
+  };
+  std::vector<bool> expectedData = {true, true, false, false, true, false, false, true};
+
+  for (size_t nThreads : {0, 1, 3, 16}) {
+    BOOST_TEST_MESSAGE("nThreads=" << nThreads);
+    std::vector<bool> results = verifySignatures(data, nThreads);
+    BOOST_CHECK_EQUAL_COLLECTIONS(results.begin(), results.end(),
+                                  expectedData.begin(), expectedData.end());
+  }
+
+  std::vector<std::pair<const Interest*, const v2::Certificate*>> interests = {
+    {&rsaInterest, &rsaCert},
+    {&ecdsaInterest, &ecdsaCert},
+    {&rsaBadSigInterest, &rsaCert},
+    {&ecdsaInterest, &rsaCert}
+  };
+  std::vector<bool> expectedInterests = {true, true, false, false};
+
+  std::vector<bool> results = verifySignatures(interests, 2);
+  BOOST_CHECK_EQUAL_COLLECTIONS(results.begin(), results.end(),
+                                expectedInterests.begin(), expectedInterests.end());
+
+  BOOST_CHECK(verifySignatures(std::vector<std::pair<const Data*, const v2::Certificate*>>()).empty());
+}
+
 typedef boost::mpl::list<Sha256Dataset> DigestDatasets;
 
 BOOST_AUTO_TEST_CASE_TEMPLATE(VerifyDigest, Dataset, DigestDatasets)
@@ -0,0 +1,171 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2013-2017 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#include "transport/shm-ring.hpp"
+#include "encoding/block-helpers.hpp"
+
+#include "boost-test.hpp"
+
+#include <thread>
+
+namespace ndn {
+namespace tests {
+
+class ShmRingFixture
+{
+protected:
+  explicit
+  ShmRingFixture(size_t capacity = 65536)
+    : m_memory(ShmRing::getRegionSize(capacity) + 64)
+    , region(reinterpret_cast<void*>((reinterpret_cast<uintptr_t>(m_memory.data()) + 63) &
+                                     ~uintptr_t(63)))
+    , producer(region, capacity, true)
+    , consumer(region, capacity, false)
+  {
+  }
+
+  static Block
+  makeBlock(uint32_t type, size_t size, uint8_t fill)
+  {
+    std::vector<uint8_t> value(size, fill);
+    return makeBinaryBlock(type, value.data(), value.size());
+  }
+
+private:
+  std::vector<uint8_t> m_memory;
+
+protected:
+  void* region;
+  ShmRing producer;
+  ShmRing consumer;
+};
+
+BOOST_AUTO_TEST_SUITE(Transport)
+BOOST_FIXTURE_TEST_SUITE(TestShmRing, ShmRingFixture)
+
+BOOST_AUTO_TEST_CASE(InvalidCapacity)
+{
+  BOOST_CHECK_THROW(ShmRing(region, 65535, true), ShmRing::Error);
+  BOOST_CHECK_THROW(ShmRing(region, 1024, true), ShmRing::Error);
+  BOOST_CHECK_THROW(ShmRing(region, 131072, false), ShmRing::Error); // capacity mismatch
+}
+
+BOOST_AUTO_TEST_CASE(PushPop)
+{
+  Block block;
+  BOOST_CHECK_EQUAL(consumer.pop(block), false);
+
+  Block b1 = makeBlock(0x05, 10, 0xA1);
+  Block b2 = makeBlock(0x06, 3000, 0xB2);
+  BOOST_CHECK(producer.push(b1) == ShmRing::PushResult::PUSHED_TO_EMPTY);
+  BOOST_CHECK(producer.push(b2) == ShmRing::PushResult::PUSHED);
+
+  BOOST_REQUIRE(consumer.pop(block));
+  BOOST_CHECK(block == b1);
+  BOOST_REQUIRE(consumer.pop(block));
+  BOOST_CHECK(block == b2);
+  BOOST_CHECK_EQUAL(consumer.pop(block), false);
+
+  // once the ring is drained, the next push must wake up the consumer again
+  BOOST_CHECK(producer.push(b1) == ShmRing::PushResult::PUSHED_TO_EMPTY);
+}
+
+BOOST_AUTO_TEST_CASE(PushTwoParts)
+{
+  Block payload = makeBlock(0x05, 100, 0xC3);
+  Block packet = makeBinaryBlock(0x64, payload.wire(), payload.size());
+  Block header(packet, packet.begin(), packet.value_begin(), false);
+  BOOST_CHECK(producer.push(header, payload) == ShmRing::PushResult::PUSHED_TO_EMPTY);
+
+  Block block;
+  BOOST_REQUIRE(consumer.pop(block));
+  BOOST_CHECK(block == packet);
+}
+
+BOOST_AUTO_TEST_CASE(TooLarge)
+{
+  BOOST_CHECK_THROW(producer.push(makeBlock(0x05, MAX_NDN_PACKET_SIZE, 0)), ShmRing::Error);
+}
+
+BOOST_AUTO_TEST_CASE(FullAndWrapAround)
+{
+  Block big = makeBlock(0x06, 8000, 0xD4);
+  size_t nPushed = 0;
+  while (producer.push(big) != ShmRing::PushResult::FULL) {
+    ++nPushed;
+  }
+  BOOST_CHECK_EQUAL(nPushed, 65536 / 8008);
+  BOOST_CHECK_EQUAL(consumer.takeProducerBlocked(), true);
+  BOOST_CHECK_EQUAL(consumer.takeProducerBlocked(), false);
+
+  // records of varying sizes cross the end of the data area many times
+  Block block;
+  size_t nPopped = 0;
+  for (size_t i = 0; i < 1000; ++i) {
+    Block b = makeBlock(0x07, 1 + (i * 7919) % 6000, static_cast<uint8_t>(i));
+    while (producer.push(b) == ShmRing::PushResult::FULL) {
+      BOOST_REQUIRE(consumer.pop(block));
+      ++nPopped;
+    }
+  }
+  while (consumer.pop(block)) {
+    ++nPopped;
+  }
+  BOOST_CHECK_EQUAL(nPopped, nPushed + 1000);
+  BOOST_CHECK_EQUAL(block.type(), 0x07);
+  BOOST_CHECK_EQUAL(block.value_size(), 1 + (999 * 7919) % 6000);
+}
+
+BOOST_AUTO_TEST_CASE(Threads)
+{
+  const size_t N_BLOCKS = 100000;
+
+  std::thread producerThread([this, N_BLOCKS] {
+    for (size_t i = 0; i < N_BLOCKS; ++i) {
+      Block b = makeNonNegativeIntegerBlock(0x08, i);
+      while (producer.push(b) == ShmRing::PushResult::FULL) {
+        std::this_thread::yield();
+      }
+    }
+  });
+
+  size_t nextValue = 0;
+  bool isInOrder = true;
+  Block block;
+  while (nextValue < N_BLOCKS) {
+    if (!consumer.pop(block)) {
+      std::this_thread::yield();
+      continue;
+    }
+    isInOrder = isInOrder && readNonNegativeInteger(block) == nextValue;
+    ++nextValue;
+  }
+  producerThread.join();
+
+  BOOST_CHECK(isInOrder);
+  BOOST_CHECK_EQUAL(consumer.pop(block), false);
+}
+
+BOOST_AUTO_TEST_SUITE_END() // TestShmRing
+BOOST_AUTO_TEST_SUITE_END() // Transport
+
+} // namespace tests
+} // namespace ndn
@@ -0,0 +1,278 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2013-2017 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#include "transport/shm-transport.hpp"
+#include "encoding/block-helpers.hpp"
+#include "transport-fixture.hpp"
+
+#include "boost-test.hpp"
+
+#include <boost/asio.hpp>
+#include <boost/filesystem.hpp>
+
+#include <atomic>
+#include <thread>
+
+#include <poll.h>
+#include <unistd.h>
+
+namespace ndn {
+namespace tests {
+
+using boost::asio::local::stream_protocol;
+
+/** \brief forwarder stand-in that echoes every block it receives
+ */
+class EchoServer
+{
+public:
+  EchoServer(const std::string& path, bool supportsShm)
+    : m_acceptor(m_io, stream_protocol::endpoint(path))
+    , m_shouldStop(false)
+  {
+    m_thread = std::thread([this, supportsShm] {
+      stream_protocol::socket socket(m_io);
+      m_acceptor.accept(socket);
+      if (supportsShm) {
+        this->runShm(socket);
+      }
+      else {
+        this->runStream(socket);
+      }
+    });
+  }
+
+  ~EchoServer()
+  {
+    m_shouldStop = true;
+    m_thread.join();
+  }
+
+private:
+  void
+  runShm(stream_protocol::socket& socket)
+  {
+    unique_ptr<ShmChannel> channel = ShmChannel::receiveRequest(socket.native_handle());
+    Block accept = makeEmptyBlock(ShmChannel::TLV_ACCEPT);
+    boost::asio::write(socket, boost::asio::buffer(accept.wire(), accept.size()));
+
+    pollfd pfd;
+    pfd.fd = channel->getWakeupFd();
+    pfd.events = POLLIN;
+    while (!m_shouldStop) {
+      if (::poll(&pfd, 1, 10) > 0) {
+        uint64_t value = 0;
+        BOOST_VERIFY(::read(pfd.fd, &value, sizeof(value)) == sizeof(value));
+      }
+
+      Block block;
+      while (channel->getReceiveRing().pop(block)) {
+        ShmRing::PushResult result;
+        while ((result = channel->getSendRing().push(block)) == ShmRing::PushResult::FULL) {
+          std::this_thread::yield();
+        }
+        if (result == ShmRing::PushResult::PUSHED_TO_EMPTY) {
+          channel->notifyPeer();
+        }
+      }
+      if (channel->getReceiveRing().takeProducerBlocked()) {
+        channel->notifyPeer();
+      }
+    }
+  }
+
+  void
+  runStream(stream_protocol::socket& socket)
+  {
+    // discard the offer like a forwarder that does not recognize it
+    uint8_t offer[4];
+    boost::asio::read(socket, boost::asio::buffer(offer));
+
+    uint8_t buffer[MAX_NDN_PACKET_SIZE];
+    boost::system::error_code error;
+    for (;;) {
+      size_t nRead = socket.read_some(boost::asio::buffer(buffer), error);
+      if (error) {
+        return;
+      }
+      boost::asio::write(socket, boost::asio::buffer(buffer, nRead));
+    }
+  }
+
+private:
+  boost::asio::io_service m_io;
+  stream_protocol::acceptor m_acceptor;
+  std::atomic<bool> m_shouldStop;
+  std::thread m_thread;
+};
+
+class ShmTransportFixture : public TransportFixture
+{
+protected:
+  ShmTransportFixture()
+    : socketPath((boost::filesystem::temp_directory_path() /
+                  boost::filesystem::unique_path("ndn-cxx-shm-test-%%%%-%%%%.sock")).string())
+  {
+  }
+
+  ~ShmTransportFixture()
+  {
+    boost::filesystem::remove(socketPath);
+  }
+
+  /** \brief poll the io_service until \p predicate is true or 5 seconds have passed
+   */
+  template<typename Predicate>
+  bool
+  pollUntil(const Predicate& predicate)
+  {
+    for (int i = 0; i < 5000; ++i) {
+      if (io.stopped()) {
+        io.reset();
+      }
+      io.poll();
+      if (predicate()) {
+        return true;
+      }
+      std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    return false;
+  }
+
+  /** \brief send \p nBlocks blocks and check that they are echoed in order
+   */
+  void
+  checkEcho(ShmTransport& transport, const std::vector<Block>& received, size_t nBlocks)
+  {
+    // the acceptance of the offer is counted as a received packet
+    uint64_t nInPacketsBefore = transport.getCounters().nInPackets;
+    for (size_t i = 0; i < nBlocks; ++i) {
+      transport.send(makeNonNegativeIntegerBlock(0x80, i));
+    }
+    BOOST_REQUIRE(pollUntil([&] { return received.size() == nBlocks; }));
+
+    for (size_t i = 0; i < nBlocks; ++i) {
+      BOOST_CHECK_EQUAL(readNonNegativeInteger(received[i]), i);
+    }
+    BOOST_CHECK_EQUAL(transport.getCounters().nOutPackets, nBlocks);
+    BOOST_CHECK_EQUAL(transport.getCounters().nInPackets - nInPacketsBefore, nBlocks);
+  }
+
+protected:
+  std::string socketPath;
+  boost::asio::io_service io;
+};
+
+BOOST_AUTO_TEST_SUITE(Transport)
+BOOST_FIXTURE_TEST_SUITE(TestShmTransport, ShmTransportFixture)
+
+using ndn::Transport;
+
+BOOST_AUTO_TEST_CASE(GetDefaultSocketNameOk)
+{
+  BOOST_CHECK_EQUAL(ShmTransport::getSocketNameFromUri("shm:///tmp/test/nfd.sock"), "/tmp/test/nfd.sock");
+  BOOST_CHECK_EQUAL(ShmTransport::getSocketNameFromUri(""), "/var/run/nfd.sock");
+}
+
+BOOST_AUTO_TEST_CASE(GetDefaultSocketNameBadWrongTransport)
+{
+  BOOST_CHECK_EXCEPTION(ShmTransport::getSocketNameFromUri("unix:///tmp/test/nfd.sock"),
+                        Transport::Error,
+                        [] (const Transport::Error& error) {
+                          return error.what() == std::string("Cannot create ShmTransport "
+                                                             "from \"unix\" URI");
+                        });
+}
+
+BOOST_AUTO_TEST_CASE(ConnectFailure)
+{
+  ShmTransport transport(socketPath);
+  BOOST_CHECK_THROW(transport.connect(io, [] (const Block&) {}), Transport::Error);
+  BOOST_CHECK_EQUAL(transport.isConnected(), false);
+}
+
+#ifdef NDN_CXX_HAVE_EVENTFD
+BOOST_AUTO_TEST_CASE(SharedMemory)
+{
+  EchoServer server(socketPath, true);
+
+  std::vector<Block> received;
+  ShmTransport transport(socketPath);
+  transport.connect(io, [&received] (const Block& block) { received.push_back(block); });
+  transport.resume();
+  BOOST_CHECK(transport.isConnected());
+  BOOST_REQUIRE(pollUntil([&] { return transport.isShmActive(); }));
+
+  // more blocks than a ring can hold, so that both sides have to wait for space
+  checkEcho(transport, received, 20000);
+
+  transport.close();
+  BOOST_CHECK_EQUAL(transport.isShmActive(), false);
+}
+#endif // NDN_CXX_HAVE_EVENTFD
+
+BOOST_AUTO_TEST_CASE(Fallback)
+{
+  EchoServer server(socketPath, false);
+
+  std::vector<Block> received;
+  ShmTransport transport(socketPath);
+  transport.connect(io, [&received] (const Block& block) { received.push_back(block); });
+  transport.resume();
+
+  checkEcho(transport, received, 100);
+  BOOST_CHECK_EQUAL(transport.isShmActive(), false);
+
+  transport.close();
+}
+
+BOOST_AUTO_TEST_CASE(FallbackBatch)
+{
+  EchoServer server(socketPath, false);
+
+  std::vector<Block> received;
+  ShmTransport transport(socketPath);
+  transport.connect(io, [&received] (const Block& block) { received.push_back(block); });
+  transport.resume();
+
+  std::vector<Block> blocks;
+  for (size_t i = 0; i < 100; ++i) {
+    blocks.push_back(makeNonNegativeIntegerBlock(0x80, i));
+  }
+  transport.sendBatch(blocks);
+  transport.send(makeNonNegativeIntegerBlock(0x80, blocks.size()));
+  BOOST_REQUIRE(pollUntil([&] { return received.size() == blocks.size() + 1; }));
+
+  for (size_t i = 0; i < received.size(); ++i) {
+    BOOST_CHECK_EQUAL(readNonNegativeInteger(received[i]), i);
+  }
+  BOOST_CHECK_EQUAL(transport.getCounters().nOutPackets, blocks.size() + 1);
+  BOOST_CHECK_EQUAL(transport.getCounters().nQueuedPackets, 0);
+  BOOST_CHECK_EQUAL(transport.getCounters().nQueuedBytes, 0);
+
+  transport.close();
+}
+
+BOOST_AUTO_TEST_SUITE_END() // TestShmTransport
+BOOST_AUTO_TEST_SUITE_END() // Transport
+
+} // namespace tests
+} // namespace ndn
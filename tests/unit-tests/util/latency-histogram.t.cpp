@@ -0,0 +1,92 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2013-2017 Regents of the University of California.
+ *
+ * This file is part of ndn-cxx library (NDN C++ library with eXperimental eXtensions).
+ *
+ * ndn-cxx library is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU Lesser General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later version.
+ *
+ * ndn-cxx library is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+ * PARTICULAR PURPOSE.  See the GNU Lesser General Public License for more details.
+ *
+ * You should have received copies of the GNU General Public License and GNU Lesser
+ * General Public License along with ndn-cxx, e.g., in COPYING.md file.  If not, see
+ * <http://www.gnu.org/licenses/>.
+ *
+ * See AUTHORS.md for complete list of ndn-cxx authors and contributors.
+ */
+
+#include "util/latency-histogram.hpp"
+
+#include "boost-test.hpp"
+
+namespace ndn {
+namespace util {
+namespace tests {
+
+BOOST_AUTO_TEST_SUITE(Util)
+BOOST_AUTO_TEST_SUITE(TestLatencyHistogram)
+
+BOOST_AUTO_TEST_CASE(BucketIndex)
+{
+  // every bucket covers the values from the previous upper bound to its own upper bound
+  uint64_t lowerBound = 0;
+  for (size_t i = 0; i < LatencyHistogram::N_BUCKETS; ++i) {
+    uint64_t upperBound = LatencyHistogram::getBucketUpperBound(i).count();
+    BOOST_REQUIRE_LT(lowerBound, upperBound);
+    BOOST_CHECK_EQUAL(LatencyHistogram::getBucketIndex(lowerBound), i);
+    BOOST_CHECK_EQUAL(LatencyHistogram::getBucketIndex(upperBound - 1), i);
+    // relative width of a bucket is bounded
+    BOOST_CHECK_LE((upperBound - lowerBound) * LatencyHistogram::SUB_BUCKETS,
+                   std::max<uint64_t>(lowerBound, LatencyHistogram::SUB_BUCKETS));
+    lowerBound = upperBound;
+  }
+  BOOST_CHECK_EQUAL(lowerBound, uint64_t(1) << LatencyHistogram::MAX_LATENCY_BITS);
+
+  // out of range values go into the last bucket
+  BOOST_CHECK_EQUAL(LatencyHistogram::getBucketIndex(lowerBound), LatencyHistogram::N_BUCKETS - 1);
+  BOOST_CHECK_EQUAL(LatencyHistogram::getBucketIndex(std::numeric_limits<uint64_t>::max()),
+                    LatencyHistogram::N_BUCKETS - 1);
+}
+
+BOOST_AUTO_TEST_CASE(Record)
+{
+  LatencyHistogram histogram;
+  BOOST_CHECK_EQUAL(histogram.getCount(), 0);
+  BOOST_CHECK_EQUAL(histogram.getMean(), time::microseconds::zero());
+  BOOST_CHECK_EQUAL(histogram.getQuantile(0.5), time::microseconds::zero());
+
+  for (int i = 1; i <= 100; ++i) {
+    histogram.record(time::milliseconds(i));
+  }
+  histogram.record(time::nanoseconds(-1));
+
+  BOOST_CHECK_EQUAL(histogram.getCount(), 101);
+  BOOST_CHECK_EQUAL(histogram.getBucketCount(0), 1);
+  BOOST_CHECK_EQUAL(histogram.getMean(), time::microseconds(5050000 / 101));
+
+  // quantiles are reported with at most 1/SUB_BUCKETS relative error
+  auto checkQuantile = [&] (double q, time::microseconds expected) {
+    time::microseconds actual = histogram.getQuantile(q);
+    BOOST_CHECK_GE(actual, expected);
+    BOOST_CHECK_LE(actual, expected + expected / LatencyHistogram::SUB_BUCKETS);
+  };
+  checkQuantile(0.5, time::milliseconds(50));
+  checkQuantile(0.99, time::milliseconds(99));
+  checkQuantile(1.0, time::milliseconds(100));
+  BOOST_CHECK_EQUAL(histogram.getQuantile(0.0), time::microseconds(1));
+
+  histogram.reset();
+  BOOST_CHECK_EQUAL(histogram.getCount(), 0);
+  BOOST_CHECK_EQUAL(histogram.getBucketCount(0), 0);
+}
+
+BOOST_AUTO_TEST_SUITE_END() // TestLatencyHistogram
+BOOST_AUTO_TEST_SUITE_END() // Util
+
+} // namespace tests
+} // namespace util
+} // namespace ndn
@@ -26,6 +26,8 @@
 #include <boost/test/output_test_stream.hpp>
 #include "../unit-test-time-fixture.hpp"
 
+#include <thread>
+
 namespace ndn {
 namespace util {
 namespace tests {
@@ -59,6 +61,19 @@ logFromNewLogger(const std::string& moduleName)
   BOOST_CHECK(Logging::get().removeLogger(logger));
 }
 
+/** \brief a type whose operator<< logs
+ */
+struct LoggingWhenPrinted
+{
+};
+
+std::ostream&
+operator<<(std::ostream& os, const LoggingWhenPrinted&)
+{
+  NDN_LOG_INFO("nested");
+  return os << "printed";
+}
+
 const time::system_clock::Duration LOG_SYSTIME = time::microseconds(1468108800311239LL);
 const std::string LOG_SYSTIME_STR = "1468108800.311239";
 
@@ -428,6 +443,85 @@ BOOST_AUTO_TEST_CASE(ChangeDestination)
   BOOST_CHECK(os2weak.expired());
 }
 
+BOOST_AUTO_TEST_CASE(BinaryBackend)
+{
+  Logging::setDestination(shared_ptr<std::ostream>(&os, bind([]{})), Logging::Backend::BINARY);
+  BOOST_CHECK(BinaryLogBackend::isInstalled());
+
+  Logging::setLevel("Module1", LogLevel::ALL);
+  logFromModule1();
+
+  Logging::flush();
+  BOOST_CHECK(os.is_equal(
+    LOG_SYSTIME_STR + " TRACE: [Module1] trace1\n" +
+    LOG_SYSTIME_STR + " DEBUG: [Module1] debug1\n" +
+    LOG_SYSTIME_STR + " INFO: [Module1] info1\n" +
+    LOG_SYSTIME_STR + " WARNING: [Module1] warn1\n" +
+    LOG_SYSTIME_STR + " ERROR: [Module1] error1\n" +
+    LOG_SYSTIME_STR + " FATAL: [Module1] fatal1\n"
+    ));
+
+  // each thread has its own ring buffer
+  std::thread thread(&logFromModule2);
+  thread.join();
+  Logging::flush();
+  BOOST_CHECK(os.is_equal(
+    LOG_SYSTIME_STR + " FATAL: [Module2] fatal2\n"
+    ));
+
+  // single-argument setDestination keeps the backend
+  auto os2 = make_shared<output_test_stream>();
+  Logging::setDestination(os2);
+  BOOST_CHECK(BinaryLogBackend::isInstalled());
+  logFromModule2();
+  Logging::flush();
+  BOOST_CHECK(os.is_empty());
+  BOOST_CHECK(os2->is_equal(
+    LOG_SYSTIME_STR + " FATAL: [Module2] fatal2\n"
+    ));
+
+  Logging::setDestination(shared_ptr<std::ostream>(&os, bind([]{})), Logging::Backend::BOOST_LOG);
+  BOOST_CHECK(!BinaryLogBackend::isInstalled());
+  logFromModule2();
+  Logging::flush();
+  BOOST_CHECK(os.is_equal(
+    LOG_SYSTIME_STR + " FATAL: [Module2] fatal2\n"
+    ));
+}
+
+BOOST_AUTO_TEST_CASE(BinaryBackendNestedRecord)
+{
+  Logging::setDestination(shared_ptr<std::ostream>(&os, bind([]{})), Logging::Backend::BINARY);
+  Logging::setLevel("ndn.util.tests.Logging", LogLevel::ALL);
+
+  NDN_LOG_INFO("outer " << LoggingWhenPrinted() << " end");
+
+  Logging::flush();
+  BOOST_CHECK(os.is_equal(
+    LOG_SYSTIME_STR + " INFO: [ndn.util.tests.Logging] nested\n" +
+    LOG_SYSTIME_STR + " INFO: [ndn.util.tests.Logging] outer printed end\n"
+    ));
+
+  Logging::setDestination(shared_ptr<std::ostream>(&os, bind([]{})), Logging::Backend::BOOST_LOG);
+}
+
+BOOST_AUTO_TEST_CASE(BinaryBackendDestroyed)
+{
+  auto backend = make_shared<BinaryLogBackend>(make_shared<std::ostringstream>());
+  BinaryLogBackend::install(backend);
+  BOOST_CHECK(BinaryLogBackend::isInstalled());
+
+  backend.reset();
+  BOOST_CHECK(!BinaryLogBackend::isInstalled());
+
+  // records go to the Boost.Log backend again
+  logFromModule1();
+  Logging::flush();
+  BOOST_CHECK(os.is_equal(
+    LOG_SYSTIME_STR + " FATAL: [Module1] fatal1\n"
+    ));
+}
+
 BOOST_AUTO_TEST_SUITE_END() // TestLogging
 BOOST_AUTO_TEST_SUITE_END() // Util
 
@@ -311,6 +311,73 @@ BOOST_AUTO_TEST_CASE(PayloadError)
   BOOST_CHECK(this->hasInitialRequest());
 }
 
+BOOST_AUTO_TEST_CASE(Pipelined)
+{
+  BOOST_CHECK_THROW(subscriber.setWindowSize(0), std::invalid_argument);
+  subscriber.setWindowSize(4);
+  subscriber.setCatchUpLifetime(time::milliseconds(200));
+
+  std::vector<std::string> messages;
+  std::vector<uint64_t> gaps;
+  subscriber.onNotification.connect([&messages] (const SimpleNotification& notification) {
+    messages.push_back(notification.getMessage());
+  });
+  subscriber.onGap.connect([&gaps] (uint64_t sequenceNo) { gaps.push_back(sequenceNo); });
+
+  subscriber.start();
+  advanceClocks(time::milliseconds(1));
+  BOOST_CHECK(this->hasInitialRequest());
+
+  // respond to initial request, then the next four sequence numbers are requested
+  subscriberFace.sentInterests.clear();
+  nextSendNotificationNo = 10;
+  this->deliverNotification("n10");
+  advanceClocks(time::milliseconds(1));
+  BOOST_CHECK_EQUAL(messages.size(), 1);
+  BOOST_REQUIRE_EQUAL(subscriberFace.sentInterests.size(), 4);
+  for (size_t i = 0; i < 4; ++i) {
+    const Interest& interest = subscriberFace.sentInterests[i];
+    BOOST_CHECK_EQUAL(interest.getName()[-1].toSequenceNumber(), 11 + i);
+    BOOST_CHECK_EQUAL(interest.getInterestLifetime(), subscriber.getInterestLifetime());
+  }
+
+  // n12 is held back until n11 is either received or given up,
+  // and n11 is requested again with catch-up lifetime
+  subscriberFace.sentInterests.clear();
+  nextSendNotificationNo = 12;
+  this->deliverNotification("n12");
+  advanceClocks(time::milliseconds(1));
+  BOOST_CHECK_EQUAL(messages.size(), 1);
+  BOOST_REQUIRE_EQUAL(subscriberFace.sentInterests.size(), 1);
+  BOOST_CHECK_EQUAL(subscriberFace.sentInterests[0].getName()[-1].toSequenceNumber(), 11);
+  BOOST_CHECK_EQUAL(subscriberFace.sentInterests[0].getInterestLifetime(),
+                    time::milliseconds(200));
+
+  // n11 cannot be retrieved
+  subscriberFace.sentInterests.clear();
+  advanceClocks(time::milliseconds(10), 21);
+  BOOST_REQUIRE_EQUAL(gaps.size(), 1);
+  BOOST_CHECK_EQUAL(gaps[0], 11);
+  BOOST_REQUIRE_EQUAL(messages.size(), 2);
+  BOOST_CHECK_EQUAL(messages[1], "n12");
+  BOOST_REQUIRE_EQUAL(subscriberFace.sentInterests.size(), 2);
+  BOOST_CHECK_EQUAL(subscriberFace.sentInterests[0].getName()[-1].toSequenceNumber(), 15);
+  BOOST_CHECK_EQUAL(subscriberFace.sentInterests[1].getName()[-1].toSequenceNumber(), 16);
+
+  // in-order notifications are delivered immediately
+  this->deliverNotification("n13");
+  this->deliverNotification("n14");
+  advanceClocks(time::milliseconds(1));
+  BOOST_REQUIRE_EQUAL(messages.size(), 4);
+  BOOST_CHECK_EQUAL(messages[2], "n13");
+  BOOST_CHECK_EQUAL(messages[3], "n14");
+  BOOST_CHECK_EQUAL(gaps.size(), 1);
+
+  subscriber.stop();
+  advanceClocks(time::milliseconds(1));
+  BOOST_CHECK_EQUAL(subscriberFace.getNPendingInterests(), 0);
+}
+
 BOOST_AUTO_TEST_SUITE_END() // TestNotificationSubscriber
 BOOST_AUTO_TEST_SUITE_END() // Util
 
@@ -252,6 +252,53 @@ BOOST_FIXTURE_TEST_CASE(Triple, Fixture)
   }
 }
 
+BOOST_FIXTURE_TEST_CASE(Each, Fixture)
+{
+  std::vector<Block> segments;
+  ValidatorNull nullValidator;
+  SegmentFetcher::fetchEach(face, Interest("/hello/world", time::seconds(1000)),
+                            nullValidator,
+                            [&segments] (const Block& content) {
+                              segments.push_back(content);
+                              return true;
+                            },
+                            [this] { ++nData; },
+                            bind(&Fixture::onError, this, _1));
+
+  advanceClocks(time::milliseconds(10));
+  face.receive(*makeDataSegment("/hello/world/version0", 0, false));
+  advanceClocks(time::milliseconds(10));
+  BOOST_CHECK_EQUAL(segments.size(), 1);
+  BOOST_CHECK_EQUAL(nData, 0);
+
+  face.receive(*makeDataSegment("/hello/world/version0", 1, true));
+  advanceClocks(time::milliseconds(10));
+
+  BOOST_CHECK_EQUAL(nErrors, 0);
+  BOOST_CHECK_EQUAL(nData, 1);
+  BOOST_REQUIRE_EQUAL(segments.size(), 2);
+  BOOST_CHECK_EQUAL(segments[1].value_size(), 14);
+  BOOST_CHECK_EQUAL(face.sentInterests.size(), 2);
+}
+
+BOOST_FIXTURE_TEST_CASE(EachStop, Fixture)
+{
+  ValidatorNull nullValidator;
+  SegmentFetcher::fetchEach(face, Interest("/hello/world", time::seconds(1000)),
+                            nullValidator,
+                            [] (const Block&) { return false; },
+                            [this] { ++nData; },
+                            bind(&Fixture::onError, this, _1));
+
+  advanceClocks(time::milliseconds(10));
+  face.receive(*makeDataSegment("/hello/world/version0", 0, false));
+  advanceClocks(time::milliseconds(10));
+
+  BOOST_CHECK_EQUAL(nErrors, 0);
+  BOOST_CHECK_EQUAL(nData, 0);
+  BOOST_CHECK_EQUAL(face.sentInterests.size(), 1);
+}
+
 BOOST_FIXTURE_TEST_CASE(TripleWithInitialSegmentFetching, Fixture)
 {
   ValidatorNull nullValidator;
@@ -151,6 +151,43 @@ BOOST_AUTO_TEST_CASE(Basic)
   }
 }
 
+BOOST_AUTO_TEST_CASE(Cache)
+{
+  Sqlite3Statement(db, "CREATE TABLE test (t1 int)").step();
+
+  Sqlite3StatementCache cache(db);
+  BOOST_CHECK_EQUAL(cache.getDatabase(), db);
+  for (int i = 0; i < 3; ++i) {
+    Sqlite3Statement stmt(cache, "INSERT INTO test VALUES (?)");
+    stmt.bind(1, i);
+    BOOST_CHECK_EQUAL(stmt.step(), SQLITE_DONE);
+  }
+  BOOST_CHECK_EQUAL(cache.size(), 1);
+
+  {
+    Sqlite3Statement outer(cache, "SELECT t1 FROM test ORDER BY t1");
+    BOOST_CHECK_EQUAL(outer.step(), SQLITE_ROW);
+    BOOST_CHECK_EQUAL(outer.getInt(0), 0);
+
+    // the same statement while the cached one is in use
+    Sqlite3Statement inner(cache, "SELECT t1 FROM test ORDER BY t1");
+    BOOST_CHECK_EQUAL(inner.step(), SQLITE_ROW);
+    BOOST_CHECK_EQUAL(inner.getInt(0), 0);
+
+    BOOST_CHECK_EQUAL(outer.step(), SQLITE_ROW);
+    BOOST_CHECK_EQUAL(outer.getInt(0), 1);
+  }
+  BOOST_CHECK_EQUAL(cache.size(), 2);
+
+  // a returned statement is reset and starts from the first row
+  Sqlite3Statement stmt(cache, "SELECT t1 FROM test ORDER BY t1");
+  BOOST_CHECK_EQUAL(stmt.step(), SQLITE_ROW);
+  BOOST_CHECK_EQUAL(stmt.getInt(0), 0);
+  BOOST_CHECK_EQUAL(cache.size(), 2);
+
+  BOOST_CHECK_THROW(Sqlite3Statement(cache, "bad SQL"), std::domain_error);
+}
+
 BOOST_AUTO_TEST_SUITE_END() // TestSqlite3Statement
 BOOST_AUTO_TEST_SUITE_END() // Util
 
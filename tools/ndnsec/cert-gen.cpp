@@ -22,9 +22,217 @@
 #include "ndnsec.hpp"
 #include "util.hpp"
 
+#include <boost/filesystem.hpp>
+
+#include <map>
+#include <mutex>
+#include <thread>
+
 namespace ndn {
 namespace ndnsec {
 
+/**
+ * @brief Parameters of the certificates issued by one invocation of cert-gen
+ */
+struct IssueParams
+{
+  Name signId;
+  time::system_clock::TimePoint notBefore;
+  time::system_clock::TimePoint notAfter;
+  std::vector<security::v1::CertificateSubjectDescription> subjectDescription;
+  Name certPrefix;
+};
+
+/**
+ * @return unsigned certificate for the key in @p request, or nullptr if the key name in
+ *         @p request is not formatted correctly
+ */
+static shared_ptr<security::v1::IdentityCertificate>
+prepareCertificate(security::v1::KeyChain& keyChain,
+                   const security::v1::IdentityCertificate& request, const IssueParams& params)
+{
+  return keyChain.prepareUnsignedIdentityCertificate(request.getPublicKeyName(),
+                                                     request.getPublicKeyInfo(),
+                                                     params.signId,
+                                                     params.notBefore, params.notAfter,
+                                                     params.subjectDescription,
+                                                     params.certPrefix);
+}
+
+/**
+ * @brief Issue certificates for many signing requests on @p nThreads threads
+ *
+ * If @p requestPath is a directory, each regular file in it is a request, and the files are
+ * processed in the order of their names.  Otherwise, @p requestPath ("-" for stdin) contains
+ * one base64-encoded request per line.
+ *
+ * Each thread has its own KeyChain, so that signing is not serialized on a shared PIB and TPM
+ * handle.  The signing identity is created, if needed, only when the first certificate is
+ * ready to be signed.  One certificate is written per line of standard output, in the order of the
+ * requests, as soon as all preceding requests are done; an empty line is written for a
+ * request that cannot be processed.
+ *
+ * @return 0 if all requests have been processed, 1 otherwise
+ */
+static int
+issueBatch(const std::string& requestPath, size_t nThreads, const IssueParams& params)
+{
+  namespace fs = boost::filesystem;
+  namespace t = security::transform;
+
+  std::vector<std::string> requestFiles;
+  std::ifstream requestFileStream;
+  std::istream* requestLines = nullptr;
+
+  if (requestPath != "-" && fs::is_directory(requestPath)) {
+    for (fs::directory_iterator it(requestPath); it != fs::directory_iterator(); ++it) {
+      if (fs::is_regular_file(it->status()))
+        requestFiles.push_back(it->path().string());
+    }
+    std::sort(requestFiles.begin(), requestFiles.end());
+  }
+  else if (requestPath == "-") {
+    requestLines = &std::cin;
+  }
+  else {
+    requestFileStream.open(requestPath);
+    if (!requestFileStream) {
+      std::cerr << "ERROR: cannot open " << requestPath << std::endl;
+      return 1;
+    }
+    requestLines = &requestFileStream;
+  }
+
+  // KeyChains are created before starting the threads, so that errors reach the caller
+  std::vector<unique_ptr<security::v1::KeyChain>> keyChains;
+  for (size_t i = 0; i < nThreads; ++i) {
+    keyChains.push_back(make_unique<security::v1::KeyChain>());
+  }
+
+  std::mutex mutex; // protects everything below
+  size_t nRequests = 0;
+  size_t nextFile = 0;
+  std::map<size_t, std::string> pendingOutput;
+  size_t nextOutput = 0;
+  size_t nIssued = 0;
+  size_t nFailed = 0;
+
+  std::mutex signerMutex; // protects signingCertificateName
+  optional<Name> signingCertificateName;
+
+  // creates the signing identity on first use; returns its default certificate name
+  auto getSigningCertificateName = [&] (security::v1::KeyChain& keyChain) {
+    std::lock_guard<std::mutex> lock(signerMutex);
+    if (!signingCertificateName) {
+      keyChain.createIdentity(params.signId);
+      signingCertificateName = keyChain.getDefaultCertificateNameForIdentity(params.signId);
+    }
+    return *signingCertificateName;
+  };
+
+  // retrieves the next request file name or line; must be called with mutex locked
+  auto getNextRequest = [&] (size_t& index, std::string& request) {
+    if (requestLines == nullptr) {
+      if (nextFile >= requestFiles.size())
+        return false;
+      request = requestFiles[nextFile++];
+    }
+    else {
+      do {
+        if (!std::getline(*requestLines, request))
+          return false;
+      } while (request.empty());
+    }
+    index = nRequests++;
+    return true;
+  };
+
+  auto work = [&] (security::v1::KeyChain& keyChain) {
+    size_t index = 0;
+    std::string request;
+    while (true) {
+      {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (!getNextRequest(index, request))
+          return;
+      }
+
+      std::string output;
+      std::string error;
+      try {
+        shared_ptr<security::v1::IdentityCertificate> selfSignedCertificate;
+        if (requestLines == nullptr) {
+          selfSignedCertificate = io::load<security::v1::IdentityCertificate>(request);
+        }
+        else {
+          std::istringstream is(request);
+          selfSignedCertificate = io::load<security::v1::IdentityCertificate>(is);
+        }
+
+        if (selfSignedCertificate == nullptr) {
+          error = "input error";
+        }
+        else {
+          auto certificate = prepareCertificate(keyChain, *selfSignedCertificate, params);
+          if (certificate == nullptr) {
+            error = "key name is not formated correctly or does not match certificate name";
+          }
+          else {
+            keyChain.sign(*certificate,
+                          security::SigningInfo(security::SigningInfo::SIGNER_TYPE_CERT,
+                                                getSigningCertificateName(keyChain)));
+            Block wire = certificate->wireEncode();
+            std::ostringstream os;
+            t::bufferSource(wire.wire(), wire.size()) >> t::base64Encode(false) >> t::streamSink(os);
+            output = os.str();
+          }
+        }
+      }
+      catch (const std::exception& e) {
+        error = e.what();
+      }
+
+      std::lock_guard<std::mutex> lock(mutex);
+      if (error.empty()) {
+        ++nIssued;
+      }
+      else {
+        ++nFailed;
+        std::cerr << "ERROR: request " << index + 1 << ": " << error << std::endl;
+      }
+
+      pendingOutput.emplace(index, std::move(output));
+      bool hasOutput = false;
+      for (auto it = pendingOutput.begin();
+           it != pendingOutput.end() && it->first == nextOutput;
+           it = pendingOutput.erase(it), ++nextOutput) {
+        std::cout << it->second << '\n';
+        hasOutput = true;
+      }
+      if (hasOutput)
+        std::cout.flush();
+    }
+  };
+
+  time::steady_clock::TimePoint startTime = time::steady_clock::now();
+
+  std::vector<std::thread> threads;
+  for (size_t i = 1; i < nThreads; ++i) {
+    threads.emplace_back(work, std::ref(*keyChains[i]));
+  }
+  work(*keyChains[0]);
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  time::duration<double> elapsed = time::steady_clock::now() - startTime;
+  std::cerr << "Issued " << nIssued << " certificates (" << nFailed << " failed) in "
+            << elapsed.count() << " s, " << (nIssued / std::max(elapsed.count(), 1e-9))
+            << " certificates/s" << std::endl;
+
+  return nFailed == 0 ? 0 : 1;
+}
+
 int
 ndnsec_cert_gen(int argc, char** argv)
 {
@@ -43,11 +251,12 @@ ndnsec_cert_gen(int argc, char** argv)
   std::string subjectInfo;
   std::vector<std::string> signedInfo;
   Name certPrefix = security::v1::KeyChain::DEFAULT_PREFIX; // to avoid displaying the default value
+  size_t nThreads = std::max(std::thread::hardware_concurrency(), 1U);
 
   po::options_description description(
     "General Usage\n"
     "  ndnsec cert-gen [-h] [-S date] [-E date] [-N subject-name] [-I subject-info] "
-        "[-s sign-id] [-p cert-prefix] request\n"
+        "[-s sign-id] [-p cert-prefix] [-b [-j threads]] request\n"
     "General options");
 
   description.add_options()
@@ -72,6 +281,10 @@ ndnsec_cert_gen(int argc, char** argv)
                        "KEY component")
     ("request,r",      po::value<std::string>(&requestFile)->default_value("-"),
                        "request file name, - for stdin")
+    ("batch,b",        "batch mode: request is a file with one request per line, "
+                       "or a directory of request files; one certificate is written per line")
+    ("threads,j",      po::value<size_t>(&nThreads),
+                       "number of signing threads in batch mode (default: number of CPU cores)")
     ;
 
   po::positional_options_description p;
@@ -163,6 +376,11 @@ ndnsec_cert_gen(int argc, char** argv)
     }
   }
 
+  if (nThreads == 0) {
+    std::cerr << "ERROR: number of threads must be positive" << std::endl;
+    return 1;
+  }
+
   if (vm.count("request") == 0) {
     std::cerr << "ERROR: request file must be specified" << std::endl
               << std::endl
@@ -170,6 +388,17 @@ ndnsec_cert_gen(int argc, char** argv)
     return 1;
   }
 
+  IssueParams params;
+  params.signId = signId;
+  params.notBefore = notBefore;
+  params.notAfter = notAfter;
+  params.subjectDescription = subjectDescription;
+  params.certPrefix = certPrefix;
+
+  if (vm.count("batch") != 0) {
+    return issueBatch(requestFile, nThreads, params);
+  }
+
   shared_ptr<security::v1::IdentityCertificate> selfSignedCertificate = getIdentityCertificate(requestFile);
 
   if (selfSignedCertificate == nullptr) {
@@ -177,12 +406,8 @@ ndnsec_cert_gen(int argc, char** argv)
     return 1;
   }
 
-  Name keyName = selfSignedCertificate->getPublicKeyName();
-
   shared_ptr<security::v1::IdentityCertificate> certificate =
-    keyChain.prepareUnsignedIdentityCertificate(keyName, selfSignedCertificate->getPublicKeyInfo(),
-                                                signId, notBefore, notAfter, subjectDescription,
-                                                certPrefix);
+    prepareCertificate(keyChain, *selfSignedCertificate, params);
 
   if (certificate == nullptr) {
     std::cerr << "ERROR: key name is not formated correctly or does not match certificate name"
@@ -25,77 +25,44 @@
 namespace ndn {
 namespace ndnsec {
 
+// output is written with '\n' rather than std::endl, as flushing after every line dominates
+// the running time when there are many certificates
+
 void
-printCertificate(security::v1::KeyChain& keyChain,
-                 const ndn::Name& certName,
-                 bool isDefault,
-                 int verboseLevel)
+printCertificate(const ndn::Name& certName, bool isDefault,
+                 const security::v1::IdentityCertificate* certificate)
 {
   if (isDefault)
     std::cout << "       +->* ";
   else
     std::cout << "       +->  ";
 
-  std::cout << certName << std::endl;
+  std::cout << certName << '\n';
 
-  if (verboseLevel >= 3) {
-    shared_ptr<security::v1::IdentityCertificate> certificate = keyChain.getCertificate(certName);
-    if (certificate != nullptr)
-      certificate->printCertificate(std::cout, "            ");
-  }
+  if (certificate != nullptr)
+    certificate->printCertificate(std::cout, "            ");
 }
 
 void
-printKey(security::v1::KeyChain& keyChain, const ndn::Name& keyName, bool isDefault, int verboseLevel)
+printKey(const ndn::Name& keyName, bool isDefault)
 {
   if (isDefault)
     std::cout << "  +->* ";
   else
     std::cout << "  +->  ";
 
-  std::cout << keyName << std::endl;
-
-  if (verboseLevel >= 2) {
-    std::vector<ndn::Name> defaultCertificates;
-    keyChain.getAllCertificateNamesOfKey(keyName, defaultCertificates, true);
-
-    for (const auto& certName : defaultCertificates)
-      printCertificate(keyChain, certName, true, verboseLevel);
-
-    std::vector<ndn::Name> otherCertificates;
-    keyChain.getAllCertificateNamesOfKey(keyName, otherCertificates, false);
-    for (const auto& certName : otherCertificates)
-      printCertificate(keyChain, certName, false, verboseLevel);
-  }
+  std::cout << keyName << '\n';
 }
 
 void
-printIdentity(security::v1::KeyChain& keyChain,
-              const ndn::Name& identity,
-              bool isDefault,
-              int verboseLevel)
+printIdentity(const ndn::Name& identity, bool isDefault)
 {
   if (isDefault)
     std::cout << "* ";
   else
     std::cout << "  ";
 
-  std::cout << identity << std::endl;
-
-  if (verboseLevel >= 1) {
-    std::vector<ndn::Name> defaultKeys;
-    keyChain.getAllKeyNamesOfIdentity(identity, defaultKeys, true);
-    for (const auto& keyName : defaultKeys)
-      printKey(keyChain, keyName, true, verboseLevel);
-
-    std::vector<ndn::Name> otherKeys;
-    keyChain.getAllKeyNamesOfIdentity(identity, otherKeys, false);
-    for (const auto& keyName : otherKeys) {
-      printKey(keyChain, keyName, false, verboseLevel);
-    }
-
-    std::cout << std::endl;
-  }
+  std::cout << identity << '\n';
 }
 
 int
@@ -109,13 +76,17 @@ ndnsec_list(int argc, char** argv)
                         // 2 print cert name
                         // 3 print cert content
 
-  po::options_description options("General Usage\n  ndnsec list [-h] [-k|c]\nGeneral options");
+  Name prefix;
+
+  po::options_description options("General Usage\n  ndnsec list [-h] [-k|c] [-p prefix]\nGeneral options");
   options.add_options()
     ("help,h",    "produce help message")
     ("key,k",     "granularity: key")
     ("cert,c",    "granularity: certificate")
     ("verbose,v", accumulator<int>(&verboseLevel),
                   "verbose mode: -v is equivalent to -k, -vv is equivalent to -c")
+    ("prefix,p",  po::value<Name>(&prefix),
+                  "list only the identities under this name prefix")
     ;
 
   po::options_description oldOptions;
@@ -151,19 +122,47 @@ ndnsec_list(int argc, char** argv)
 
   verboseLevel = std::max(verboseLevel, tmpVerboseLevel);
 
+  typedef security::v1::SecPublicInfo SecPublicInfo;
+  SecPublicInfo::ListDepth depth = SecPublicInfo::LIST_IDENTITIES;
+  if (verboseLevel >= 3)
+    depth = SecPublicInfo::LIST_CERTIFICATES;
+  else if (verboseLevel == 2)
+    depth = SecPublicInfo::LIST_CERTIFICATE_NAMES;
+  else if (verboseLevel == 1)
+    depth = SecPublicInfo::LIST_KEYS;
+
   security::v1::KeyChain keyChain;
 
-  std::vector<Name> defaultIdentities;
-  keyChain.getAllIdentities(defaultIdentities, true);
-  for (const auto& identity : defaultIdentities) {
-    printIdentity(keyChain, identity, true, verboseLevel);
-  }
+  // entries arrive grouped by identity and then by key,
+  // so a header is printed whenever the identity or the key changes
+  bool hasIdentity = false;
+  Name lastIdentity;
+  Name lastKey;
+  keyChain.getPib().listEntries(prefix, depth, [&] (const SecPublicInfo::ListEntry& entry) {
+    if (!hasIdentity || entry.identity != lastIdentity) {
+      if (hasIdentity && verboseLevel >= 1)
+        std::cout << '\n';
+      printIdentity(entry.identity, entry.isDefaultIdentity);
+      hasIdentity = true;
+      lastIdentity = entry.identity;
+      lastKey.clear();
+    }
 
-  std::vector<Name> otherIdentities;
-  keyChain.getAllIdentities(otherIdentities, false);
-  for (const auto& identity : otherIdentities) {
-    printIdentity(keyChain, identity, false, verboseLevel);
-  }
+    if (entry.keyName.empty())
+      return;
+    if (entry.keyName != lastKey) {
+      printKey(entry.keyName, entry.isDefaultKey);
+      lastKey = entry.keyName;
+    }
+
+    if (entry.certName.empty())
+      return;
+    printCertificate(entry.certName, entry.isDefaultCertificate, entry.certificate.get());
+  });
+
+  if (hasIdentity && verboseLevel >= 1)
+    std::cout << '\n';
+  std::cout.flush();
 
   return 0;
 }